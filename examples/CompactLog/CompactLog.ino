@@ -0,0 +1,109 @@
+/*!
+@file CompactLog.ino
+
+@section CompactLog_intro_section Description
+
+Example program for the BME280_Encoder class of the BME280 library. The most recent version of the
+library is available at https://github.com/Zanduino/BME280 and the documentation of the library as
+well as example programs are described in the project's wiki pages located at
+https://github.com/Zanduino/BME280/wiki. \n\n
+
+The program packs readings into packets of 32 bytes as they would be sent over a low-bandwidth
+radio link or appended to a log file. Each reading takes about 4 bytes instead of the 12 bytes of
+three int32_t values. The first packet starts with a header holding the settings and calibration
+values and every packet starts with a keyframe, so a packet can be decoded with BME280_Decoder even
+when the previous one was lost. Full packets are shown as hexadecimal bytes.
+
+@section CompactLoglicense GNU General Public License v3.0
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+General Public License as published by the Free Software Foundation, either version 3 of the
+License, or (at your option) any later version. This program is distributed in the hope that it will
+be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details. You should have
+received a copy of the GNU General Public License along with this program.  If not, see
+<http://www.gnu.org/licenses/>.
+
+@section CompactLogauthor Author
+
+Written by Arnd <Arnd@Zanduino.Com> at https://www.github.com/SV-Zanshin
+
+@section CompactLogversions Changelog
+
+Version | Date       | Developer  | Comments
+------- | ---------- | ---------- | ---------------------------------------------
+1.0.0   | 2026-10-18 | SV-Zanshin | Initial coding
+1.0.1   | 2026-10-18 | SV-Zanshin | Readings take about 4 bytes with the codec format version 2
+
+*/
+#include <BME280.h>        // Include the BME280 Sensor library
+#include <BME280_Codec.h>  // Include the sample format
+/***************************************************************************************************
+** Declare all program constants                                                                  **
+***************************************************************************************************/
+const uint32_t SERIAL_SPEED{115200};  ///< Default baud rate for Serial I/O
+const uint8_t  PACKET_SIZE{32};       ///< Bytes per packet, e.g. the payload of an nRF24L01
+
+/***************************************************************************************************
+** Declare global variables and instantiate classes                                               **
+***************************************************************************************************/
+BME280_Class   BME280;                              ///< Create an instance of the BME280 class
+BME280_Encoder encoder;                             ///< Packs the readings
+uint8_t        header[BME280_CODEC_HEADER_LENGTH];  ///< Header sent before the first packet
+uint8_t        packet[PACKET_SIZE];                 ///< Packet being filled
+
+void send(const uint8_t *data, const uint8_t length) {
+  /*!
+   * @brief     Shows a packet, a real program would transmit or store it here
+   * @param[in] data Packet contents
+   * @param[in] length Number of bytes
+   */
+  for (uint8_t i = 0; i < length; i++) {
+    if (data[i] < 0x10) Serial.print('0');
+    Serial.print(data[i], HEX);
+  }  // of for-next each byte
+  Serial.println();
+}  // of method send()
+
+void setup() {
+  /*!
+   * @brief    Arduino method called once at startup to initialize the system
+   * @details  This is an Arduino IDE method which is called first upon boot or restart. It is only
+   * called one time and then control goes to the main "loop()" method, from which control never
+   * returns
+   * @return   void
+   */
+  Serial.begin(SERIAL_SPEED);
+#ifdef __AVR_ATmega32U4__  // If this is a 32U4 processor, then wait 3 seconds to initialize USB
+  delay(3000);
+#endif
+  Serial.println(F("Starting CompactLog example program for BME280"));
+  while (!BME280.begin(I2C_STANDARD_MODE))  // Start BME280 using I2C protocol
+  {
+    Serial.println(F("-  Unable to find BME280. Waiting 3 seconds."));
+    delay(3000);
+  }  // of loop until device is located
+  BME280.apply(BME280_INDOOR_NAVIGATION);
+  encoder.begin(header, sizeof(header));
+  encoder.header(BME280.getConfig(), BME280.calibration());
+  send(header, encoder.length());
+  encoder.begin(packet, sizeof(packet));
+}  // of method setup()
+
+void loop() {
+  /*!
+   * @brief    Arduino method for the main program loop
+   * @details  This is the main program for the Arduino IDE, it is an infinite loop and keeps on
+   * repeating. A reading which doesn't fit into the packet is added to the next one
+   * @return   void
+   */
+  BME280_Reading reading;
+  if (!BME280.getSensorData(reading.temperature, reading.humidity, reading.pressure)) return;
+  if (!encoder.add(reading)) {
+    send(packet, encoder.length());
+    encoder.begin(packet, sizeof(packet));
+    encoder.keyframe();  // Each packet can be decoded on its own
+    encoder.add(reading);
+  }  // of if-then packet is full
+  delay(100);
+}  // of method loop()
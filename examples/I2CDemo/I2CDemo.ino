@@ -28,9 +28,9 @@ and PCB temperature and self-heating of the element.\n\n
 The pressure reading needs to be adjusted for altitude to get the adjusted pressure reading. There
 are numerous sources on the internet for formula converting from standard sea-level pressure to
 altitude, see the data sheet for the BME180 on page 16 of
-http://www.adafruit.com/datasheets/BST-BMP180-DS000-09.pdf. Rather than put a floating-point
-function in the library which may not be used but which would use space, an example altitude
-computation function has been added to this example program to show how it might be done.
+http://www.adafruit.com/datasheets/BST-BMP180-DS000-09.pdf. The example altitude function uses the
+integer-only BME280_Metrics::altitude() from the library, which avoids the floating point pow()
+function.
 
 @section I2CDemolicense GNU General Public License v3.0
 
@@ -50,6 +50,7 @@ Written by Arnd <Arnd@Zanduino.Com> at https://www.github.com/SV-Zanshin
 
 Version | Date       | Developer  | Comments
 ------- | ---------- | ---------- | ---------------------------------------------
+1.0.5   | 2026-10-18 | SV-Zanshin | Use BME280_Metrics::altitude() instead of pow()
 1.0.4   | 2020-12-07 | SV-Zanshin | clang-format the source code
 1.0.3   | 2019-01-31 | SV-Zanshin | Issue #7 - convert documentation to Doxygen
 1.0.1   | 2017-08-04 | SV-Zanshin | Made output cleaner and toggled humidity readings
@@ -57,7 +58,8 @@ Version | Date       | Developer  | Comments
 1.0.0b  | 2017-07-30 | SV-Zanshin | Initial coding
 
 */
-#include <BME280.h>  // Include the BME280 Sensor library
+#include <BME280.h>          // Include the BME280 Sensor library
+#include <BME280_Metrics.h>  // Include the derived values
 /***************************************************************************************************
 ** Declare all program constants                                                                  **
 ***************************************************************************************************/
@@ -77,12 +79,10 @@ float altitude(const float seaLevel = 1013.25) {
    * @param[in] seaLevel Sea-Level pressure in millibars
    * @return    floating point altitude in meters.
    */
-  static float Altitude;
-  int32_t      temp, hum, press;
+  int32_t temp, hum, press;
   BME280.getSensorData(temp, hum, press);  // Get the most recent values from the device
-  Altitude = 44330.0 * (1.0 - pow(((float)press / 100.0) / seaLevel,
-                                  0.1903));  // Convert into altitude in meters
-  return (Altitude);
+  return (BME280_Metrics::altitude(press, (int32_t)(seaLevel * 100.0)) /
+          100.0);  // Convert centimeters into meters
 }  // of method altitude()
 
 void setup() {
@@ -0,0 +1,215 @@
+/*!
+@file SoftSPIBenchmark.ino
+
+@section SoftSPIBenchmark_intro_section Description
+
+Example program measuring the software SPI transfers of the BME280 library. The most recent version
+of the library is available at https://github.com/Zanduino/BME280 and the documentation of the
+library as well as example programs are described in the project's wiki pages located at
+https://github.com/Zanduino/BME280/wiki. \n\n
+
+The program reads the 8 measurement registers with the library's BME280_SoftwareSPIBus, which sets
+the pins through the port registers on AVR processors, and with a bus class written the same way
+but using digitalWrite() and digitalRead(). On AVR processors Timer1 counts the CPU cycles of each
+read, other processors show microseconds and both buses take about the same time as the library
+only uses the port registers on AVR. The BME280 is connected to the same pins as in the
+SoftSPIDemo example.
+
+@section SoftSPIBenchmarklicense GNU General Public License v3.0
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+General Public License as published by the Free Software Foundation, either version 3 of the
+License, or (at your option) any later version. This program is distributed in the hope that it will
+be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details. You should have
+received a copy of the GNU General Public License along with this program.  If not, see
+<http://www.gnu.org/licenses/>.
+
+@section SoftSPIBenchmarkauthor Author
+
+Written by Arnd <Arnd@Zanduino.Com> at https://www.github.com/SV-Zanshin
+
+@section SoftSPIBenchmarkversions Changelog
+
+Version | Date       | Developer  | Comments
+------- | ---------- | ---------- | ---------------------------------------------
+1.0.0   | 2026-10-18 | SV-Zanshin | Initial coding
+1.0.1   | 2026-10-18 | SV-Zanshin | Bus class takes the time functions from BME280_ArduinoClock
+
+*/
+#include <BME280.h>  // Include the BME280 Sensor library
+/***************************************************************************************************
+** Declare all program constants                                                                  **
+***************************************************************************************************/
+const uint32_t SERIAL_SPEED{115200};  ///< Default baud rate for Serial I/O
+const uint8_t  SPI_CS_PIN{10};        ///< Pin for slave-select of BME280
+const uint8_t  SPI_SCK_PIN{13};       ///< Pin for clock signal
+const uint8_t  SPI_MOSI_PIN{11};      ///< Master-out, Slave-in Pin
+const uint8_t  SPI_MISO_PIN{12};      ///< Master-in, Slave-out Pin
+const uint8_t  REPEATS{16};           ///< Reads averaged for each result
+
+/***************************************************************************************************
+** Declare the comparison bus, the library's software SPI transfer using the Arduino pin functions**
+***************************************************************************************************/
+class DigitalSPIBus : public BME280_ArduinoClock {
+  /*!
+    @class   DigitalSPIBus
+    @brief   Software SPI bus policy using digitalWrite() and digitalRead() for every clock edge
+  */
+ public:
+  bool begin(const uint8_t chipSelect, const uint8_t mosi, const uint8_t miso, const uint8_t sck) {
+    /*!
+     * @brief     Start software SPI communications
+     * @param[in] chipSelect Chip select pin
+     * @param[in] mosi Master-Out Slave-In pin
+     * @param[in] miso Master-In Slave-Out pin
+     * @param[in] sck  System Clock
+     * @return    Always returns "true"
+     */
+    _cs   = chipSelect;
+    _mosi = mosi;
+    _miso = miso;
+    _sck  = sck;
+    digitalWrite(_cs, HIGH);
+    pinMode(_cs, OUTPUT);
+    pinMode(_sck, OUTPUT);
+    pinMode(_mosi, OUTPUT);
+    pinMode(_miso, INPUT);
+    return true;
+  }  // of method begin()
+  uint8_t address() const {
+    /*!
+     * @brief     returns the bus address of the device
+     * @return    Always 0
+     */
+    return (0);
+  }  // of method address()
+  uint8_t read(const uint8_t addr, uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     Read "length" bytes starting at register "addr"
+     * @param[in] addr Register address
+     * @param[out] buffer Storage for the bytes read
+     * @param[in] length Number of bytes to read
+     * @return    Number of bytes read
+     */
+    digitalWrite(_cs, LOW);
+    transfer(addr | 0x80);
+    for (uint8_t i = 0; i < length; i++) buffer[i] = transfer(0);
+    digitalWrite(_cs, HIGH);
+    return (length);
+  }  // of method read()
+  uint8_t write(const uint8_t addr, const uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     Write "length" bytes starting at register "addr"
+     * @param[in] addr Register address
+     * @param[in] buffer Bytes to write
+     * @param[in] length Number of bytes to write
+     * @return    Number of bytes written
+     */
+    digitalWrite(_cs, LOW);
+    for (uint8_t i = 0; i < length; i++) {
+      transfer((addr + i) & ~0x80);
+      transfer(buffer[i]);
+    }  // of for-next each byte to be written
+    digitalWrite(_cs, HIGH);
+    return (length);
+  }  // of method write()
+
+ private:
+  uint8_t transfer(uint8_t data) {
+    /*!
+     * @brief     sends and receives one byte in SPI mode 0
+     * @param[in] data Byte to send
+     * @return    Byte received
+     */
+    uint8_t reply = 0;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      reply <<= 1;
+      digitalWrite(_sck, LOW);
+      digitalWrite(_mosi, data & 0x80);
+      digitalWrite(_sck, HIGH);
+      if (digitalRead(_miso)) reply |= 1;
+      data <<= 1;
+    }  // of for-next each bit
+    return (reply);
+  }  // of method transfer()
+  uint8_t _cs = 0, _sck = 0, _mosi = 0, _miso = 0;  ///< Software SPI pins
+};                                                  // of class DigitalSPIBus
+
+/***************************************************************************************************
+** Declare global variables and instantiate classes                                               **
+***************************************************************************************************/
+BME280_Device<BME280_SoftwareSPIBus> fastSensor;     ///< Library bus
+BME280_Device<DigitalSPIBus>         digitalSensor;  ///< Comparison bus
+
+template <class Device>
+uint32_t measure(Device &sensor) {
+  /*!
+   * @brief     returns the average time of an 8 byte read of the measurement registers
+   * @param[in] sensor Started device
+   * @return    CPU cycles on AVR processors, otherwise microseconds
+   */
+  uint8_t  registers[8];
+  uint32_t total = 0;
+  for (uint8_t i = 0; i < REPEATS; i++) {
+#if defined(__AVR__) && defined(TCCR1B)
+    uint8_t sreg = SREG;  // Timer1 counts every CPU cycle, interrupts would be counted too
+    cli();
+    TCNT1 = 0;
+    sensor.readRegisters(BME280_PRESSUREDATA_REG, registers, sizeof(registers));
+    uint16_t cycles = TCNT1;
+    SREG            = sreg;
+    total += cycles;
+#else
+    uint32_t start = micros();
+    sensor.readRegisters(BME280_PRESSUREDATA_REG, registers, sizeof(registers));
+    total += micros() - start;
+#endif
+  }  // of for-next each repeat
+  return (total / REPEATS);
+}  // of function measure()
+
+void setup() {
+  /*!
+   * @brief    Arduino method called once at startup to initialize the system
+   * @details  This is an Arduino IDE method which is called first upon boot or restart. It is only
+   * called one time and then control goes to the main "loop()" method, from which control never
+   * returns
+   * @return   void
+   */
+  Serial.begin(SERIAL_SPEED);
+#ifdef __AVR_ATmega32U4__  // If this is a 32U4 processor, then wait 3 seconds to initialize USB/
+  delay(3000);
+#endif
+  Serial.println(F("Starting SoftSPIBenchmark example program for BME280"));
+  while (!fastSensor.begin(SPI_CS_PIN, SPI_MOSI_PIN, SPI_MISO_PIN, SPI_SCK_PIN)) {
+    Serial.println(F("-  Unable to find BME280. Waiting 3 seconds."));
+    delay(3000);
+  }  // of loop until device is located
+  digitalSensor.begin(SPI_CS_PIN, SPI_MOSI_PIN, SPI_MISO_PIN, SPI_SCK_PIN);
+#if defined(__AVR__) && defined(TCCR1B)
+  TCCR1A = 0;          // Normal counting mode
+  TCCR1B = _BV(CS10);  // Count CPU cycles, no prescaler
+  Serial.println(F("- CPU cycles for an 8 byte register read"));
+#else
+  Serial.println(F("- Microseconds for an 8 byte register read"));
+#endif
+}  // of method setup()
+
+void loop() {
+  /*!
+   * @brief    Arduino method for the main program loop
+   * @details  Both buses are measured every 5 seconds
+   * @return   void
+   */
+  uint32_t fast    = measure(fastSensor);
+  uint32_t digital = measure(digitalSensor);
+  Serial.print(F("BME280_SoftwareSPIBus: "));
+  Serial.print(fast);
+  Serial.print(F(", digitalWrite(): "));
+  Serial.print(digital);
+  Serial.print(F(", "));
+  Serial.print((float)digital / fast, 1);
+  Serial.println(F(" times faster"));
+  delay(5000);
+}  // of method loop()
@@ -0,0 +1,92 @@
+/*!
+@file TraceDump.ino
+
+@section TraceDump_intro_section Description
+
+Example program for recording the bus traffic with the BME280_TraceBus class of the BME280
+library. The most recent version of the library is available at https://github.com/Zanduino/BME280
+and the documentation of the library as well as example programs are described in the project's
+wiki pages located at https://github.com/Zanduino/BME280/wiki. \n\n
+
+The program reads the sensor every 2 seconds while the most recent register transfers are kept in
+a 512 byte buffer. The transfers of begin() are dumped first, the most recent ones whenever a
+reading fails or a "d" is sent over the serial port. Each line of a dump is one transfer in
+hexadecimal. Saving the first dump to a file and converting it with "xxd -r -p" gives a trace which
+BME280_ReplayBus of BME280_Replay.h plays back on a computer, as a replay has to start with the
+transfers of begin(). The later dumps show what happened just before a problem.
+
+@section TraceDumplicense GNU General Public License v3.0
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+General Public License as published by the Free Software Foundation, either version 3 of the
+License, or (at your option) any later version. This program is distributed in the hope that it will
+be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details. You should have
+received a copy of the GNU General Public License along with this program.  If not, see
+<http://www.gnu.org/licenses/>.
+
+@section TraceDumpauthor Author
+
+Written by Arnd <Arnd@Zanduino.Com> at https://www.github.com/SV-Zanshin
+
+@section TraceDumpversions Changelog
+
+Version | Date       | Developer  | Comments
+------- | ---------- | ---------- | ---------------------------------------------
+1.0.0   | 2026-10-18 | SV-Zanshin | Initial coding
+1.0.1   | 2026-10-18 | SV-Zanshin | The replay bus has moved to BME280_Replay.h
+
+*/
+#include <BME280.h>        // Include the BME280 Sensor library
+#include <BME280_Trace.h>  // Include the bus trace recorder
+/***************************************************************************************************
+** Declare all program constants                                                                  **
+***************************************************************************************************/
+const uint32_t SERIAL_SPEED{115200};  ///< Default baud rate for Serial I/O
+const uint8_t  I2C_ADDRESS{0x76};     ///< I2C address of the BME280, 0x76 or 0x77
+
+/***************************************************************************************************
+** Declare global variables and instantiate classes                                               **
+***************************************************************************************************/
+BME280_Device<BME280_TraceBus<BME280_I2CBus, 512>> BME280;  ///< BME280 with recorded I2C traffic
+
+void setup() {
+  /*!
+   * @brief    Arduino method called once at startup to initialize the system
+   * @details  This is an Arduino IDE method which is called first upon boot or restart. It is only
+   * called one time and then control goes to the main "loop()" method, from which control never
+   * returns
+   * @return   void
+   */
+  Serial.begin(SERIAL_SPEED);
+#ifdef __AVR_ATmega32U4__  // If this is a 32U4 processor, then wait 3 seconds to initialize USB
+  delay(3000);
+#endif
+  Serial.println(F("Starting TraceDump example program for BME280"));
+  while (!BME280.begin(I2C_STANDARD_MODE, I2C_ADDRESS))  // Start BME280 using I2C protocol
+  {
+    Serial.println(F("-  Unable to find BME280. Waiting 3 seconds."));
+    delay(3000);
+    BME280.bus().clearTrace();  // Keep only the last attempt
+  }  // of loop until device is located
+  BME280.apply(BME280_WEATHER_MONITORING);
+  BME280.bus().dump(Serial);  // Start of the trace for a replay
+}  // of method setup()
+
+void loop() {
+  /*!
+   * @brief    Arduino method for the main program loop
+   * @details  This is the main program for the Arduino IDE, it is an infinite loop and keeps on
+   * repeating.
+   * @return   void
+   */
+  int32_t temperature, humidity, pressure;
+  bool    ok = BME280.getSensorData(temperature, humidity, pressure);
+  if (!ok || (Serial.available() && Serial.read() == 'd')) {
+    Serial.print(F("- Trace, "));
+    Serial.print(BME280.bus().dropped());
+    Serial.println(F(" older transfers dropped"));
+    BME280.bus().dump(Serial);
+  }  // of if-then dump requested
+  delay(2000);
+}  // of method loop()
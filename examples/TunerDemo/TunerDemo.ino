@@ -0,0 +1,125 @@
+/*!
+@file TunerDemo.ino
+
+@section TunerDemo_intro_section Description
+
+Example program for the BME280_Tuner class of the BME280 library. The most recent version of the
+library is available at https://github.com/Zanduino/BME280 and the documentation of the library as
+well as example programs are described in the project's wiki pages located at
+https://github.com/Zanduino/BME280/wiki. \n\n
+
+The program first lists the settings which BME280_Tuner chooses for a number of typical targets
+together with the sample rate and the estimated average current of each. This part doesn't use the
+sensor. It then tunes a BME280 on the I2C bus for pressure readings 10 times a second with a noise
+of 1 Pascal and streams the readings, feeding each one back to the tuner. When the readings are
+noisier than the datasheet figures, e.g. when the sensor is in a draught, the tuner chooses more
+oversampling or filtering and the new settings are applied.
+
+@section TunerDemolicense GNU General Public License v3.0
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+General Public License as published by the Free Software Foundation, either version 3 of the
+License, or (at your option) any later version. This program is distributed in the hope that it will
+be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details. You should have
+received a copy of the GNU General Public License along with this program.  If not, see
+<http://www.gnu.org/licenses/>.
+
+@section TunerDemoauthor Author
+
+Written by Arnd <Arnd@Zanduino.Com> at https://www.github.com/SV-Zanshin
+
+@section TunerDemoversions Changelog
+
+Version | Date       | Developer  | Comments
+------- | ---------- | ---------- | ---------------------------------------------
+1.0.0   | 2026-10-18 | SV-Zanshin | Initial coding
+
+*/
+#include <BME280.h>        // Include the BME280 Sensor library
+#include <BME280_Tuner.h>  // Include the settings selection
+/***************************************************************************************************
+** Declare all program constants                                                                  **
+***************************************************************************************************/
+const uint32_t SERIAL_SPEED{115200};  ///< Default baud rate for Serial I/O
+/*! Example targets: period, noise of temperature / humidity / pressure, current, response time */
+const BME280_Targets EXAMPLES[] = {
+    {60000000, {50, 200, 330}, 0, 0},  // Weather station, once a minute
+    {1000000, {50, 200, 0}, 0, 0},     // Humidity sensing, once a second
+    {25000, {50, 0, 20}, 0, 250000},   // Indoor navigation, 40Hz
+    {10000, {0, 0, 100}, 0, 0},        // Gaming, 100Hz
+    {1000000, {0, 0, 50}, 5000, 0}};   // Fine pressure on a 5uA budget
+const BME280_Targets STREAMING = {100000, {50, 0, 100}, 0, 2000000};  ///< Targets for loop()
+
+/***************************************************************************************************
+** Declare global variables and instantiate classes                                               **
+***************************************************************************************************/
+BME280_Class BME280;  ///< Create an instance of the BME280 class
+BME280_Tuner tuner;   ///< Chooses the settings
+
+void showSettings(const bool met) {
+  /*!
+   * @brief    Displays the settings chosen by the tuner
+   * @param[in] met Whether all targets were met
+   */
+  const BME280_Config &config = tuner.config();
+  Serial.print(F("T/H/P oversampling "));
+  Serial.print(config.temperatureSampling);
+  Serial.print('/');
+  Serial.print(config.humiditySampling);
+  Serial.print('/');
+  Serial.print(config.pressureSampling);
+  Serial.print(F(" IIR "));
+  Serial.print(config.iirFilter);
+  Serial.print(F(" inactive "));
+  Serial.print(config.inactiveTime);
+  Serial.print(F(" mode "));
+  Serial.print(config.mode);
+  Serial.print(F(": "));
+  Serial.print(1000000.0 / tuner.period());
+  Serial.print(F("Hz "));
+  Serial.print(tuner.current() / 1000.0);
+  Serial.print(F("uA, pressure noise "));
+  Serial.print(tuner.noise(PressureSensor) / 100.0);
+  Serial.println(met ? F("Pa") : F("Pa, targets not met"));
+}  // of method showSettings()
+
+void setup() {
+  /*!
+   * @brief    Arduino method called once at startup to initialize the system
+   * @details  This is an Arduino IDE method which is called first upon boot or restart. It is only
+   * called one time and then control goes to the main "loop()" method, from which control never
+   * returns
+   * @return   void
+   */
+  Serial.begin(SERIAL_SPEED);
+#ifdef __AVR_ATmega32U4__  // If this is a 32U4 processor, then wait 3 seconds to initialize USB
+  delay(3000);
+#endif
+  Serial.println(F("Starting TunerDemo example program for BME280"));
+  for (uint8_t i = 0; i < sizeof(EXAMPLES) / sizeof(EXAMPLES[0]); i++)
+    showSettings(tuner.tune(EXAMPLES[i]));
+  while (!BME280.begin(I2C_STANDARD_MODE))  // Start BME280 using I2C protocol
+  {
+    Serial.println(F("-  Unable to find BME280. Waiting 3 seconds."));
+    delay(3000);
+  }  // of loop until device is located
+  showSettings(tuner.tune(STREAMING));
+  BME280.apply(tuner.config());
+  BME280.startStreaming();
+}  // of method setup()
+
+void loop() {
+  /*!
+   * @brief    Arduino method for the main program loop
+   * @details  This is the main program for the Arduino IDE, it is an infinite loop and keeps on
+   * repeating.
+   * @return   void
+   */
+  BME280_Reading reading;
+  if (BME280.stream(reading) && tuner.update(reading)) {  // New settings for the noise seen
+    showSettings(true);
+    BME280.apply(tuner.config());
+    BME280.startStreaming();  // The sample period has changed
+  }                           // of if-then new settings
+}  // of method loop()
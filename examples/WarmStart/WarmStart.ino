@@ -0,0 +1,128 @@
+/*!
+@file WarmStart.ino
+
+@section WarmStart_intro_section Description
+
+Example program for using the warm start of the BME280 library. The most recent version of the
+library is available at https://github.com/Zanduino/BME280 and the documentation of the library as
+well as example programs are described in the project's wiki pages located at
+https://github.com/Zanduino/BME280/wiki. \n\n
+
+A battery powered node typically wakes up, takes a single forced measurement and goes back to
+sleep. Searching the I2C bus for the BME280 and reading its calibration values then takes a large
+share of the time awake. This program keeps the I2C address and the calibration values in EEPROM,
+so from the second start on begin() only reads the chip id. The EEPROM cells are only written when
+the stored data is missing or no longer matches the device. The time taken by begin() is shown
+after each start, press reset a few times to see the difference. The I2C speed and address are
+passed to begin() after the storage function, an address of 0 uses the stored address or searches
+the bus.
+
+@section WarmStartlicense GNU General Public License v3.0
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+General Public License as published by the Free Software Foundation, either version 3 of the
+License, or (at your option) any later version. This program is distributed in the hope that it will
+be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details. You should have
+received a copy of the GNU General Public License along with this program.  If not, see
+<http://www.gnu.org/licenses/>.
+
+@section WarmStartauthor Author
+
+Written by Arnd <Arnd@Zanduino.Com> at https://www.github.com/SV-Zanshin
+
+@section WarmStartversions Changelog
+
+Version | Date       | Developer  | Comments
+------- | ---------- | ---------- | ---------------------------------------------
+1.0.1   | 2026-10-18 | SV-Zanshin | Pass the I2C speed and address to begin()
+1.0.0   | 2026-10-18 | SV-Zanshin | Initial coding
+
+*/
+#include <BME280.h>  // Include the BME280 Sensor library
+#include <EEPROM.h>  // Include the EEPROM library
+/***************************************************************************************************
+** Declare all program constants                                                                  **
+***************************************************************************************************/
+const uint32_t SERIAL_SPEED{115200};      ///< Default baud rate for Serial I/O
+const int      EEPROM_ADDRESS{0};         ///< First EEPROM cell used for the warm start data
+const uint32_t I2C_SPEED{I2C_FAST_MODE};  ///< I2C speed
+const uint8_t  BME280_ADDRESS{0};         ///< I2C address, e.g. 0x76 or 0x77. 0 searches the bus
+
+/***************************************************************************************************
+** Declare global variables and instantiate classes                                               **
+***************************************************************************************************/
+BME280_Class BME280;  ///< Create an instance of the BME280 class
+
+bool storage(uint8_t *data, const uint8_t length, const bool save) {
+  /*!
+   * @brief     Loads or saves the warm start data in EEPROM
+   * @details   Only cells which change are written to save EEPROM write cycles. The contents are
+   * checked by begin(), so a load always succeeds
+   * @param[in,out] data Warm start data
+   * @param[in] length Number of bytes
+   * @param[in] save "true" to save, "false" to load
+   * @return    Always returns "true"
+   */
+#if defined(ESP8266) || defined(ESP32)
+  EEPROM.begin(EEPROM_ADDRESS + length);  // The EEPROM is emulated in flash
+#endif
+  for (uint8_t i = 0; i < length; i++) {
+    if (!save)
+      data[i] = EEPROM.read(EEPROM_ADDRESS + i);
+    else if (EEPROM.read(EEPROM_ADDRESS + i) != data[i])
+      EEPROM.write(EEPROM_ADDRESS + i, data[i]);
+  }  // of for-next each byte
+#if defined(ESP8266) || defined(ESP32)
+  EEPROM.commit();  // Write the flash page if anything changed
+#endif
+  return true;
+}  // of method storage()
+
+void setup() {
+  /*!
+   * @brief    Arduino method called once at startup to initialize the system
+   * @details  This is an Arduino IDE method which is called first upon boot or restart. It is only
+   * called one time and then control goes to the main "loop()" method, from which control never
+   * returns
+   * @return   void
+   */
+  Serial.begin(SERIAL_SPEED);
+#ifdef __AVR_ATmega32U4__  // If this is a 32U4 processor, then wait 3 seconds to initialize USB
+  delay(3000);
+#endif
+  Serial.println(F("Starting WarmStart example program for BME280"));
+  uint32_t startMicros = micros();                           // Time the start
+  while (!BME280.begin(storage, I2C_SPEED, BME280_ADDRESS))  // Start BME280 using I2C protocol
+  {
+    Serial.println(F("-  Unable to find BME280. Waiting 3 seconds."));
+    delay(3000);
+    startMicros = micros();
+  }  // of loop until device is located
+  Serial.print(F("- begin() took "));
+  Serial.print(micros() - startMicros);
+  Serial.println(F(" microseconds"));
+  BME280.apply(BME280_WEATHER_MONITORING);  // One forced measurement per wake-up
+}  // of method setup()
+
+void loop() {
+  /*!
+   * @brief    Arduino method for the main program loop
+   * @details  This is the main program for the Arduino IDE, it is an infinite loop and keeps on
+   * repeating. A battery powered node would go to deep sleep after the measurement instead
+   * @return   void
+   */
+  int32_t temperature, humidity, pressure;
+  if (BME280.getSensorData(temperature, humidity, pressure)) {
+    Serial.print(temperature / 100.0, 2);
+    Serial.print(F("C "));
+    Serial.print(humidity / 100.0, 2);
+    Serial.print(F("% "));
+    Serial.print(pressure / 100.0, 2);
+    Serial.println(F("hPa"));
+  } else {
+    Serial.print(F("- Reading failed, error "));
+    Serial.println(BME280.lastError());
+  }  // of if-then-else reading succeeded
+  delay(10000);
+}  // of method loop()
@@ -3,400 +3,408 @@
  * @section BME280cpp_intro_section Description
  *
  * Arduino Library for the BME280 Bosch sensor\n\n
+ * This file only contains the platform-independent calibration and compensation code declared in
+ * BME280_Core.h and doesn't use any Arduino functions\n\n
  * See main library header file for details
  */
-#include "BME280.h"
-BME280_Class::BME280_Class() {}   ///< Empty & unused class constructor
-BME280_Class::~BME280_Class() {}  ///< Empty & unused class destructor
-bool BME280_Class::begin() {
+#include "BME280_Core.h"
+BME280_Core::BME280_Core() {}   ///< Empty & unused class constructor
+BME280_Core::~BME280_Core() {}  ///< Empty & unused class destructor
+static inline uint16_t readWord(const uint8_t *buffer, const uint8_t offset) {
   /*!
-   * @brief   Begin method to start I2C communications
-   * @details It is overloaded to allow for 3 different connection types to be used - I2C, Hardware
-   * SPI and Software SPI. When called with no parameters the I2C mode is enabled and the I2C bus is
-   * scanned for the first BME280 (typically at 0x76 or 0x77 unless an I2C expander is used to remap
-   * the address.
-   * @return  returns "true" when the class initialized correctly
+   * @brief     returns the little-endian 16-bit value stored at the given offset of a buffer
+   * @param[in] buffer Buffer containing register contents
+   * @param[in] offset Byte offset of the low byte
+   * @return    16-bit value
    */
-  return begin(I2C_STANDARD_MODE);  // Initialize I2C with slow speed
-}  // of method begin()
-bool BME280_Class::begin(const uint32_t i2cSpeed) {
+  return ((uint16_t)buffer[offset + 1] << 8) | buffer[offset];
+}  // of function readWord()
+void BME280_Core::decodeCalibration(const BME280_CalibrationRegisters &regs) {
   /*!
-   * @brief     Begin method to start I2C communications
-   * @details   It is overloaded to allow for 3 different connection types to be used - I2C,
-   * Hardware SPI and Software SPI. When called with no parameters the I2C mode is enabled and the
-   * I2C bus is scanned for the first BME280 (typically at 0x76 or 0x77 unless an I2C expander is
-   * used to remap the address.
-   * @param[in] i2cSpeed I2C speed rate in baud
-   * @return  returns "true" when the class initialized correctly
+   * @brief     decodes the calibration values from the raw image of both calibration blocks
+   * @details   The byte order is assembled explicitly so decoding does not depend on the processor
+   * type, see section 4.2.2 of the datasheet for the register layout
+   * @param[in] regs Calibration registers as read from the device
    */
-  Wire.begin();                                            // Start I2C as master device
-  Wire.setClock(i2cSpeed);                                 // Set I2C bus speed
-  for (_I2CAddress = 0; _I2CAddress < 127; _I2CAddress++)  // loop all possible addresses
-  {
-    Wire.beginTransmission(_I2CAddress);  // Check current address for BME280
-    if (Wire.endTransmission() == 0)      // If no error we have a device
-    {
-      if (readByte(BME280_CHIPID_REG) == BME280_CHIPID)  // check for correct chip id
-      {
-        getCalibration();  // get the calibration values
-        return true;
-      }             // of if-then device is really a BME280
-    }               // of if-then we have found a device
-  }                 // of for-next each I2C address loop
-  _I2CAddress = 0;  // Set to 0 to denote no I2C found
-  return false;
-}  // of method begin()
-bool BME280_Class::begin(const uint8_t chipSelect)  // Use hardware SPI for comms
-{
+  _cal.dig_T1 = readWord(regs.tp, BME280_T1_REG - BME280_T1_REG);
+  _cal.dig_T2 = (int16_t)readWord(regs.tp, BME280_T2_REG - BME280_T1_REG);
+  _cal.dig_T3 = (int16_t)readWord(regs.tp, BME280_T3_REG - BME280_T1_REG);
+  _cal.dig_P1 = readWord(regs.tp, BME280_P1_REG - BME280_T1_REG);
+  _cal.dig_P2 = (int16_t)readWord(regs.tp, BME280_P2_REG - BME280_T1_REG);
+  _cal.dig_P3 = (int16_t)readWord(regs.tp, BME280_P3_REG - BME280_T1_REG);
+  _cal.dig_P4 = (int16_t)readWord(regs.tp, BME280_P4_REG - BME280_T1_REG);
+  _cal.dig_P5 = (int16_t)readWord(regs.tp, BME280_P5_REG - BME280_T1_REG);
+  _cal.dig_P6 = (int16_t)readWord(regs.tp, BME280_P6_REG - BME280_T1_REG);
+  _cal.dig_P7 = (int16_t)readWord(regs.tp, BME280_P7_REG - BME280_T1_REG);
+  _cal.dig_P8 = (int16_t)readWord(regs.tp, BME280_P8_REG - BME280_T1_REG);
+  _cal.dig_P9 = (int16_t)readWord(regs.tp, BME280_P9_REG - BME280_T1_REG);
+  _cal.dig_H1 = regs.tp[BME280_H1_REG - BME280_T1_REG];
+  _cal.dig_H2 = (int16_t)readWord(regs.h, BME280_H2_REG - BME280_H2_REG);
+  _cal.dig_H3 = regs.h[BME280_H3_REG - BME280_H2_REG];
+  _cal.dig_H4 = (int16_t)((int8_t)regs.h[BME280_H4_REG - BME280_H2_REG] * 16 |  // bits 11:4
+                          (regs.h[BME280_H4_REG - BME280_H2_REG + 1] & 0x0F));  // bits 3:0
+  _cal.dig_H5 = (int16_t)((int8_t)regs.h[BME280_H5_REG - BME280_H2_REG + 1] * 16 |  // bits 11:4
+                          (regs.h[BME280_H5_REG - BME280_H2_REG] >> 4));            // bits 3:0
+  _cal.dig_H6 = (int8_t)regs.h[BME280_H6_REG - BME280_H2_REG];
+  prepareCoefficients();
+}  // of method decodeCalibration()
+void BME280_Core::prepareCoefficients() {
   /*!
-   * @brief     Begin method to start hardware SPI communications
-   * @details   It is overloaded to allow for 3 different connection types to be used - I2C,
-   * Hardware SPI and Software SPI. When called with no parameters the I2C mode is enabled and the
-   * I2C bus is scanned for the first BME280 (typically at 0x76 or 0x77 unless an I2C expander is
-   * used to remap the address.
-   * @param[in] chipSelect Hardware SPI CS chip
-   * @return  returns "true" when the class initialized correctly
+   * @brief     computes the terms of the compensation formulas which only depend on the calibration
+   * @details   Called whenever the calibration values change, so convert() doesn't repeat the
+   * conversions and shifts for every reading. Only terms which the formulas compute on their own
+   * are folded, so the results are bit-for-bit the same as those of the datasheet formulas
    */
-  _cs = chipSelect;                                  // Store value for future use
-  digitalWrite(_cs, HIGH);                           // High means ignore master
-  pinMode(_cs, OUTPUT);                              // Make the chip select pin output
-  SPI.begin();                                       // Start hardware SPI
-  if (readByte(BME280_CHIPID_REG) == BME280_CHIPID)  // check for correct chip id
-  {
-    getCalibration();  // get the calibration values
-    return true;       // return success
-  }                    // of if-then device is really a BME280
-  return false;        // return failure if we get here
-}  // of method begin()
-bool BME280_Class::begin(const uint8_t chipSelect, const uint8_t mosi, const uint8_t miso,
-                         const uint8_t sck) {
+#if BME280_COMPENSATION == BME280_COMPENSATION_FLOAT
+  _coef.T1d1024  = (double)_cal.dig_T1 / 1024.0;
+  _coef.T1d8192  = (double)_cal.dig_T1 / 8192.0;
+  _coef.T2       = (double)_cal.dig_T2;
+  _coef.T3       = (double)_cal.dig_T3;
+  _coef.P1       = (double)_cal.dig_P1;
+  _coef.P2       = (double)_cal.dig_P2;
+  _coef.P3       = (double)_cal.dig_P3;
+  _coef.P4x65536 = (double)_cal.dig_P4 * 65536.0;
+  _coef.P5       = (double)_cal.dig_P5;
+  _coef.P6       = (double)_cal.dig_P6;
+  _coef.P7       = (double)_cal.dig_P7;
+  _coef.P8       = (double)_cal.dig_P8;
+  _coef.P9       = (double)_cal.dig_P9;
+  _coef.H1       = (double)_cal.dig_H1;
+  _coef.H2d65536 = (double)_cal.dig_H2 / 65536.0;
+  _coef.H3d2p26  = (double)_cal.dig_H3 / 67108864.0;
+  _coef.H4x64    = (double)_cal.dig_H4 * 64.0;
+  _coef.H5d16384 = (double)_cal.dig_H5 / 16384.0;
+  _coef.H6d2p26  = (double)_cal.dig_H6 / 67108864.0;
+#elif BME280_COMPENSATION == BME280_COMPENSATION_INT32
+  _coef.T1x2     = (int32_t)_cal.dig_T1 << 1;
+  _coef.P4x65536 = (int32_t)_cal.dig_P4 * 65536;
+  _coef.P5x2     = (int32_t)_cal.dig_P5 * 2;
+  _coef.H4x2p20  = (int32_t)_cal.dig_H4 * 1048576;
+#else
+  _coef.P4x2p35 = (int64_t)_cal.dig_P4 * ((int64_t)1 << 35);
+  _coef.P5x2p17 = (int64_t)_cal.dig_P5 * ((int64_t)1 << 17);
+  _coef.P2x4096 = (int32_t)_cal.dig_P2 * 4096;
+  _coef.P7x16   = (int32_t)_cal.dig_P7 * 16;
+  _coef.T1x2    = (int32_t)_cal.dig_T1 << 1;
+  _coef.H4x2p20 = (int32_t)_cal.dig_H4 * 1048576;
+#endif
+}  // of method prepareCoefficients()
+void BME280_Core::compensate(const BME280_RawSample raw[], BME280_Reading out[],
+                             const uint16_t count, const uint8_t channels) const {
   /*!
-   * @brief     Begin method to start software SPI communications
-   * @details   It is overloaded to allow for 3 different connection types to be used - I2C,
-   * Hardware SPI and Software SPI. When called with no parameters the I2C mode is enabled and the
-   * I2C bus is scanned for the first BME280 (typically at 0x76 or 0x77 unless an I2C expander is
-   * used to remap the address.
-   * @param[in] chipSelect Hardware SPI CS chip
-   * @param[in] mosi Master-Out Slave-In pin
-   * @param[in] miso Master-In Slave-Out pin
-   * @param[in] sck  System Clock
-   * @return  returns "true" when the class initialized correctly
+   * @brief      converts an array of raw readings into temperature, humidity and pressure
+   * @details    Samples collected with getRawData() or fetchRawResult() can be converted in bulk
+   * away from the time-critical measurement loop. The results are identical to those returned by
+   * getSensorData() for the same raw readings and calibration values
+   * @param[in]  raw Array of raw readings
+   * @param[out] out Array receiving the compensated readings
+   * @param[in]  count Number of elements in both arrays
+   * @param[in]  channels Channels to convert, the temperature is always converted
    */
-  _cs   = chipSelect;
-  _mosi = mosi;
-  _miso = miso;
-  _sck  = sck;                                       // Store SPI pins
-  digitalWrite(_cs, HIGH);                           // High means ignore master
-  pinMode(_cs, OUTPUT);                              // Make the chip select pin output
-  pinMode(_sck, OUTPUT);                             // Make system clock pin output
-  pinMode(_mosi, OUTPUT);                            // Make master-out slave-in output
-  pinMode(_miso, INPUT);                             // Make master-in slave-out input
-  if (readByte(BME280_CHIPID_REG) == BME280_CHIPID)  // check for correct chip id
-  {
-    getCalibration();  // get the calibration values
-    return true;
-  }  // of if-then device is really a BME280
-  return false;
-}  // of method begin()
-void BME280_Class::getCalibration() {
+  for (uint16_t i = 0; i < count; i++) convert(raw[i].data, out[i], channels);
+}  // of method compensate()
+const BME280_Calibration &BME280_Core::calibration() const {
   /*!
-   * @brief     reads the calibration register data into local variables for use in converting
-   * readings
+   * @brief     returns the calibration values read from the device
+   * @details   Together with raw readings these are all that is needed to compensate readings on
+   * another device or computer
+   * @return    Decoded calibration values
    */
-  getData(BME280_T1_REG, _cal_dig_T1);
-  getData(BME280_T2_REG, _cal_dig_T2);
-  getData(BME280_T3_REG, _cal_dig_T3);
-  getData(BME280_P1_REG, _cal_dig_P1);
-  getData(BME280_P2_REG, _cal_dig_P2);
-  getData(BME280_P3_REG, _cal_dig_P3);
-  getData(BME280_P4_REG, _cal_dig_P4);
-  getData(BME280_P5_REG, _cal_dig_P5);
-  getData(BME280_P6_REG, _cal_dig_P6);
-  getData(BME280_P7_REG, _cal_dig_P7);
-  getData(BME280_P8_REG, _cal_dig_P8);
-  getData(BME280_P9_REG, _cal_dig_P9);
-  getData(BME280_H1_REG, _cal_dig_H1);
-  getData(BME280_H2_REG, _cal_dig_H2);
-  getData(BME280_H3_REG, _cal_dig_P3);
-  uint8_t tempVar;  // Single-Byte temporary variable
-  getData(BME280_H4_REG, tempVar);
-  _cal_dig_H4 = tempVar << 4;
-  getData(BME280_H4_REG + 1, tempVar);
-  _cal_dig_H4 |= tempVar & 0xF;
-  getData(BME280_H5_REG + 2, tempVar);
-  _cal_dig_H5 = tempVar << 4;
-  getData(BME280_H5_REG, tempVar);
-  _cal_dig_H5 |= tempVar >> 4;
-  getData(BME280_H6_REG, _cal_dig_H6);
-  _cal_dig_H5 = (readByte(BME280_H5_REG + 1) << 4) | (readByte(BME280_H5_REG) >> 4);
-  _cal_dig_H6 = readByte(BME280_H6_REG);
-}  // of method getCalibration()
-uint8_t BME280_Class::readByte(const uint8_t addr) {
+  return (_cal);
+}  // of method calibration()
+void BME280_Core::calibration(const BME280_Calibration &cal) {
   /*!
-   * @brief     interlude function to the getData() function. Reads 1 byte from the given address
-   * @param[in] addr Address to read data from
-   * @return    returns byte of data read
+   * @brief     sets the calibration values, used to compensate raw readings from another device
+   * @param[in] cal Decoded calibration values
    */
-  uint8_t returnValue;         // Storage for returned value
-  getData(addr, returnValue);  // Read just one byte
-  return (returnValue);        // Return byte just read
-}  // of method readByte()
-
-uint8_t BME280_Class::mode(const uint8_t operatingMode) {
+  _cal = cal;
+  prepareCoefficients();
+}  // of method calibration()
+uint8_t BME280_Core::crc8(const uint8_t *data, const uint8_t length, const uint8_t crc) {
   /*!
-   * @brief     sets the current mode bits or returns the current value if the parameter isn't used
-   * @param[in] operatingMode Device operating mode to set
-   * @return    new mode
+   * @brief     returns the CRC-8 checksum of a block of bytes
+   * @details   The polynomial is x^8 + x^5 + x^4 + 1 (0x31), as used by other Bosch and Sensirion
+   * sensors. Longer blocks can be checked in pieces by passing the result of the previous piece
+   * @param[in] data Bytes to check
+   * @param[in] length Number of bytes
+   * @param[in] crc Start value, 0xFF or the checksum of the previous piece
+   * @return    Checksum
    */
-  uint8_t controlRegister = readByte(BME280_CONTROL_REG);  // Get the control register
-  if (operatingMode == UINT8_MAX)
-    return (controlRegister & B00000011);                   // Return setting if no parameter
-  _mode           = operatingMode & B00000011;              // Mask 2 bits in input parameter
-  controlRegister = (controlRegister & B11111100) | _mode;  // set the new value
-  putData(BME280_CONTROL_REG, controlRegister);             // Write value back to register
-  return (_mode);
-}  // of method mode()
-
-bool BME280_Class::setOversampling(const uint8_t sensor, const uint8_t sampling) {
+  uint8_t returnValue = crc;
+  for (uint8_t i = 0; i < length; i++) {
+    returnValue ^= data[i];
+    for (uint8_t bit = 0; bit < 8; bit++)
+      returnValue = (returnValue & 0x80) ? (uint8_t)(returnValue << 1) ^ 0x31 : returnValue << 1;
+  }  // of for-next each byte
+  return (returnValue);
+}  // of method crc8()
+void BME280_Core::compensate(const uint8_t registerBuffer[8]) {
   /*!
-   * @brief     sets the oversampling mode for the sensor
-   * @details   see enumerated sensorTypes for list of values. Set to a valid oversampling rate as
-   * defined in the enumerated type oversamplingTypes. If either value is out of range or another
-   * error occurs then the return value is false.
-   * @param[in] sensor Which sensor to set
-   * @param[in] sampling Sampling rate
-   * @return    Always returns "true"
+   * @brief     converts the raw readings into temperature, pressure and humidity
+   * @details   The results are stored in the class variables
+   * @param[in] registerBuffer The 8 data bytes read from registers 0xF7 to 0xFE
    */
-  if (sensor >= UnknownSensor || sampling >= UnknownOversample)
-    return (false);                                        // return error if out of range
-  uint8_t originalControl = readByte(BME280_CONTROL_REG);  // Read the control register
-  while (readByte(BME280_CONTROL_REG) != 0)
-    putData(BME280_CONTROL_REG, 0);  // Put BME280 into sleep mode
-  if (sensor == HumiditySensor)      // If we have a humidity setting
-  {
-    putData(BME280_CONTROLHUMID_REG, sampling);  // Update humidity register
-  } else if (sensor == TemperatureSensor)        // otherwise if we have temperature
-  {
-    originalControl = (originalControl & B00011111) | (sampling << 5);  // Update the register bits
-  } else {
-    originalControl = (originalControl & B11100011) | (sampling << 2);  // Update the register bits
-  }                                              // of if-then-else temperature reading
-  putData(BME280_CONTROL_REG, originalControl);  // Write value to the register
-  return (true);
-}  // of method setOversampling()
-
-uint8_t BME280_Class::getOversampling(const uint8_t sensor, const bool actual) {
+  BME280_Reading reading;
+  convert(registerBuffer, reading);
+  _Temperature = reading.temperature;
+  _Humidity    = reading.humidity;
+  _Pressure    = reading.pressure;
+}  // of method compensate()
+/*************************************************************************************************
+** The compensation formulas, one set per engine. Each engine defines the same three functions, **
+** selected at compile time by BME280_COMPENSATION. The temperature is always computed first as **
+** its "t_fine" value is an input to the pressure and humidity formulas                         **
+*************************************************************************************************/
+#if BME280_COMPENSATION == BME280_COMPENSATION_FLOAT
+static inline int32_t roundToInt(const double value) {
   /*!
-   * @brief     retrieves the oversampling value for the sensor
-   * @details   see enumerated sensorTypes for list of values.
-   * @param[in] sensor Which sensor to retrieve
-   * @param[in] actual return the actual value if set, otherwise return the raw value
-   * @return    return value
+   * @brief     returns a floating point value rounded to the nearest integer
+   * @param[in] value Value to round
+   * @return    Rounded value
    */
-  uint8_t returnValue;                      // Get space for return value
-  if (sensor >= UnknownSensor) return (0);  // return a zero if out of range
-  if (sensor == HumiditySensor)             // If we have a humidity setting, read the buffer bits
-    returnValue = readByte(BME280_CONTROLHUMID_REG) & B00000111;
-  else if (sensor == TemperatureSensor)  // otherwise if we have temperature
-    returnValue = readByte(BME280_CONTROL_REG) >> 5;
-  else
-    returnValue = (readByte(BME280_CONTROL_REG) >> 2) & B00000111;
-  if (actual)  // If the actual flag has been set then return the oversampling
-  {
-    if (returnValue == 3)
-      returnValue = 4;
-    else if (returnValue == 4)
-      returnValue = 8;
-    else if (returnValue > 4)
-      returnValue = 16;
-  }                      // of if-then we return the actual count
-  return (returnValue);  // return oversampling bits
-}  // of method getOversampling()
-
-void BME280_Class::readSensors() {
+  return (value < 0.0) ? (int32_t)(value - 0.5) : (int32_t)(value + 0.5);
+}  // of function roundToInt()
+static int32_t compensateTemperature(const BME280_Calibration &,
+                                     const BME280_Coefficients &coef, const int32_t adcT,
+                                     int32_t &tfine) {
   /*!
-   * @brief     reads all 3 sensor values from the registers
-   * @details   Read all 3 in one operation and then proceeds to convert the raw temperature,
-   * pressure and humidity readings into standard metric units in the BME280's documentation but the
-   * math used below was taken from Adafruit's Adafruit_BME280_Library at
-   * https://github.com/adafruit/Adafruit_BME280_Library. I think it can be refactored into more
-   * efficient code at some point in the future, but it does work correctly
+   * @brief      converts the raw temperature using floating point math
+   * @details    These are the double precision formulas from section 8.1 of the datasheet. On AVR
+   * processors "double" is the same as "float" so the results are less accurate there
+   * @param[in]  coef Calibration values converted by prepareCoefficients()
+   * @param[in]  adcT Raw temperature reading
+   * @param[out] tfine Fine temperature value used by the pressure and humidity formulas
+   * @return     Temperature in centi-degrees Celsius
    */
-  uint8_t registerBuffer[8];
-  int64_t i, j, p;
-  if ((_mode == ForcedMode || _mode == ForcedMode2) && mode() == SleepMode)
-    mode(_mode);  // Force a reading if necessary
-  while ((readByte(BME280_STATUS_REG) & B00001001) != 0)
-    ;                                                // wait for measurement to complete
-  getData(BME280_PRESSUREDATA_REG, registerBuffer);  // read all 8 bytes in one go
-                                                     //*******************************//
-                                                     // First compute the temperature //
-                                                     //*******************************//
-  _Temperature = (int32_t)registerBuffer[3] << 12 | (int32_t)registerBuffer[4] << 4 |
-                 (int32_t)registerBuffer[5] >> 4;
-  i = ((((_Temperature >> 3) - ((int32_t)_cal_dig_T1 << 1))) * ((int32_t)_cal_dig_T2)) >> 11;
-  j = (((((_Temperature >> 4) - ((int32_t)_cal_dig_T1)) *
-         ((_Temperature >> 4) - ((int32_t)_cal_dig_T1))) >>
-        12) *
-       ((int32_t)_cal_dig_T3)) >>
+  double i = ((double)adcT / 16384.0 - coef.T1d1024) * coef.T2;
+  double j = ((double)adcT / 131072.0 - coef.T1d8192) *
+             ((double)adcT / 131072.0 - coef.T1d8192) * coef.T3;
+  tfine = (int32_t)(i + j);
+  return (roundToInt((i + j) / 51.2));  // In centi-degrees Celsius
+}  // of function compensateTemperature()
+static int32_t compensatePressure(const BME280_Calibration &,
+                                  const BME280_Coefficients &coef, const int32_t adcP,
+                                  const int32_t tfine) {
+  /*!
+   * @brief      converts the raw pressure using floating point math
+   * @param[in]  coef Calibration values converted by prepareCoefficients()
+   * @param[in]  adcP Raw pressure reading
+   * @param[in]  tfine Fine temperature value
+   * @return     Pressure in Pascals
+   */
+  double i, j, p;
+  i = (double)tfine / 2.0 - 64000.0;
+  j = i * i * coef.P6 / 32768.0;
+  j = j + i * coef.P5 * 2.0;
+  j = j / 4.0 + coef.P4x65536;
+  i = (coef.P3 * i * i / 524288.0 + coef.P2 * i) / 524288.0;
+  i = (1.0 + i / 32768.0) * coef.P1;
+  if (i == 0.0) return (0);  // avoid division by 0 exception
+  p = 1048576.0 - (double)adcP;
+  p = (p - j / 4096.0) * 6250.0 / i;
+  i = coef.P9 * p * p / 2147483648.0;
+  j = p * coef.P8 / 32768.0;
+  return (roundToInt(p + (i + j + coef.P7) / 16.0));  // in pascals
+}  // of function compensatePressure()
+static int32_t compensateHumidity(const BME280_Calibration &,
+                                  const BME280_Coefficients &coef, const int32_t adcH,
+                                  const int32_t tfine) {
+  /*!
+   * @brief      converts the raw humidity using floating point math
+   * @param[in]  coef Calibration values converted by prepareCoefficients()
+   * @param[in]  adcH Raw humidity reading
+   * @param[in]  tfine Fine temperature value
+   * @return     Humidity in centi-percent
+   */
+  double h = (double)tfine - 76800.0;
+  h = ((double)adcH - (coef.H4x64 + coef.H5d16384 * h)) *
+      (coef.H2d65536 * (1.0 + coef.H6d2p26 * h * (1.0 + coef.H3d2p26 * h)));
+  h = h * (1.0 - coef.H1 * h / 524288.0);
+  h = (h < 0.0) ? 0.0 : h;
+  h = (h > 100.0) ? 100.0 : h;
+  return (roundToInt(h * 100.0));  // in percent * 100
+}  // of function compensateHumidity()
+#elif BME280_COMPENSATION == BME280_COMPENSATION_INT32
+static int32_t compensateTemperature(const BME280_Calibration &cal,
+                                     const BME280_Coefficients &coef, const int32_t adcT,
+                                     int32_t &tfine) {
+  /*!
+   * @brief      converts the raw temperature using only 32-bit integer math
+   * @details    These are the 32-bit formulas from section 8.2 of the datasheet. Temperature and
+   * humidity are identical to the 64-bit engine, pressure is within a few Pascals of it over the
+   * sensor's operating range while avoiding the 64-bit multiplications and division
+   * @param[in]  cal Calibration values
+   * @param[in]  coef Terms prepared from the calibration values
+   * @param[in]  adcT Raw temperature reading
+   * @param[out] tfine Fine temperature value used by the pressure and humidity formulas
+   * @return     Temperature in centi-degrees Celsius
+   */
+  int32_t i = (((adcT >> 3) - coef.T1x2) * ((int32_t)cal.dig_T2)) >> 11;
+  int32_t j =
+      (((((adcT >> 4) - ((int32_t)cal.dig_T1)) * ((adcT >> 4) - ((int32_t)cal.dig_T1))) >> 12) *
+       ((int32_t)cal.dig_T3)) >>
       14;
-  _tfine       = i + j;
-  _Temperature = (_tfine * 5 + 128) >> 8;  // In centi-degrees Celsius
-                                           //*******************************//
-                                           // Now compute the pressure      //
-                                           //*******************************//
-  _Pressure = (int32_t)registerBuffer[0] << 12 | (int32_t)registerBuffer[1] << 4 |
-              (int32_t)registerBuffer[2] >> 4;
-  i = ((int64_t)_tfine) - 128000;
-  j = i * i * (int64_t)_cal_dig_P6;
-  j = j + ((i * (int64_t)_cal_dig_P5) << 17);
-  j = j + (((int64_t)_cal_dig_P4) << 35);
-  i = ((i * i * (int64_t)_cal_dig_P3) >> 8) + ((i * (int64_t)_cal_dig_P2) << 12);
-  i = (((((int64_t)1) << 47) + i)) * ((int64_t)_cal_dig_P1) >> 33;
-  if (i == 0)
-    _Pressure = 0;  // avoid division by 0 exception
-  else {
-    p         = 1048576 - _Pressure;
-    p         = (((p << 31) - j) * 3125) / i;
-    i         = (((int64_t)_cal_dig_P9) * (p >> 13) * (p >> 13)) >> 25;
-    j         = (((int64_t)_cal_dig_P8) * p) >> 19;
-    p         = ((p + i + j) >> 8) + (((int64_t)_cal_dig_P7) << 4);
-    _Pressure = p >> 8;  // in pascals
-  }                      // of if pressure would cause error
-                         //**********************************//
-                         // And finally compute the humidity //
-                         //**********************************//
-  _Humidity = (int32_t)registerBuffer[6] << 8 | (int32_t)registerBuffer[7];
-  i         = (_tfine - ((int32_t)76800));
-  i = (((((_Humidity << 14) - (((int32_t)_cal_dig_H4) << 20) - (((int32_t)_cal_dig_H5) * i)) +
+  tfine = i + j;
+  return ((tfine * 5 + 128) >> 8);  // In centi-degrees Celsius
+}  // of function compensateTemperature()
+static int32_t compensatePressure(const BME280_Calibration &cal,
+                                  const BME280_Coefficients &coef, const int32_t adcP,
+                                  const int32_t tfine) {
+  /*!
+   * @brief      converts the raw pressure using only 32-bit integer math
+   * @param[in]  cal Calibration values
+   * @param[in]  coef Terms prepared from the calibration values
+   * @param[in]  adcP Raw pressure reading
+   * @param[in]  tfine Fine temperature value
+   * @return     Pressure in Pascals
+   */
+  int32_t  i, j;
+  uint32_t p;
+  i = (tfine >> 1) - (int32_t)64000;
+  j = (((i >> 2) * (i >> 2)) >> 11) * ((int32_t)cal.dig_P6);
+  j = j + i * coef.P5x2;
+  j = (j >> 2) + coef.P4x65536;
+  i = (((cal.dig_P3 * (((i >> 2) * (i >> 2)) >> 13)) >> 3) + ((((int32_t)cal.dig_P2) * i) >> 1)) >>
+      18;
+  i = ((((32768 + i)) * ((int32_t)cal.dig_P1)) >> 15);
+  if (i == 0) return (0);  // avoid division by 0 exception
+  p = (((uint32_t)(((int32_t)1048576) - adcP) - (j >> 12))) * 3125;
+  if (p < 0x80000000)
+    p = (p << 1) / ((uint32_t)i);
+  else
+    p = (p / (uint32_t)i) * 2;
+  i = (((int32_t)cal.dig_P9) * ((int32_t)(((p >> 3) * (p >> 3)) >> 13))) >> 12;
+  j = (((int32_t)(p >> 2)) * ((int32_t)cal.dig_P8)) >> 13;
+  return ((int32_t)p + ((i + j + cal.dig_P7) >> 4));  // in pascals
+}  // of function compensatePressure()
+static int32_t compensateHumidity(const BME280_Calibration &cal,
+                                  const BME280_Coefficients &coef, const int32_t adcH,
+                                  const int32_t tfine) {
+  /*!
+   * @brief      converts the raw humidity using only 32-bit integer math
+   * @param[in]  cal Calibration values
+   * @param[in]  coef Terms prepared from the calibration values
+   * @param[in]  adcH Raw humidity reading
+   * @param[in]  tfine Fine temperature value
+   * @return     Humidity in centi-percent
+   */
+  int32_t i = (tfine - ((int32_t)76800));
+  i = (((((adcH << 14) - coef.H4x2p20 - (((int32_t)cal.dig_H5) * i)) +
          ((int32_t)16384)) >>
         15) *
-       (((((((i * ((int32_t)_cal_dig_H6)) >> 10) *
-            (((i * ((int32_t)_cal_dig_H3)) >> 11) + ((int32_t)32768))) >>
+       (((((((i * ((int32_t)cal.dig_H6)) >> 10) *
+            (((i * ((int32_t)cal.dig_H3)) >> 11) + ((int32_t)32768))) >>
            10) +
           ((int32_t)2097152)) *
-             ((int32_t)_cal_dig_H2) +
+             ((int32_t)cal.dig_H2) +
          8192) >>
         14));
-  i = (i - (((((i >> 15) * (i >> 15)) >> 7) * ((int32_t)_cal_dig_H1)) >> 4));
+  i = (i - (((((i >> 15) * (i >> 15)) >> 7) * ((int32_t)cal.dig_H1)) >> 4));
   i = (i < 0) ? 0 : i;
   i = (i > 419430400) ? 419430400 : i;
-  _Humidity = (uint32_t)(i >> 12) * 100 / 1024;  // in percent * 100
-}  // of method readSensors()
-
-uint8_t BME280_Class::iirFilter(const uint8_t iirFilterSetting) {
+  return ((uint32_t)(i >> 12) * 100 / 1024);  // in percent * 100
+}  // of function compensateHumidity()
+#else
+static int32_t compensateTemperature(const BME280_Calibration &cal,
+                                     const BME280_Coefficients &coef, const int32_t adcT,
+                                     int32_t &tfine) {
   /*!
-   * @brief     Set iir filter
-   * @details   when called with no parameters returns the current IIR Filter setting, otherwise
-   * when called with one parameter will set the IIR filter value and return the new setting
-   * @param[in] iirFilterSetting Set iir
-   * @return    Inactive time time
+   * @brief      converts the raw temperature using 64-bit integer math
+   * @details    The math used below was taken from Adafruit's Adafruit_BME280_Library at
+   * https://github.com/adafruit/Adafruit_BME280_Library and matches the datasheet's 64-bit
+   * pressure formula. This is the default and most accurate integer engine
+   * @param[in]  cal Calibration values
+   * @param[in]  coef Terms prepared from the calibration values
+   * @param[in]  adcT Raw temperature reading
+   * @param[out] tfine Fine temperature value used by the pressure and humidity formulas
+   * @return     Temperature in centi-degrees Celsius
    */
-  uint8_t returnValue = readByte(BME280_CONFIG_REG);  // Get control register byte
-  if (iirFilterSetting == UINT8_MAX)
-    return ((returnValue >> 2) & B00000111);           // return the current setting
-  returnValue = returnValue & B11100011;               // Get control reg, mask IIR bits
-  returnValue |= (iirFilterSetting & B00000111) << 2;  // use 3 bits of iirFilterSetting
-  putData(BME280_CONFIG_REG, returnValue);             // Write new control register value
-  returnValue = (returnValue >> 2) & B00000111;        // Extract IIR filter setting
-  return (returnValue);                                // Return IIR Filter setting
-}  // of method iirFilter()
-
-uint8_t BME280_Class::inactiveTime(const uint8_t inactiveTimeSetting) {
-  /*!
-   * @brief     Return the inactive time setting
-   * @details   when called with no parameters returns the current inactive time setting, otherwise
-   * uses the parameter to set the inactive time
-   * @param[in] inactiveTimeSetting
-   * @return    inactive time setting
-   */
-  uint8_t returnValue = readByte(BME280_CONFIG_REG);  // Get control register
-  if (inactiveTimeSetting != UINT8_MAX)               // If we have a specified value
-  {
-    returnValue = (returnValue & B00011111) |
-                  (inactiveTimeSetting << 5);  // use 3 bits of inactiveTimeSetting
-    putData(BME280_CONFIG_REG, returnValue);   // Write new control register value
-  }                                            // of if-then we have specified a new setting
-  return (returnValue >> 5);                   // Return inactive time setting
-}  // of method inactiveTime()
-
-uint32_t BME280_Class::measurementTime(const uint8_t measureTimeSetting) {
+  int64_t i = (((adcT >> 3) - coef.T1x2) * ((int32_t)cal.dig_T2)) >> 11;
+  int64_t j =
+      (((((adcT >> 4) - ((int32_t)cal.dig_T1)) * ((adcT >> 4) - ((int32_t)cal.dig_T1))) >> 12) *
+       ((int32_t)cal.dig_T3)) >>
+      14;
+  tfine = i + j;
+  return ((tfine * 5 + 128) >> 8);  // In centi-degrees Celsius
+}  // of function compensateTemperature()
+static int32_t compensatePressure(const BME280_Calibration &cal,
+                                  const BME280_Coefficients &coef, const int32_t adcP,
+                                  const int32_t tfine) {
   /*!
-   * @brief     returns the time in microseconds for a measurement cycle with the current settings
-   * @details   A cycle includes a temperature, pressure and humidity reading plus the wait time
-   * @param[in] measureTimeSetting
-   * @return    measurement cycle time
+   * @brief      converts the raw pressure using 64-bit integer math
+   * @param[in]  cal Calibration values
+   * @param[in]  coef Terms prepared from the calibration values
+   * @param[in]  adcP Raw pressure reading
+   * @param[in]  tfine Fine temperature value
+   * @return     Pressure in Pascals
    */
-  uint32_t Time1, Time2;
-  uint32_t returnValue = inactiveTime();  // Get inactive time value
-  switch (returnValue)                    // Set inactive time according to
-  {
-    case inactiveHalf:
-      returnValue = 500;
-      break;
-    case inactive63ms:
-      returnValue = 62500;
-      break;
-    case inactive125ms:
-      returnValue = 125000;
-      break;
-    case inactive250ms:
-      returnValue = 250000;
-      break;
-    case inactive500ms:
-      returnValue = 500000;
-      break;
-    case inactive1000ms:
-      returnValue = 1000000;
-      break;
-    case inactive10ms:
-      returnValue = 10000;
-      break;
-    case inactive20ms:
-      returnValue = 20000;
-      break;
-  }                                          // of switch for inactive time code
-  if (measureTimeSetting != TypicalMeasure)  // Set timing factors for Typ / Max
-  {
-    returnValue += 1250;
-    Time1 = 2300;
-    Time2 = 575;
-  } else {
-    returnValue += 1000;
-    Time1 = 2000;
-    Time2 = 500;
-  }  // of if-then-else typical time or maximum time
-  if (getOversampling(TemperatureSensor))
-    returnValue += Time1 * getOversampling(TemperatureSensor, true);
-  if (getOversampling(PressureSensor))
-    returnValue += (Time1 * getOversampling(PressureSensor, true)) + Time2;
-  if (getOversampling(HumiditySensor))
-    returnValue += (Time1 * getOversampling(HumiditySensor, true)) + Time2;
-  return (returnValue);
-}  // of method measurementTime()
-
-void BME280_Class::getSensorData(int32_t &temp, int32_t &hum, int32_t &press) {
+  int64_t i, j, p;
+  i = ((int64_t)tfine) - 128000;
+  j = i * i * (int64_t)cal.dig_P6;
+  j = j + i * coef.P5x2p17;
+  j = j + coef.P4x2p35;
+  i = ((i * i * (int64_t)cal.dig_P3) >> 8) + i * coef.P2x4096;
+  i = (((((int64_t)1) << 47) + i)) * ((int64_t)cal.dig_P1) >> 33;
+  if (i == 0) return (0);  // avoid division by 0 exception
+  p = 1048576 - adcP;
+  p = (((p << 31) - j) * 3125) / i;
+  i = (((int64_t)cal.dig_P9) * (p >> 13) * (p >> 13)) >> 25;
+  j = (((int64_t)cal.dig_P8) * p) >> 19;
+  p = ((p + i + j) >> 8) + coef.P7x16;
+  return (p >> 8);  // in pascals
+}  // of function compensatePressure()
+static int32_t compensateHumidity(const BME280_Calibration &cal,
+                                  const BME280_Coefficients &coef, const int32_t adcH,
+                                  const int32_t tfine) {
   /*!
-   * @brief      returns the most recent temperature, humidity and pressure readings
-   * @param[out] temp  temperature value from device
-   * @param[out] hum   humidity value from device
-   * @param[out] press pressure value from device
+   * @brief      converts the raw humidity using 64-bit integer math
+   * @param[in]  cal Calibration values
+   * @param[in]  coef Terms prepared from the calibration values
+   * @param[in]  adcH Raw humidity reading
+   * @param[in]  tfine Fine temperature value
+   * @return     Humidity in centi-percent
    */
-  readSensors();         // Get compensated data from BME280
-  temp  = _Temperature;  // Copy global variable to parameter
-  hum   = _Humidity;
-  press = _Pressure;
-}  // of method getSensorData()
-
-void BME280_Class::reset() {
+  int64_t i = (tfine - ((int32_t)76800));
+  i = (((((adcH << 14) - coef.H4x2p20 - (((int32_t)cal.dig_H5) * i)) +
+         ((int32_t)16384)) >>
+        15) *
+       (((((((i * ((int32_t)cal.dig_H6)) >> 10) *
+            (((i * ((int32_t)cal.dig_H3)) >> 11) + ((int32_t)32768))) >>
+           10) +
+          ((int32_t)2097152)) *
+             ((int32_t)cal.dig_H2) +
+         8192) >>
+        14));
+  i = (i - (((((i >> 15) * (i >> 15)) >> 7) * ((int32_t)cal.dig_H1)) >> 4));
+  i = (i < 0) ? 0 : i;
+  i = (i > 419430400) ? 419430400 : i;
+  return ((uint32_t)(i >> 12) * 100 / 1024);  // in percent * 100
+}  // of function compensateHumidity()
+#endif
+void BME280_Core::convert(const uint8_t registerBuffer[8], BME280_Reading &out,
+                          const uint8_t channels) const {
   /*!
-   * @brief      performs a device reset, as if it were powered down and back up again
+   * @brief      converts one set of raw readings into temperature, pressure and humidity
+   * @details    Converts the raw temperature, pressure and humidity readings into standard metric
+   * units as described in the BME280's documentation. The math used depends on the compile-time
+   * BME280_COMPENSATION setting, the default is the 64-bit integer engine. The temperature is
+   * always converted as the other two formulas need it, pressure and humidity only when
+   * requested. Values of channels which aren't converted are left unchanged
+   * @param[in]  registerBuffer The 8 data bytes read from registers 0xF7 to 0xFE
+   * @param[out] out Compensated readings
+   * @param[in]  channels Channels to convert, a combination of channelTypes values
    */
-  putData(BME280_SOFTRESET_REG, BME280_SOFTWARE_CODE);  // writing code here resets device
-  if (_I2CAddress)
-    begin();  // Start device again if I2C
-  else if (_sck)
-    begin(_cs, _mosi, _miso, _sck);  // Use software serial again
-  else
-    begin(_cs);  // otherwise it must be hardware SPI
-}  // of method reset()
+  int32_t tfine;
+  int32_t adcT = (int32_t)registerBuffer[3] << 12 | (int32_t)registerBuffer[4] << 4 |
+                 (int32_t)registerBuffer[5] >> 4;
+  out.temperature = compensateTemperature(_cal, _coef, adcT, tfine);
+  if (channels & PressureChannel) {
+    int32_t adcP = (int32_t)registerBuffer[0] << 12 | (int32_t)registerBuffer[1] << 4 |
+                   (int32_t)registerBuffer[2] >> 4;
+    out.pressure = compensatePressure(_cal, _coef, adcP, tfine);
+  }  // of if-then pressure requested
+  if (channels & HumidityChannel) {
+    int32_t adcH = (int32_t)registerBuffer[6] << 8 | (int32_t)registerBuffer[7];
+    out.humidity = compensateHumidity(_cal, _coef, adcH, tfine);
+  }  // of if-then humidity requested
+}  // of method convert()
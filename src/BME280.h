@@ -14,6 +14,10 @@
  The BME280 can use either SPI or I2C for communications. The initial library version 1.0.0 defines
  only I2C while subsequent versions also allow SPI communications\n\n
 
+ The bus is a compile-time policy of the BME280_Device<> class template, so a program which only
+ uses one bus only contains the code for that bus. BME280_Class is the original class which selects
+ I2C, hardware SPI or software SPI at runtime through its overloaded begin() methods\n\n
+
  The most recent version of the library is available at https://github.com/Zanduino/BME280 and
  extensive documentation of the library as well as example programs are described in the project's
  wiki pages located at https://github.com/Zanduino/BME280/wiki. \n\n
@@ -59,6 +63,51 @@
 
  Version| Date       | Developer  | Comments
  ------ | ---------- | ---------- | --------
+ 1.1.0  | 2026-10-18 | SV-Zanshin | BME280_Array waits with the clock of its devices' bus policies instead of micros() and yield()
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Statistics count the compensations, which stream() and report() skip for unchanged readings
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Only the coefficients of the selected engine are declared, replacing the union
+ 1.1.0  | 2026-10-18 | SV-Zanshin | set<Field>() returns "false" when a register write fails
+ 1.1.0  | 2026-10-18 | SV-Zanshin | BME280_Metrics::altitude() no longer overflows for pressures above 131071Pa
+ 1.1.0  | 2026-10-18 | SV-Zanshin | BME280_Tuner plans the sample period with the maximum conversion time
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Software SPI sets the pins through the set and clear registers on SAMD and ESP32 as well
+ 1.1.0  | 2026-10-18 | SV-Zanshin | BME280_ReplayBus moved to the Arduino-free BME280_Replay.h, time functions come from the bus policy
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Codec differences carry the low sample number byte, the decoder skips them after lost records
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Compensation coefficients of all engines share one union, same layout for every engine
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Warm start begin() takes the I2C speed and address or the SPI pins
+ 1.1.0  | 2026-10-18 | SV-Zanshin | A failed status read or forced mode trigger no longer returns stale readings
+ 1.1.0  | 2026-10-18 | SV-Zanshin | reset() keeps the calibration values if the registers read differ
+ 1.1.0  | 2026-10-18 | SV-Zanshin | stream() detects new samples from the status and timing, repeated readings are returned
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Software SPI port writes guarded against interrupts, AVR only
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Moved BME280_COMPENSATION to BME280_Options.h, mixed engines fail to link
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added MinMax option and AVR RAM check to BME280_SampleRing
+ 1.1.0  | 2026-10-18 | SV-Zanshin | scanI2C() starts the bus once and skips managed addresses
+ 1.1.0  | 2026-10-18 | SV-Zanshin | setOversampling() and apply() return "false" when a write fails
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added host build, simulated BME280 and unit tests in "test"
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added BME280_TraceBus and BME280_ReplayBus in BME280_Trace.h
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added report() with setThreshold() and setQuietInterval()
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added BME280_Encoder and BME280_Decoder in BME280_Codec.h
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Precomputed calibration-dependent terms of the compensation formulas
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added warm start of begin() from stored address and calibration
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added timeouts, lastError(), checkHealth() and recover()
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added register field descriptors and typed set<>()/get<>()
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added BME280_Metrics in BME280_Metrics.h
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added BME280_Tuner in BME280_Tuner.h
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added getSensorData() overload for selected channels
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added normal mode streaming with startStreaming() and stream()
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added optional BME280_STATISTICS counters
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added readRegisters()/writeRegisters(), removed static sizes
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added spiClock() and bulk hardware SPI reads
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Software SPI uses port registers, writes keep CS low
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Moved the platform-independent code to BME280_Core.h
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added BME280_COMPENSATION option for 32-bit and float math
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added getRawData(), fetchRawResult() and batch compensate()
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added BME280_SampleRing<N> in BME280_SampleRing.h
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added BME280_Array to measure many devices in one conversion window
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Added BME280_Config, apply() and the datasheet's recommended settings
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Settings are served from a copy of the control registers
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Non-blocking startMeasurement(), isReady() and fetchResult()
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Bus is a compile-time policy of BME280_Device<>, BME280_Class is an alias
+ 1.1.0  | 2026-10-18 | SV-Zanshin | Calibration read in two bursts and decoded from one buffer
  1.0.5  | 2019-01-31 | wolfbert   | Issue #9 - Corrected IIR mask bits
  1.0.3  | 2019-01-31 | SV-Zanshin | Issue #7 - Corrected documentation to Doxygen style
  1.0.2  | 2018-07-22 | SV-Zanshin | Corrected I2C Datatypes
@@ -71,9 +120,10 @@
  1.0.0a | 2017-07-30 | SV-Zanshin | Started coding
 */
 // clang-format on
-#include "Arduino.h"  // Arduino data type definitions
-#include <Wire.h>     // Standard I2C "Wire" library
-#include <SPI.h>      // Standard SPI library
+#include "Arduino.h"      // Arduino data type definitions
+#include <Wire.h>         // Standard I2C "Wire" library
+#include <SPI.h>          // Standard SPI library
+#include "BME280_Core.h"  // Register map, calibration and compensation
 #ifndef BME280_h
 /*! @brief Define guard code to prevent multiple inclusions */
 #define BME280_h
@@ -88,239 +138,1945 @@ const uint32_t I2C_FAST_MODE           = 400000;   ///< Fast mode
 const uint32_t I2C_FAST_MODE_PLUS_MODE = 1000000;  ///< Really fast mode
 const uint32_t I2C_HIGH_SPEED_MODE     = 3400000;  ///< Turbo mode
 #endif
-const uint32_t SPI_HERTZ               = 500000;  ///< SPI speed in Hz
-const uint8_t  BME280_CHIPID_REG       = 0xD0;    ///< Chip-Id register
-const uint8_t  BME280_CHIPID           = 0x60;    ///< Hard-coded value 0x60 for BME280
-const uint8_t  BME280_SOFTRESET_REG    = 0xE0;    ///< Reset when 0xB6 is written here
-const uint8_t  BME280_CONTROLHUMID_REG = 0xF2;    ///< Humidity control register
-const uint8_t  BME280_STATUS_REG       = 0xF3;    ///< Device status register
-const uint8_t  BME280_CONTROL_REG      = 0xF4;    ///< Device control register
-const uint8_t  BME280_CONFIG_REG       = 0xF5;    ///< Device configuration register
-const uint8_t  BME280_PRESSUREDATA_REG = 0xF7;    ///< Pressure readings register
-const uint8_t  BME280_TEMPDATA_REG     = 0xFA;    ///< Temperature readings register
-const uint8_t  BME280_HUMIDDATA_REG    = 0xFD;    ///< Humidity readings register
-const uint8_t  BME280_SOFTWARE_CODE    = 0xB6;    ///< Reset on this written to resetreg
-const uint8_t  BME280_T1_REG           = 0x88;    ///< Declare BME280 registers for the
-const uint8_t  BME280_T2_REG           = 0x8A;    ///< calibration data register
-const uint8_t  BME280_T3_REG           = 0x8C;    ///< calibration data register
-const uint8_t  BME280_P1_REG           = 0x8E;    ///< calibration data register
-const uint8_t  BME280_P2_REG           = 0x90;    ///< calibration data register
-const uint8_t  BME280_P3_REG           = 0x92;    ///< calibration data register
-const uint8_t  BME280_P4_REG           = 0x94;    ///< calibration data register
-const uint8_t  BME280_P5_REG           = 0x96;    ///< calibration data register
-const uint8_t  BME280_P6_REG           = 0x98;    ///< calibration data register
-const uint8_t  BME280_P7_REG           = 0x9A;    ///< calibration data register
-const uint8_t  BME280_P8_REG           = 0x9C;    ///< calibration data register
-const uint8_t  BME280_P9_REG           = 0x9E;    ///< calibration data register
-const uint8_t  BME280_H1_REG           = 0xA1;    ///< calibration data register
-const uint8_t  BME280_H2_REG           = 0xE1;    ///< calibration data register
-const uint8_t  BME280_H3_REG           = 0xE3;    ///< calibration data register
-const uint8_t  BME280_H4_REG           = 0xE4;    ///< calibration data register
-const uint8_t  BME280_H5_REG           = 0xE5;    ///< calibration data register
-const uint8_t  BME280_H6_REG           = 0xE7;    ///< calibration data register
+const uint32_t SPI_HERTZ       = 500000;  ///< Default SPI speed in Hz
+const uint32_t I2C_BUS_STARTED = 0;       ///< I2C speed for a bus the program has already started
 
 /*************************************************************************************************
-** Declare enumerated types used in the class                                                   **
+** Declare the bus policy classes. All device I/O goes through exactly one of these, and the    **
+** BME280_Device<> template below is instantiated with the policy that matches the hardware so  **
+** that the transfer path is chosen at compile time. Code for a bus which isn't used is never   **
+** instantiated and so never linked into the program. The device class also takes the time from **
+** the bus policy, so a policy which doesn't talk to a real device can supply its own clock. A  **
+** user-supplied bus class only needs to derive from BME280_ArduinoClock and offer the same     **
+** read() and write() methods and at least one begin() method, plus resume() and address() if   **
+** the warm start of BME280_Device<>::begin() is used. BME280_Trace.h adds a bus policy which   **
+** records the transfers of another policy, BME280_Replay.h one which replays a recorded trace  **
 *************************************************************************************************/
-/*! Device Mode list */
-enum modeTypes { SleepMode, ForcedMode, ForcedMode2, NormalMode, UnknownMode };
-/*! Sensor type list */
-enum sensorTypes { TemperatureSensor, HumiditySensor, PressureSensor, UnknownSensor };
-/*! Oversampling type list */
-enum oversamplingTypes {
-  SensorOff,
-  Oversample1,
-  Oversample2,
-  Oversample4,
-  Oversample8,
-  Oversample16,
-  UnknownOversample
-};
-/*! iir Filter type list */
-enum iirFilterTypes { IIROff, IIR2, IIR4, IIR8, IIR16, UnknownIIR };
-/*! inactive time type list */
-enum inactiveTimeTypes {
-  inactiveHalf,
-  inactive63ms,
-  inactive125ms,
-  inactive250ms,
-  inactive500ms,
-  inactive1000ms,
-  inactive10ms,
-  inactive20ms,
-  UnknownInactive
-};
-/*! Measure time type list */
-enum measureTimeTypes { TypicalMeasure, MaximumMeasure, UnknownMeasure };
+class BME280_ArduinoClock {
+  /*!
+    @class   BME280_ArduinoClock
+    @brief   Time functions of the bus policies, using those of the Arduino core
+    @details BME280_Device<> calls these through its bus policy instance for all timeouts and waits
+  */
+ public:
+  static uint32_t micros() {
+    /*!
+     * @brief     returns the microseconds since the program started
+     * @return    Arduino micros() value
+     */
+    return (::micros());
+  }  // of method micros()
+  static uint32_t millis() {
+    /*!
+     * @brief     returns the milliseconds since the program started
+     * @return    Arduino millis() value
+     */
+    return (::millis());
+  }  // of method millis()
+  static void delay(const uint32_t ms) {
+    /*!
+     * @brief     waits for the given time
+     * @param[in] ms Milliseconds to wait
+     */
+    ::delay(ms);
+  }  // of method delay()
+};  // of class BME280_ArduinoClock
+
+class BME280_I2CBus : public BME280_ArduinoClock {
+  /*!
+    @class   BME280_I2CBus
+    @brief   I2C bus policy using the standard "Wire" library
+  */
+ public:
+  bool begin(const uint32_t i2cSpeed = I2C_STANDARD_MODE) {
+    /*!
+     * @brief     Start I2C communications and search for the first BME280 on the bus
+     * @details   The I2C bus is scanned for the first device which answers with the BME280 chip id
+     * (typically at 0x76 or 0x77 unless an I2C expander is used to remap the address)
+     * @param[in] i2cSpeed I2C speed rate in baud, I2C_BUS_STARTED if Wire has already been started
+     * @return    returns "true" when a BME280 was found
+     */
+    startWire(i2cSpeed);                                     // Start I2C as master device
+    for (_I2CAddress = 0; _I2CAddress < 127; _I2CAddress++)  // loop all possible addresses
+    {
+      if (probe()) return true;  // Stop at the first BME280
+    }                            // of for-next each I2C address loop
+    _I2CAddress = 0;             // Set to 0 to denote no I2C found
+    return false;
+  }  // of method begin()
+  bool begin(const uint32_t i2cSpeed, const uint8_t address) {
+    /*!
+     * @brief     Start I2C communications with the BME280 at a known address
+     * @param[in] i2cSpeed I2C speed rate in baud, I2C_BUS_STARTED if Wire has already been started
+     * @param[in] address I2C address of the device
+     * @return    returns "true" when a BME280 answered at that address
+     */
+    startWire(i2cSpeed);       // Start I2C as master device
+    _I2CAddress = address;     // Use this address
+    if (probe()) return true;  // Check for a BME280
+    _I2CAddress = 0;           // Set to 0 to denote no I2C found
+    return false;
+  }  // of method begin()
+  bool resume(const uint8_t address, const uint32_t i2cSpeed = I2C_STANDARD_MODE) {
+    /*!
+     * @brief     Start I2C communications at the address found by an earlier begin()
+     * @details   Used for a warm start, where the device class checks the chip id, so no transfer
+     * is made here
+     * @param[in] address I2C address returned by address()
+     * @param[in] i2cSpeed I2C speed rate in baud, I2C_BUS_STARTED if Wire has already been started
+     * @return    returns "false" if the address isn't known
+     */
+    startWire(i2cSpeed);    // Start I2C as master device
+    _I2CAddress = address;  // Use the stored address
+    return (address != 0);
+  }  // of method resume()
+  uint8_t address() const {
+    /*!
+     * @brief     returns the I2C address of the device
+     * @return    I2C address, 0 if no device was found
+     */
+    return (_I2CAddress);
+  }  // of method address()
+  uint8_t read(const uint8_t addr, uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     Read "length" bytes starting at register "addr"
+     * @param[in] addr Register address
+     * @param[out] buffer Storage for the bytes read
+     * @param[in] length Number of bytes to read
+     * @return    Number of bytes actually read, 0 if the device didn't acknowledge
+     */
+    Wire.beginTransmission(_I2CAddress);             // Address the I2C device
+    Wire.write(addr);                                // Send register address to read
+    _TransmissionStatus = Wire.endTransmission();    // Close transmission
+    if (_TransmissionStatus) return (0);             // Device didn't acknowledge
+    Wire.requestFrom(_I2CAddress, (uint8_t)length);  // Request the data
+    uint8_t bytesRead = Wire.available();            // Use the actual number of bytes
+    if (bytesRead > length) bytesRead = length;      // but never more than requested
+    for (uint8_t i = 0; i < bytesRead; i++) buffer[i] = Wire.read();  // loop for each byte
+    return (bytesRead);
+  }  // of method read()
+  uint8_t write(const uint8_t addr, const uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     Write "length" bytes starting at register "addr"
+     * @details   The BME280 doesn't increment the address on writes, so each byte is sent as a
+     * pair of register address and data in a single transmission
+     * @param[in] addr Register address
+     * @param[in] buffer Bytes to write
+     * @param[in] length Number of bytes to write
+     * @return    Number of bytes written, 0 if the device didn't acknowledge
+     */
+    Wire.beginTransmission(_I2CAddress);  // Address the I2C device
+    for (uint8_t i = 0; i < length; i++) {
+      Wire.write(addr + i);                        // Send register address to write
+      Wire.write(buffer[i]);                       // followed by the data byte
+    }                                              // of for-next each byte
+    _TransmissionStatus = Wire.endTransmission();  // Close transmission
+    return (_TransmissionStatus ? 0 : length);
+  }  // of method write()
+  uint8_t transmissionStatus() const {
+    /*!
+     * @brief     returns the result of the last Wire.endTransmission() call
+     * @return    0 for success, 2 if the address or 3 if the data wasn't acknowledged, 4 for other
+     * bus errors
+     */
+    return (_TransmissionStatus);
+  }  // of method transmissionStatus()
+
+ private:
+  void startWire(const uint32_t i2cSpeed) {
+    /*!
+     * @brief     Starts the Wire library as master and sets the bus speed
+     * @details   Nothing is done for I2C_BUS_STARTED, so a program or BME280_Array::scanI2C() can
+     * start the bus once for many devices
+     * @param[in] i2cSpeed I2C speed rate in baud or I2C_BUS_STARTED
+     */
+    if (i2cSpeed == I2C_BUS_STARTED) return;  // Already started by the caller
+    Wire.begin();                             // Start I2C as master device
+    Wire.setClock(i2cSpeed);                  // Set I2C bus speed
+  }  // of method startWire()
+  bool probe() {
+    /*!
+     * @brief     Check whether a BME280 answers at the current I2C address
+     * @details   An address without a device doesn't acknowledge the register address sent by
+     * read(), so the chip id read doubles as the presence check
+     * @return    returns "true" when the device acknowledges and has the BME280 chip id
+     */
+    uint8_t chipId;  // Storage for chip id
+    return (read(BME280_CHIPID_REG, &chipId, 1) == 1 && chipId == BME280_CHIPID);
+  }  // of method probe()
+  uint8_t _TransmissionStatus = 0;  ///< Wire.endTransmission() result, 0 for success
+  uint8_t _I2CAddress         = 0;  ///< Default is no I2C address known
+};                                  // of class BME280_I2CBus
+
+class BME280_HardwareSPIBus : public BME280_ArduinoClock {
+  /*!
+    @class   BME280_HardwareSPIBus
+    @brief   Hardware SPI bus policy using the standard "SPI" library
+    @details The SPI clock is set per instance, the BME280 supports up to 10MHz. Multi-byte reads
+    use the buffer form of SPI.transfer(), which cores can implement more efficiently than a call
+    for each byte
+  */
+ public:
+  bool begin(const uint8_t chipSelect, const uint32_t spiSpeed = SPI_HERTZ) {
+    /*!
+     * @brief     Start hardware SPI communications
+     * @param[in] chipSelect Hardware SPI CS pin
+     * @param[in] spiSpeed SPI clock rate in Hz, defaults to SPI_HERTZ
+     * @return    Always returns "true", the device class checks the chip id
+     */
+    _cs = chipSelect;         // Store value for future use
+    spiClock(spiSpeed);       // Store the transaction settings
+    digitalWrite(_cs, HIGH);  // High means ignore master
+    pinMode(_cs, OUTPUT);     // Make the chip select pin output
+    SPI.begin();              // Start hardware SPI
+    return true;
+  }  // of method begin()
+  bool resume(const uint8_t, const uint8_t chipSelect, const uint32_t spiSpeed = SPI_HERTZ) {
+    /*!
+     * @brief     Start hardware SPI communications for a warm start, the same as begin()
+     * @param[in] chipSelect Hardware SPI CS pin
+     * @param[in] spiSpeed SPI clock rate in Hz, defaults to SPI_HERTZ
+     * @return    Always returns "true"
+     */
+    return (begin(chipSelect, spiSpeed));
+  }  // of method resume()
+  uint8_t address() const {
+    /*!
+     * @brief     returns the bus address of the device, SPI devices are selected by pin instead
+     * @return    Always 0
+     */
+    return (0);
+  }  // of method address()
+  void spiClock(const uint32_t spiSpeed) {
+    /*!
+     * @brief     Sets the SPI clock rate used for all following transfers
+     * @param[in] spiSpeed SPI clock rate in Hz
+     */
+    _settings = SPISettings(spiSpeed, MSBFIRST, SPI_MODE0);
+  }  // of method spiClock()
+  uint8_t read(const uint8_t addr, uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     Read "length" bytes starting at register "addr"
+     * @param[in] addr Register address
+     * @param[out] buffer Storage for the bytes read
+     * @param[in] length Number of bytes to read
+     * @return    Number of bytes read
+     */
+    SPI.beginTransaction(_settings);  // Start the transaction
+    digitalWrite(_cs, LOW);           // Tell BME280 to listen
+    SPI.transfer(addr | 0x80);        // bit 7 is high, so read a byte
+    if (length == 1) {
+      buffer[0] = SPI.transfer(0);  // Single byte, e.g. a status poll
+    } else {
+      memset(buffer, 0, length);     // Clock out zeroes
+      SPI.transfer(buffer, length);  // and read all bytes in one call
+    }                                // of if-then-else a single byte
+    digitalWrite(_cs, HIGH);         // Tell BME280 to stop
+    SPI.endTransaction();            // End the transaction
+    return (length);
+  }  // of method read()
+  uint8_t write(const uint8_t addr, const uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     Write "length" bytes starting at register "addr"
+     * @details   The BME280 doesn't increment the address on writes, so each byte is sent as a
+     * pair of register address and data while chip select stays low for the whole write
+     * @param[in] addr Register address
+     * @param[in] buffer Bytes to write
+     * @param[in] length Number of bytes to write
+     * @return    Number of bytes written
+     */
+    SPI.beginTransaction(_settings);  // Start the transaction
+    digitalWrite(_cs, LOW);           // Tell BME280 to listen
+    for (uint8_t i = 0; i < length; i++) {
+      SPI.transfer((addr + i) & ~0x80);  // bit 7 is low, so write a byte
+      SPI.transfer(buffer[i]);           // followed by the data byte
+    }                                    // of for-next each byte
+    digitalWrite(_cs, HIGH);             // Tell BME280 to stop
+    SPI.endTransaction();                // End the transaction
+    return (length);
+  }  // of method write()
+
+ private:
+  uint8_t     _cs       = 0;                                        ///< Chip select pin
+  SPISettings _settings = SPISettings(SPI_HERTZ, MSBFIRST, SPI_MODE0);  ///< Transaction settings
+};  // of class BME280_HardwareSPIBus
+
+#if defined(__AVR__) && defined(portOutputRegister) && defined(portInputRegister) && \
+    defined(digitalPinToBitMask)
+/*! @brief The AVR core maps pins to port registers, so software SPI can toggle pins directly. The
+ * port updates are read-modify-write sequences, so interrupts are held off while they run */
+#define BME280_FAST_GPIO
+/*! @brief Port writes change the whole port, see BME280_FAST_GPIO */
+#define BME280_GPIO_READ_MODIFY_WRITE
+/*! @brief Output port register pointer type, 8 bits on AVR */
+typedef decltype(portOutputRegister(digitalPinToPort(0))) BME280_OutputPort;
+/*! @brief Input port register pointer type */
+typedef decltype(portInputRegister(digitalPinToPort(0))) BME280_InputPort;
+/*! @brief Pin bit mask type of the core */
+typedef decltype(digitalPinToBitMask(0)) BME280_PortMask;
+#elif defined(ARDUINO_ARCH_SAMD) || (defined(ESP32) && defined(GPIO_OUT_W1TS_REG))
+/*! @brief SAMD and ESP32 processors have registers which set or clear only the pins whose bits are
+ * written, so the pins are changed directly without holding off interrupts */
+#define BME280_FAST_GPIO
+/*! @brief Output set or clear register pointer type */
+typedef volatile uint32_t *BME280_OutputPort;
+/*! @brief Input register pointer type */
+typedef volatile const uint32_t *BME280_InputPort;
+/*! @brief Pin bit mask type */
+typedef uint32_t BME280_PortMask;
+#endif
+class BME280_SoftwareSPIBus : public BME280_ArduinoClock {
+  /*!
+    @class   BME280_SoftwareSPIBus
+    @brief   Software (bit-banged) SPI bus policy using any 4 digital pins
+    @details On AVR, SAMD and ESP32 processors the registers and bit mask of each pin are looked up
+    once in begin() and the pins are then set and read directly, which is many times faster than
+    using digitalWrite() and digitalRead() for each clock edge. On AVR setting a bit in a port
+    register reads, changes and writes the whole port, so interrupts are disabled for each byte
+    transferred, about 5 microseconds at 16MHz, to keep an interrupt routine which changes another
+    pin of the same port from being undone. SAMD and ESP32 have set and clear registers which only
+    change the pins written, so interrupts stay enabled. Other cores, e.g. ESP8266 whose pin 16
+    has no such registers, fall back to the standard pin functions
+  */
+ public:
+  bool begin(const uint8_t chipSelect, const uint8_t mosi, const uint8_t miso, const uint8_t sck) {
+    /*!
+     * @brief     Start software SPI communications
+     * @param[in] chipSelect Chip select pin
+     * @param[in] mosi Master-Out Slave-In pin
+     * @param[in] miso Master-In Slave-Out pin
+     * @param[in] sck  System Clock
+     * @return    Always returns "true", the device class checks the chip id
+     */
+    _cs   = chipSelect;
+    _mosi = mosi;
+    _miso = miso;
+    _sck  = sck;               // Store SPI pins
+    digitalWrite(_cs, HIGH);   // High means ignore master
+    pinMode(_cs, OUTPUT);      // Make the chip select pin output
+    pinMode(_sck, OUTPUT);     // Make system clock pin output
+    pinMode(_mosi, OUTPUT);    // Make master-out slave-in output
+    pinMode(_miso, INPUT);     // Make master-in slave-out input
+    digitalWrite(_sck, LOW);   // digitalWrite() also switches off PWM on a pin, which the direct
+    digitalWrite(_mosi, LOW);  // port access of the transfers doesn't
+#ifdef BME280_FAST_GPIO
+    // Look up the registers and masks once, so that the transfers only set or clear a bit
+    BME280_OutputPort unusedOutput;  // Output registers of the input pin
+    BME280_InputPort  unusedInput;   // Input registers of the output pins
+    _csMask   = lookUp(_cs, _csSet, _csClear, unusedInput);
+    _sckMask  = lookUp(_sck, _sckSet, _sckClear, unusedInput);
+    _mosiMask = lookUp(_mosi, _mosiSet, _mosiClear, unusedInput);
+    _misoMask = lookUp(_miso, unusedOutput, unusedOutput, _misoPort);
+#endif
+    return true;
+  }  // of method begin()
+  bool resume(const uint8_t, const uint8_t chipSelect, const uint8_t mosi, const uint8_t miso,
+              const uint8_t sck) {
+    /*!
+     * @brief     Start software SPI communications for a warm start, the same as begin()
+     * @param[in] chipSelect Chip select pin
+     * @param[in] mosi Master-Out Slave-In pin
+     * @param[in] miso Master-In Slave-Out pin
+     * @param[in] sck  System Clock
+     * @return    Always returns "true"
+     */
+    return (begin(chipSelect, mosi, miso, sck));
+  }  // of method resume()
+  uint8_t address() const {
+    /*!
+     * @brief     returns the bus address of the device, SPI devices are selected by pin instead
+     * @return    Always 0
+     */
+    return (0);
+  }  // of method address()
+  uint8_t read(const uint8_t addr, uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     Read "length" bytes starting at register "addr"
+     * @param[in] addr Register address
+     * @param[out] buffer Storage for the bytes read
+     * @param[in] length Number of bytes to read
+     * @return    Number of bytes read
+     */
+    select(true);                                                  // Tell BME280 to listen up
+    transfer(addr | 0x80);                                         // bit 7 is high for a read
+    for (uint8_t i = 0; i < length; i++) buffer[i] = transfer(0);  // loop for each byte
+    select(false);                                                 // Tell BME280 to stop
+    return (length);
+  }  // of method read()
+  uint8_t write(const uint8_t addr, const uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     Write "length" bytes starting at register "addr"
+     * @details   The BME280 doesn't increment the address on writes, so each byte is sent as a
+     * pair of register address and data while chip select stays low for the whole write
+     * @param[in] addr Register address
+     * @param[in] buffer Bytes to write
+     * @param[in] length Number of bytes to write
+     * @return    Number of bytes written
+     */
+    select(true);  // Tell BME280 to listen up
+    for (uint8_t i = 0; i < length; i++) {
+      transfer((addr + i) & ~0x80);  // bit 7 is low for a write
+      transfer(buffer[i]);           // followed by the data byte
+    }                                // of for-next each byte to be written
+    select(false);                   // Tell BME280 to stop listening
+    return (length);
+  }  // of method write()
+
+ private:
+#ifdef BME280_FAST_GPIO
+  static BME280_PortMask lookUp(const uint8_t pin, BME280_OutputPort &set, BME280_OutputPort &clear,
+                                BME280_InputPort &input) {
+    /*!
+     * @brief      looks up the registers used to set, clear and read a pin
+     * @param[in]  pin Arduino pin number
+     * @param[out] set Register which sets the pin
+     * @param[out] clear Register which clears the pin, the same as "set" on AVR
+     * @param[out] input Register which reads the pin
+     * @return     Bit mask of the pin in the registers
+     */
+#if defined(BME280_GPIO_READ_MODIFY_WRITE)
+    set = clear = portOutputRegister(digitalPinToPort(pin));
+    input       = portInputRegister(digitalPinToPort(pin));
+    return (digitalPinToBitMask(pin));
+#elif defined(ARDUINO_ARCH_SAMD)
+    PortGroup &group = PORT->Group[g_APinDescription[pin].ulPort];
+    set              = &group.OUTSET.reg;
+    clear            = &group.OUTCLR.reg;
+    input            = &group.IN.reg;
+    return (1UL << g_APinDescription[pin].ulPin);
+#else  // ESP32
+#ifdef GPIO_OUT1_W1TS_REG
+    if (pin >= 32) {
+      set   = (BME280_OutputPort)GPIO_OUT1_W1TS_REG;
+      clear = (BME280_OutputPort)GPIO_OUT1_W1TC_REG;
+      input = (BME280_InputPort)GPIO_IN1_REG;
+      return (1UL << (pin - 32));
+    }  // of if-then second bank of pins
+#endif
+    set   = (BME280_OutputPort)GPIO_OUT_W1TS_REG;
+    clear = (BME280_OutputPort)GPIO_OUT_W1TC_REG;
+    input = (BME280_InputPort)GPIO_IN_REG;
+    return (1UL << pin);
+#endif
+  }  // of method lookUp()
+  static void pinHigh(BME280_OutputPort set, const BME280_PortMask mask) {
+    /*!
+     * @brief     sets a pin high
+     * @param[in] set Register which sets the pin
+     * @param[in] mask Bit mask of the pin
+     */
+#ifdef BME280_GPIO_READ_MODIFY_WRITE
+    *set |= mask;
+#else
+    *set = mask;
+#endif
+  }  // of method pinHigh()
+  static void pinLow(BME280_OutputPort clear, const BME280_PortMask mask) {
+    /*!
+     * @brief     sets a pin low
+     * @param[in] clear Register which clears the pin
+     * @param[in] mask Bit mask of the pin
+     */
+#ifdef BME280_GPIO_READ_MODIFY_WRITE
+    *clear &= ~mask;
+#else
+    *clear = mask;
+#endif
+  }  // of method pinLow()
+#endif
+  void select(const bool active) {
+    /*!
+     * @brief     sets the chip select pin, low selects the device
+     * @param[in] active Whether to select the device
+     */
+#ifdef BME280_FAST_GPIO
+#ifdef BME280_GPIO_READ_MODIFY_WRITE
+    uint8_t sreg = SREG;  // Keep the interrupt state
+    cli();                // No interrupts while the port is changed
+#endif
+    if (active)
+      pinLow(_csClear, _csMask);
+    else
+      pinHigh(_csSet, _csMask);
+#ifdef BME280_GPIO_READ_MODIFY_WRITE
+    SREG = sreg;  // Restore the interrupt state
+#endif
+#else
+    digitalWrite(_cs, active ? LOW : HIGH);
+#endif
+  }  // of method select()
+  uint8_t transfer(uint8_t data) {
+    /*!
+     * @brief     sends and receives one byte, most significant bit first in SPI mode 0
+     * @details   MOSI is set while the clock is low, the device latches it on the rising edge and
+     * its MISO bit is read after that edge
+     * @param[in] data Byte to send
+     * @return    Byte received
+     */
+    uint8_t reply = 0;
+#ifdef BME280_GPIO_READ_MODIFY_WRITE
+    uint8_t sreg = SREG;  // Keep the interrupt state
+    cli();                // No interrupts while the ports are changed
+#endif
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      reply <<= 1;  // shift buffer one bit left
+#ifdef BME280_FAST_GPIO
+      pinLow(_sckClear, _sckMask);  // set the clock signal low
+      if (data & 0x80)              // set the MOSI pin state
+        pinHigh(_mosiSet, _mosiMask);
+      else
+        pinLow(_mosiClear, _mosiMask);
+      pinHigh(_sckSet, _sckMask);              // reset the clock signal
+      if (*_misoPort & _misoMask) reply |= 1;  // read the MISO bit, add to reply
+#else
+      digitalWrite(_sck, LOW);             // set the clock signal
+      digitalWrite(_mosi, data & 0x80);    // set the MOSI pin state
+      digitalWrite(_sck, HIGH);            // reset the clock signal
+      if (digitalRead(_miso)) reply |= 1;  // read the MISO bit, add to reply
+#endif
+      data <<= 1;  // next bit to send
+    }              // of for-next each bit
+#ifdef BME280_GPIO_READ_MODIFY_WRITE
+    SREG = sreg;  // Restore the interrupt state
+#endif
+    return (reply);
+  }  // of method transfer()
+  uint8_t _cs = 0, _sck = 0, _mosi = 0, _miso = 0;  ///< Software SPI pins
+#ifdef BME280_FAST_GPIO
+  BME280_OutputPort _csSet = nullptr, _sckSet = nullptr, _mosiSet = nullptr;  ///< Set registers
+  BME280_OutputPort _csClear = nullptr, _sckClear = nullptr, _mosiClear = nullptr;  ///< Clear
+  BME280_InputPort  _misoPort = nullptr;                                        ///< Input register
+  BME280_PortMask   _csMask = 0, _sckMask = 0, _mosiMask = 0, _misoMask = 0;   ///< Pin masks
+#endif
+};  // of class BME280_SoftwareSPIBus
 
-class BME280_Class {
+class BME280_AnyBus : public BME280_ArduinoClock {
   /*!
-    @class BME280_Class
-    @brief BME280 Class definition
-    @details BME280 Class forward declarations for methods and public/private variable
-    declarations
+    @class   BME280_AnyBus
+    @brief   Bus policy which selects I2C, hardware SPI or software SPI at runtime
+    @details This is the policy behind BME280_Class and keeps the original overloaded begin()
+    methods. It pulls in all three transfer paths, so programs which only ever use one bus should
+    instantiate BME280_Device<> with that bus policy directly
   */
  public:
-  BME280_Class();
-  ~BME280_Class();
-  bool begin();
-  bool begin(const uint32_t i2cSpeed);
-  bool begin(const uint8_t chipSelect);
-  bool begin(const uint8_t chipSelect, const uint8_t mosi, const uint8_t miso, const uint8_t sck);
-  uint8_t  mode(const uint8_t operatingMode = UINT8_MAX);
-  bool     setOversampling(const uint8_t sensor, const uint8_t sampling);
-  uint8_t  getOversampling(const uint8_t sensor, const bool actual = false);
-  uint8_t  iirFilter(const uint8_t iirFilterSetting = UINT8_MAX);
-  uint8_t  inactiveTime(const uint8_t inactiveTimeSetting = UINT8_MAX);
-  uint32_t measurementTime(const uint8_t measureTimeSetting = 1);
-  void     getSensorData(int32_t &temp, int32_t &hum, int32_t &press);
-  void     reset();
+  bool begin(const uint32_t i2cSpeed = I2C_STANDARD_MODE) {
+    /*!
+     * @brief     Use I2C and search for the first BME280 on the bus
+     * @param[in] i2cSpeed I2C speed rate in baud
+     * @return    returns "true" when a BME280 was found
+     */
+    _busType = I2CBus;
+    return _i2c.begin(i2cSpeed);
+  }  // of method begin()
+  bool begin(const uint32_t i2cSpeed, const uint8_t address) {
+    /*!
+     * @brief     Use I2C with the BME280 at a known address
+     * @param[in] i2cSpeed I2C speed rate in baud
+     * @param[in] address I2C address of the device
+     * @return    returns "true" when a BME280 answered at that address
+     */
+    _busType = I2CBus;
+    return _i2c.begin(i2cSpeed, address);
+  }  // of method begin()
+  bool begin(const uint8_t chipSelect) {
+    /*!
+     * @brief     Use hardware SPI
+     * @param[in] chipSelect Hardware SPI CS pin
+     * @return    Always returns "true"
+     */
+    _busType = HardwareSPIBus;
+    return _hwspi.begin(chipSelect);
+  }  // of method begin()
+  void spiClock(const uint32_t spiSpeed) {
+    /*!
+     * @brief     Sets the hardware SPI clock rate, the default is SPI_HERTZ
+     * @param[in] spiSpeed SPI clock rate in Hz
+     */
+    _hwspi.spiClock(spiSpeed);
+  }  // of method spiClock()
+  bool begin(const uint8_t chipSelect, const uint8_t mosi, const uint8_t miso, const uint8_t sck) {
+    /*!
+     * @brief     Use software SPI
+     * @param[in] chipSelect Chip select pin
+     * @param[in] mosi Master-Out Slave-In pin
+     * @param[in] miso Master-In Slave-Out pin
+     * @param[in] sck  System Clock
+     * @return    Always returns "true"
+     */
+    _busType = SoftwareSPIBus;
+    return _swspi.begin(chipSelect, mosi, miso, sck);
+  }  // of method begin()
+  bool resume(const uint8_t address, const uint32_t i2cSpeed = I2C_STANDARD_MODE) {
+    /*!
+     * @brief     Use I2C with the address found by an earlier begin(), for a warm start
+     * @param[in] address I2C address returned by address()
+     * @param[in] i2cSpeed I2C speed rate in baud
+     * @return    returns "false" if the address isn't known
+     */
+    _busType = I2CBus;
+    return _i2c.resume(address, i2cSpeed);
+  }  // of method resume()
+  bool resume(const uint8_t address, const uint8_t chipSelect) {
+    /*!
+     * @brief     Use hardware SPI for a warm start
+     * @param[in] address Unused
+     * @param[in] chipSelect Hardware SPI CS pin
+     * @return    Always returns "true"
+     */
+    _busType = HardwareSPIBus;
+    return _hwspi.resume(address, chipSelect);
+  }  // of method resume()
+  bool resume(const uint8_t address, const uint8_t chipSelect, const uint8_t mosi,
+              const uint8_t miso, const uint8_t sck) {
+    /*!
+     * @brief     Use software SPI for a warm start
+     * @param[in] address Unused
+     * @param[in] chipSelect Chip select pin
+     * @param[in] mosi Master-Out Slave-In pin
+     * @param[in] miso Master-In Slave-Out pin
+     * @param[in] sck  System Clock
+     * @return    Always returns "true"
+     */
+    _busType = SoftwareSPIBus;
+    return _swspi.resume(address, chipSelect, mosi, miso, sck);
+  }  // of method resume()
+  uint8_t address() const {
+    /*!
+     * @brief     returns the I2C address of the device
+     * @return    I2C address, 0 for SPI or if no device was found
+     */
+    return (_busType == I2CBus ? _i2c.address() : 0);
+  }  // of method address()
+  uint8_t read(const uint8_t addr, uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     Read "length" bytes starting at register "addr" from the active bus
+     * @param[in] addr Register address
+     * @param[out] buffer Storage for the bytes read
+     * @param[in] length Number of bytes to read
+     * @return    Number of bytes read
+     */
+    if (_busType == I2CBus) return _i2c.read(addr, buffer, length);
+    if (_busType == HardwareSPIBus) return _hwspi.read(addr, buffer, length);
+    return _swspi.read(addr, buffer, length);
+  }  // of method read()
+  uint8_t write(const uint8_t addr, const uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     Write "length" bytes starting at register "addr" to the active bus
+     * @param[in] addr Register address
+     * @param[in] buffer Bytes to write
+     * @param[in] length Number of bytes to write
+     * @return    Number of bytes written
+     */
+    if (_busType == I2CBus) return _i2c.write(addr, buffer, length);
+    if (_busType == HardwareSPIBus) return _hwspi.write(addr, buffer, length);
+    return _swspi.write(addr, buffer, length);
+  }  // of method write()
+
+ private:
+  enum busTypes { I2CBus, HardwareSPIBus, SoftwareSPIBus };  ///< Supported buses
+  uint8_t               _busType = I2CBus;                   ///< Bus selected in begin()
+  BME280_I2CBus         _i2c;                                ///< I2C bus
+  BME280_HardwareSPIBus _hwspi;                              ///< Hardware SPI bus
+  BME280_SoftwareSPIBus _swspi;                              ///< Software SPI bus
+};                                                           // of class BME280_AnyBus
+
+/*! Function called by stream() for each new sample, the time is the millis() value */
+typedef void (*BME280_StreamCallback)(const uint32_t timestamp, const BME280_Reading &reading);
+/*! Function which loads ("save" is false) or saves the warm start data, e.g. in EEPROM. A load
+ * returns "false" if there is nothing stored, the contents are checked by begin() */
+typedef bool (*BME280_StorageCallback)(uint8_t *data, const uint8_t length, const bool save);
+
+template <class Bus>
+class BME280_Device : public BME280_Core {
+  /*!
+    @class   BME280_Device
+    @brief   BME280 class template, parameterized by the bus policy used for all device I/O
+    @details The bus policy is one of BME280_I2CBus, BME280_HardwareSPIBus, BME280_SoftwareSPIBus,
+    BME280_AnyBus or a user-supplied class with the same methods. The begin() method passes its
+    parameters on to the begin() method of the bus policy, and all timeouts and waits use the
+    micros(), millis() and delay() methods of the bus policy
+  */
+ public:
+  template <typename... Args>
+  bool begin(Args... args) {
+    /*!
+     * @brief     Begin method to start communications
+     * @details   The parameters are those of the bus policy's begin() method, so for BME280_Class
+     * the original overloads remain - no parameters or an I2C speed for I2C, a chip select pin for
+     * hardware SPI and 4 pins for software SPI
+     * @param[in] args Bus-specific parameters
+     * @return    returns "true" when the class initialized correctly
+     */
+    _error = NoError;                        // No errors yet
+    if (!_bus.begin(args...)) return false;  // Bus couldn't be started
+    if (readByte(BME280_CHIPID_REG) != BME280_CHIPID) return fail(ChipIdError);  // Not a BME280
+    if (!getCalibration()) return false;     // get the calibration values
+    syncFromDevice();                        // get the current settings
+    return true;
+  }  // of method begin()
+  bool begin(BME280_StorageCallback storage, const uint32_t i2cSpeed = I2C_STANDARD_MODE,
+             const uint8_t address = 0) {
+    /*!
+     * @brief     Begin method for I2C with a warm start from data kept across power cycles
+     * @details   The bus address found by the I2C scan and the calibration values are saved with
+     * a checksum through the storage function after a normal begin(). Later calls load them and
+     * only read the chip id to check that the device still answers at that address, so neither
+     * the scan nor the calibration read are repeated. If the data is missing or invalid, was
+     * stored for another address or the chip id doesn't match a normal begin() is done and the
+     * data is saved again
+     * @param[in] storage Function which loads and saves the data, see BME280_StorageCallback
+     * @param[in] i2cSpeed I2C speed, see begin()
+     * @param[in] address I2C address of the device, 0 to use the stored address or scan the bus
+     * @return    returns "true" when the class initialized correctly
+     */
+    BME280_WarmStart data;  // Data kept across power cycles
+    if (loadWarmStart(storage, data) && (address == 0 || data.address == address) &&
+        _bus.resume(data.address, i2cSpeed) && resumeWarmStart(data))
+      return true;  // Stored device is still there
+    if (!(address ? begin(i2cSpeed, address) : begin(i2cSpeed))) return false;
+    saveWarmStart(storage);
+    return true;
+  }  // of method begin()
+  bool begin(BME280_StorageCallback storage, const uint8_t chipSelect) {
+    /*!
+     * @brief     Begin method for hardware SPI with a warm start, see begin() for I2C
+     * @param[in] storage Function which loads and saves the data, see BME280_StorageCallback
+     * @param[in] chipSelect Chip select pin
+     * @return    returns "true" when the class initialized correctly
+     */
+    BME280_WarmStart data;  // Data kept across power cycles
+    if (loadWarmStart(storage, data) && _bus.resume(data.address, chipSelect) &&
+        resumeWarmStart(data))
+      return true;  // Stored device is still there
+    if (!begin(chipSelect)) return false;
+    saveWarmStart(storage);
+    return true;
+  }  // of method begin()
+  bool begin(BME280_StorageCallback storage, const uint8_t chipSelect, const uint8_t mosi,
+             const uint8_t miso, const uint8_t sck) {
+    /*!
+     * @brief     Begin method for software SPI with a warm start, see begin() for I2C
+     * @param[in] storage Function which loads and saves the data, see BME280_StorageCallback
+     * @param[in] chipSelect Chip select pin
+     * @param[in] mosi Master-Out Slave-In pin
+     * @param[in] miso Master-In Slave-Out pin
+     * @param[in] sck  System Clock
+     * @return    returns "true" when the class initialized correctly
+     */
+    BME280_WarmStart data;  // Data kept across power cycles
+    if (loadWarmStart(storage, data) && _bus.resume(data.address, chipSelect, mosi, miso, sck) &&
+        resumeWarmStart(data))
+      return true;  // Stored device is still there
+    if (!begin(chipSelect, mosi, miso, sck)) return false;
+    saveWarmStart(storage);
+    return true;
+  }  // of method begin()
+  /*! Other parameter types after a storage function are rejected at compile time instead of
+   * being passed on to the bus policy, e.g. an "int" literal could mean an I2C speed or a pin.
+   * Use a uint32_t speed or uint8_t pins as declared above */
+  template <typename... Args>
+  bool begin(BME280_StorageCallback storage, Args... args) = delete;
+  uint8_t mode(const uint8_t operatingMode = UINT8_MAX) {
+    /*!
+     * @brief     sets the current mode bits or returns the current value if the parameter isn't
+     * used
+     * @details The current mode is taken from the register copy. A forced mode write is always sent
+     * as it triggers a measurement, other modes are only written when they change
+     * @param[in] operatingMode Device operating mode to set
+     * @return    new mode
+     */
+    if (operatingMode == UINT8_MAX)
+      return (BME280_ModeField::extract(_regControl));  // Return setting if no parameter
+    writeMode(operatingMode);
+    return (_mode);
+  }  // of method mode()
+  bool setOversampling(const uint8_t sensor, const uint8_t sampling) {
+    /*!
+     * @brief     sets the oversampling mode for the sensor
+     * @details   see enumerated sensorTypes for list of values. Set to a valid oversampling rate as
+     * defined in the enumerated type oversamplingTypes. If either value is out of range or another
+     * error occurs then the return value is false. If a register write fails the copy of the
+     * settings is left unchanged
+     * @param[in] sensor Which sensor to set
+     * @param[in] sampling Sampling rate
+     * @return    returns "false" if a value is out of range or a register write failed
+     */
+    if (sensor >= UnknownSensor || sampling >= UnknownOversample)
+      return (false);                       // return error if out of range
+    uint8_t controlHumid = _regControlHumid;  // Start with the current register values
+    uint8_t control      = _regControl;
+    if (sensor == HumiditySensor)  // If we have a humidity setting
+    {
+      controlHumid = BME280_HumiditySamplingField::insert(controlHumid, sampling);
+    } else if (sensor == TemperatureSensor)  // otherwise if we have temperature
+    {
+      control = BME280_TemperatureSamplingField::insert(control, sampling);
+    } else {
+      control = BME280_PressureSamplingField::insert(control, sampling);
+    }  // of if-then-else temperature reading
+    if (controlHumid == _regControlHumid && control == _regControl) return (true);  // No change
+    uint8_t previousHumid = _regControlHumid;  // ctrl_hum isn't used until ctrl_meas is written
+    if (!goToSleep() || !updateRegister(BME280_CONTROLHUMID_REG, _regControlHumid, controlHumid) ||
+        putData(BME280_CONTROL_REG, control) == 0) {  // Always write, ctrl_hum applies after this
+      _regControlHumid = previousHumid;
+      return (false);
+    }  // of if-then a write failed
+    _regControl = control;
+    return (true);
+  }  // of method setOversampling()
+  uint8_t getOversampling(const uint8_t sensor, const bool actual = false) {
+    /*!
+     * @brief     retrieves the oversampling value for the sensor
+     * @details   see enumerated sensorTypes for list of values. The value is taken from the copy
+     * of the control registers, so no bus access is made
+     * @param[in] sensor Which sensor to retrieve
+     * @param[in] actual return the actual value if set, otherwise return the raw value
+     * @return    return value
+     */
+    uint8_t returnValue;                      // Get space for return value
+    if (sensor >= UnknownSensor) return (0);  // return a zero if out of range
+    if (sensor == HumiditySensor)             // If we have a humidity setting, use the buffer bits
+      returnValue = BME280_HumiditySamplingField::extract(_regControlHumid);
+    else if (sensor == TemperatureSensor)  // otherwise if we have temperature
+      returnValue = BME280_TemperatureSamplingField::extract(_regControl);
+    else
+      returnValue = BME280_PressureSamplingField::extract(_regControl);
+    if (actual)  // If the actual flag has been set then return the oversampling
+    {
+      if (returnValue == 3)
+        returnValue = 4;
+      else if (returnValue == 4)
+        returnValue = 8;
+      else if (returnValue > 4)
+        returnValue = 16;
+    }                      // of if-then we return the actual count
+    return (returnValue);  // return oversampling bits
+  }                        // of method getOversampling()
+  uint8_t iirFilter(const uint8_t iirFilterSetting = UINT8_MAX) {
+    /*!
+     * @brief     Set iir filter
+     * @details   when called with no parameters returns the current IIR Filter setting, otherwise
+     * when called with one parameter will set the IIR filter value and return the new setting
+     * @param[in] iirFilterSetting Set iir
+     * @return    Inactive time time
+     */
+    if (iirFilterSetting != UINT8_MAX)  // If we have a specified value
+    {
+      writeField<BME280_IIRFilterField>(iirFilterSetting);
+    }  // of if-then we have specified a new setting
+    return (BME280_IIRFilterField::extract(_regConfig));  // Return IIR Filter setting
+  }  // of method iirFilter()
+  uint8_t inactiveTime(const uint8_t inactiveTimeSetting = UINT8_MAX) {
+    /*!
+     * @brief     Return the inactive time setting
+     * @details   when called with no parameters returns the current inactive time setting,
+     * otherwise uses the parameter to set the inactive time
+     * @param[in] inactiveTimeSetting
+     * @return    inactive time setting
+     */
+    if (inactiveTimeSetting != UINT8_MAX)  // If we have a specified value
+    {
+      writeField<BME280_InactiveTimeField>(inactiveTimeSetting);
+    }  // of if-then we have specified a new setting
+    return (BME280_InactiveTimeField::extract(_regConfig));  // Return inactive time setting
+  }  // of method inactiveTime()
+  template <typename Field>
+  bool set(const typename Field::type value) {
+    /*!
+     * @brief     sets a register field, e.g. set<BME280_IIRFilterField>(IIR16)
+     * @details   Only values of the field's enumerated type compile. The value is masked to the
+     * field width and written with a single mask-and-or of the register copy, the register is only
+     * written if it changes. A humidity oversampling change is followed by a ctrl_meas write, which
+     * the device needs to use it, and the mode field behaves like mode()
+     * @param[in] value New field value
+     * @return    returns "false" if a write failed, the register copy is then unchanged
+     */
+    static_assert(Field::address == BME280_CONTROLHUMID_REG ||
+                      Field::address == BME280_CONTROL_REG || Field::address == BME280_CONFIG_REG,
+                  "Only ctrl_hum, ctrl_meas and config fields can be set");
+    if ((uint8_t)Field::address == (uint8_t)BME280_ModeField::address &&
+        (uint8_t)Field::mask == (uint8_t)BME280_ModeField::mask)
+      return (writeMode(value));  // Forced mode always triggers a measurement
+    bool returnValue = writeField<Field>(value);
+    if (Field::address == BME280_CONTROLHUMID_REG)  // ctrl_hum applies after a ctrl_meas write
+      returnValue = putData(BME280_CONTROL_REG, _regControl) != 0 && returnValue;
+    return (returnValue);
+  }  // of method set()
+  template <typename Field, typename Field::type Value>
+  bool set() {
+    /*!
+     * @brief     sets a register field to a value checked at compile time
+     * @details   e.g. set<BME280_InactiveTimeField, inactive20ms>(), a value outside of the field's
+     * range such as UnknownInactive stops the compile
+     * @return    returns "false" if a write failed, see set(value)
+     */
+    static_assert((uint8_t)Value < (uint8_t)Field::limit,
+                  "Value is out of range for this register field");
+    return (set<Field>(Value));
+  }  // of method set()
+  template <typename Field>
+  typename Field::type get() {
+    /*!
+     * @brief     returns a register field from the register copy, e.g. get<BME280_ModeField>()
+     * @return    Field value
+     */
+    static_assert(Field::address == BME280_CONTROLHUMID_REG ||
+                      Field::address == BME280_CONTROL_REG || Field::address == BME280_CONFIG_REG,
+                  "Only ctrl_hum, ctrl_meas and config fields have a copy");
+    return ((typename Field::type)Field::extract(shadowRegister(Field::address)));
+  }  // of method get()
+  uint32_t measurementTime(const uint8_t measureTimeSetting = 1) {
+    /*!
+     * @brief     returns the time in microseconds for a measurement cycle with the current settings
+     * @details   A cycle includes a temperature, pressure and humidity reading plus the wait time
+     * @param[in] measureTimeSetting
+     * @return    measurement cycle time
+     */
+    uint32_t returnValue = inactiveTime();  // Get inactive time value
+    switch (returnValue)                    // Set inactive time according to
+    {
+      case inactiveHalf:
+        returnValue = 500;
+        break;
+      case inactive63ms:
+        returnValue = 62500;
+        break;
+      case inactive125ms:
+        returnValue = 125000;
+        break;
+      case inactive250ms:
+        returnValue = 250000;
+        break;
+      case inactive500ms:
+        returnValue = 500000;
+        break;
+      case inactive1000ms:
+        returnValue = 1000000;
+        break;
+      case inactive10ms:
+        returnValue = 10000;
+        break;
+      case inactive20ms:
+        returnValue = 20000;
+        break;
+    }  // of switch for inactive time code
+    return (returnValue + conversionTime(measureTimeSetting));  // add the conversion time
+  }  // of method measurementTime()
+  uint32_t conversionTime(const uint8_t measureTimeSetting = 1) {
+    /*!
+     * @brief     returns the time in microseconds for one conversion with the current settings
+     * @details   This is the measurement cycle time without the inactive time, i.e. the time from
+     * triggering a forced measurement until the results are available. See section 9.1 of the
+     * datasheet for the typical and maximum timings
+     * @param[in] measureTimeSetting TypicalMeasure or MaximumMeasure
+     * @return    conversion time in microseconds
+     */
+    uint32_t Time1, Time2, returnValue;
+    if (measureTimeSetting != TypicalMeasure)  // Set timing factors for Typ / Max
+    {
+      returnValue = 1250;
+      Time1       = 2300;
+      Time2       = 575;
+    } else {
+      returnValue = 1000;
+      Time1       = 2000;
+      Time2       = 500;
+    }  // of if-then-else typical time or maximum time
+    if (getOversampling(TemperatureSensor))
+      returnValue += Time1 * getOversampling(TemperatureSensor, true);
+    if (getOversampling(PressureSensor))
+      returnValue += (Time1 * getOversampling(PressureSensor, true)) + Time2;
+    if (getOversampling(HumiditySensor))
+      returnValue += (Time1 * getOversampling(HumiditySensor, true)) + Time2;
+    return (returnValue);
+  }  // of method conversionTime()
+  bool startMeasurement() {
+    /*!
+     * @brief     starts a measurement without waiting for it to complete
+     * @details   Unless the device is in normal mode, where it converts continuously, a forced
+     * conversion is triggered. The typical conversion time is noted so that isReady() doesn't
+     * access the bus at all until the conversion can have completed. Use isReady() and
+     * fetchResult() to retrieve the readings while the program does other work
+     * @return    returns "true" if a measurement was started, "false" if one is still pending
+     */
+    if (_measurePending && !isReady()) return false;  // Previous measurement still running
+    if (mode() != NormalMode) mode(ForcedMode);      // Trigger a conversion
+    _measureWait    = conversionTime(TypicalMeasure);  // Don't check status before this
+    _measureStart   = _bus.micros();                   // Note when the conversion started
+    _measurePending = true;
+    _measureFailed  = false;
+    return true;
+  }  // of method startMeasurement()
+  bool isReady() {
+    /*!
+     * @brief     returns whether the measurement started with startMeasurement() has completed
+     * @details   No bus access is made until the typical conversion time has elapsed, after that
+     * each call reads the status register once. If the device is still busy after the maximum
+     * conversion time the measurement has failed, the device is recovered with recover() and
+     * fetchResult() returns "false"
+     * @return    returns "true" when the measurement has completed or failed
+     */
+    if (!_measurePending) return true;                               // Nothing outstanding
+    if (_bus.micros() - _measureStart < _measureWait) return false;  // Can't have finished yet
+    if ((readStatus() & BME280_STATUS_BUSY) != 0) {                  // Still measuring
+      if (_bus.micros() - _measureStart < timeout()) return false;   // but still in time
+      _measurePending = false;
+      _measureFailed  = true;
+      fail(TimeoutError);
+      recover();
+      return true;
+    }  // of if-then still measuring
+    conversionDone();
+    _measurePending = false;
+#ifdef BME280_STATISTICS
+    countSample(_bus.micros() - _measureStart);
+#endif
+    return true;
+  }  // of method isReady()
+  bool fetchResult(int32_t &temp, int32_t &hum, int32_t &press) {
+    /*!
+     * @brief      returns the readings of the measurement started with startMeasurement()
+     * @details    The parameters are left unchanged if the measurement hasn't completed yet or has
+     * failed, in which case lastError() returns the reason
+     * @param[out] temp  temperature value from device
+     * @param[out] hum   humidity value from device
+     * @param[out] press pressure value from device
+     * @return     returns "true" if the readings were returned, "false" if still measuring
+     */
+    if (!isReady() || _measureFailed) return false;  // Measurement hasn't completed
+    uint8_t registerBuffer[8];                       // Storage for raw readings
+    if (!readResult(registerBuffer)) return false;   // read all 8 bytes in one go
+#ifdef BME280_STATISTICS
+    _stats.compensations++;
+#endif
+    compensate(registerBuffer);                      // Convert to temperature etc.
+    temp  = _Temperature;                            // Copy global variable to parameter
+    hum   = _Humidity;
+    press = _Pressure;
+    return true;
+  }  // of method fetchResult()
+  bool fetchRawResult(BME280_RawSample &raw) {
+    /*!
+     * @brief      returns the uncompensated readings of the measurement started with
+     * startMeasurement()
+     * @details    The 8 measurement bytes are returned as read, the conversion can be done later
+     * or elsewhere with compensate(). The parameter is left unchanged if the measurement hasn't
+     * completed yet
+     * @param[out] raw Measurement registers 0xF7-0xFE
+     * @return     returns "true" if the readings were returned, "false" if still measuring
+     */
+    if (!isReady() || _measureFailed) return false;  // Measurement hasn't completed
+    return (readResult(raw.data));                   // read all 8 bytes in one go
+  }  // of method fetchRawResult()
+  bool getRawData(BME280_RawSample &raw) {
+    /*!
+     * @brief      returns the most recent uncompensated readings
+     * @details    This is getSensorData() without the conversion, which uses 64-bit arithmetic
+     * and is slow on 8-bit processors. Collected samples can be converted in one go with
+     * compensate(), either later on this device or on the computer receiving them together with
+     * the calibration() values
+     * @param[out] raw Measurement registers 0xF7-0xFE
+     * @return     returns "false" if the readings couldn't be read, see lastError()
+     */
+    return (readRawData(raw.data));
+  }  // of method getRawData()
+  void startStreaming(BME280_StreamCallback callback = nullptr) {
+    /*!
+     * @brief     puts the device into normal mode and starts delivering new samples via stream()
+     * @details   In normal mode the device converts continuously, one cycle taking
+     * measurementTime(TypicalMeasure). stream() uses that period to decide when the next sample
+     * can be ready so that the bus isn't accessed on most calls. Around that time the status is
+     * checked at least twice per inactive time, so stream() has to be called at least that often
+     * to see the device between its conversions
+     * @param[in] callback Optional function called with each new sample, which can e.g. push it
+     * into a BME280_SampleRing
+     */
+    mode(NormalMode);                                   // Convert continuously
+    _streamCallback = callback;                         // Store the function to call
+    _streamPeriod   = measurementTime(TypicalMeasure);  // Time between conversions
+    _streamNext     = _bus.micros();                    // Check for a sample straight away
+    _streamLast     = _streamNext;                      // Time of the last sample
+    _streamTimeout  = 2 * measurementTime(MaximumMeasure) + BME280_STARTUP_TIME * 1000UL;
+    _streamPoll     = (_streamPeriod - conversionTime(TypicalMeasure)) / 2;
+    _streamValid    = false;  // No previous sample to compare with
+    _streamMeasured = false;  // No measuring phase seen yet
+    _streaming      = true;
+    if (_streamPoll > _streamPeriod / 16) _streamPoll = _streamPeriod / 16;  // Half inactive time
+  }  // of method startStreaming()
+  void stopStreaming() {
+    /*!
+     * @brief     stops delivering samples, the device is left in normal mode
+     */
+    _streaming = false;
+  }  // of method stopStreaming()
+  bool stream() {
+    /*!
+     * @brief     checks for a new sample while streaming, see stream(BME280_Reading&)
+     * @return    returns "true" when a new sample was read
+     */
+    BME280_Reading reading;
+    return (stream(reading));
+  }  // of method stream()
+  bool stream(BME280_Reading &reading) {
+    /*!
+     * @brief      checks for a new sample while streaming and returns it
+     * @details    Call this often, e.g. from loop() or a timer tick outside of interrupt context.
+     * Until the next conversion can have completed the call returns without using the bus. After
+     * that the status register is checked: data isn't read while the device is measuring or
+     * copying its NVM, and a sample is new once a measuring phase has been seen or a whole
+     * conversion period has passed since the last sample. Readings which don't change are still
+     * new samples, the raw readings are only compared with the previous sample to skip the
+     * compensation and return the same values again. Each new sample is returned and passed to
+     * the callback function. If the device stays busy or can't be read for two maximum
+     * measurement cycles it is checked and, if necessary, recovered
+     * @param[out] reading The new sample, unchanged if there is none
+     * @return     returns "true" when a new sample was read
+     */
+    if (!_streaming) return false;                       // Not streaming
+    uint32_t now = _bus.micros();                        // Current time
+    if ((int32_t)(now - _streamNext) < 0) return false;  // Next sample not due yet
+    _streamNext = now + _streamPoll;                     // Look again shortly if there's no sample
+    uint8_t registerBuffer[BME280_RAW_DATA_LENGTH];      // Storage for raw readings
+    if ((readStatus() & BME280_STATUS_BUSY) != 0) {      // Still converting or copying the NVM
+      _streamMeasured = true;                            // Registers are updated when it's done
+      if (now - _streamLast > _streamTimeout) streamStalled();
+      return false;
+    }  // of if-then device busy
+    if (!_streamMeasured && now - _streamLast < _streamPeriod)
+      return false;  // No conversion can have completed since the last sample
+    if (getData(BME280_PRESSUREDATA_REG, registerBuffer) != sizeof(registerBuffer)) {
+      if (now - _streamLast > _streamTimeout) streamStalled();
+      return false;
+    }  // of if-then read failed
+    if (settingsLost(registerBuffer)) {  // Device has been reset and is back in sleep mode
+      recover();
+      return false;
+    }  // of if-then device lost its settings
+    _streamMeasured = false;
+    _streamLast     = now;
+    _streamNext     = now + _streamPeriod - _streamPeriod / 16;  // Just before the next sample
+    if (!_streamValid || memcmp(registerBuffer, _streamRaw, sizeof(_streamRaw)) != 0) {
+      memcpy(_streamRaw, registerBuffer, sizeof(_streamRaw));  // Remember for the next comparison
+#ifdef BME280_STATISTICS
+      _stats.compensations++;
+#endif
+      convert(registerBuffer, _streamReading);                 // Only compensate changed readings
+      _streamValid = true;
+    }  // of if-then readings changed
+    reading = _streamReading;
+    if (_streamCallback) _streamCallback(_bus.millis(), reading);
+    return true;
+  }  // of method stream()
+  void setThreshold(const uint8_t sensor, const uint16_t deadband, const uint16_t hysteresis = 0) {
+    /*!
+     * @brief     sets the change of one channel which report() treats as significant
+     * @details   A value is reported when it differs from the last reported value by more than the
+     * deadband. When the change is in the opposite direction to the previous one it also has to
+     * exceed the hysteresis, so noise around a threshold doesn't cause a report for every sample
+     * @param[in] sensor TemperatureSensor, HumiditySensor or PressureSensor
+     * @param[in] deadband Largest change not reported, in the units of getSensorData()
+     * @param[in] hysteresis Additional change needed when the direction reverses
+     */
+    if (sensor >= UnknownSensor) return;
+    _reportDeadband[sensor]   = deadband;
+    _reportHysteresis[sensor] = hysteresis;
+  }  // of method setThreshold()
+  void setQuietInterval(const uint32_t interval) {
+    /*!
+     * @brief     sets the longest time report() goes without reporting
+     * @param[in] interval Milliseconds after which all values are reported even if unchanged, 0
+     * to only report changes
+     */
+    _reportInterval = interval;
+  }  // of method setQuietInterval()
+  uint8_t report(BME280_Reading &reading) {
+    /*!
+     * @brief      reads the sensor and returns the readings only if they have changed significantly
+     * @details    The raw readings are compared with those of the previous call first, if they are
+     * identical the readings aren't compensated at all. Otherwise each value is compared with
+     * the last reported one using the thresholds set with setThreshold(), by default any change
+     * is reported. All values are reported on the first call and when nothing has been reported
+     * for the interval set with setQuietInterval()
+     * @param[out] reading All current readings, unchanged if nothing is reported
+     * @return     Channels which changed, a combination of channelTypes values. AllChannels when
+     * the quiet interval has passed and 0 if nothing is reported or the readings couldn't be read
+     */
+    uint8_t registerBuffer[BME280_RAW_DATA_LENGTH];  // Storage for raw readings
+    if (!readRawData(registerBuffer)) return (0);    // Reading failed, see lastError()
+    uint32_t now   = _bus.millis();                  // Current time
+    bool     quiet = !_reportValid ||                // Report everything the first time and
+                 (_reportInterval != 0 && now - _reportTime >= _reportInterval);  // when quiet
+    if (!quiet && memcmp(registerBuffer, _reportRaw, sizeof(_reportRaw)) == 0)
+      return (0);                                            // Same raw readings as last time
+    memcpy(_reportRaw, registerBuffer, sizeof(_reportRaw));  // Remember for the next comparison
+    BME280_Reading current;
+#ifdef BME280_STATISTICS
+    _stats.compensations++;
+#endif
+    convert(registerBuffer, current);  // Only now compensate the sample
+    const int32_t values[UnknownSensor] = {current.temperature, current.humidity, current.pressure};
+    uint8_t       channels              = quiet ? AllChannels : 0;  // Channels to report
+    for (uint8_t sensor = 0; sensor < UnknownSensor; sensor++) {
+      int32_t  change    = values[sensor] - _reportValue[sensor];
+      int8_t   direction = (change < 0) ? -1 : 1;
+      uint32_t threshold = _reportDeadband[sensor];
+      if (_reportDirection[sensor] == -direction) threshold += _reportHysteresis[sensor];
+      if ((uint32_t)(change < 0 ? -change : change) > threshold) {
+        channels |= 1 << sensor;
+        _reportDirection[sensor] = direction;
+      }  // of if-then significant change
+      if (channels & (1 << sensor)) _reportValue[sensor] = values[sensor];
+    }  // of for-next each sensor
+    if (channels == 0) return (0);  // No significant change
+    _reportValid = true;
+    _reportTime  = now;
+    reading      = current;
+    return (channels);
+  }  // of method report()
+  bool getSensorData(int32_t &temp, int32_t &hum, int32_t &press) {
+    /*!
+     * @brief      returns the most recent temperature, humidity and pressure readings
+     * @details    If the readings can't be read, even after recovering the device, the previous
+     * readings are returned
+     * @param[out] temp  temperature value from device
+     * @param[out] hum   humidity value from device
+     * @param[out] press pressure value from device
+     * @return     returns "false" if the readings couldn't be read, see lastError()
+     */
+    bool returnValue = readSensors();  // Get compensated data from BME280
+    temp             = _Temperature;   // Copy global variable to parameter
+    hum              = _Humidity;
+    press            = _Pressure;
+    return (returnValue);
+  }  // of method getSensorData()
+  uint8_t getSensorData(const uint8_t channels, int32_t &temp, int32_t &hum, int32_t &press) {
+    /*!
+     * @brief      returns the most recent readings of selected channels only
+     * @details    Only the registers of the requested channels are read, in the shortest burst
+     * which covers them, and only their compensation is done. The temperature registers are
+     * always read as the pressure and humidity formulas need the temperature. Channels which are
+     * switched off with SensorOff are skipped, the values of skipped channels are left unchanged
+     * @param[in]  channels Combination of TemperatureChannel, HumidityChannel and PressureChannel
+     * @param[out] temp  temperature value from device
+     * @param[out] hum   humidity value from device
+     * @param[out] press pressure value from device
+     * @return     The channels which were actually returned, 0 if the reading failed
+     */
+    uint8_t active = channels & activeChannels();  // Skip channels which are switched off
+    if (active == 0) return (0);                   // Nothing to read
+    uint8_t first = BME280_TEMPDATA_REG;           // Temperature is always needed
+    uint8_t last  = BME280_TEMPDATA_REG + 2;
+    if (active & PressureChannel) first = BME280_PRESSUREDATA_REG;
+    if (active & HumidityChannel) last = BME280_HUMIDDATA_REG + 1;
+    uint8_t registerBuffer[BME280_RAW_DATA_LENGTH];        // Storage for raw readings
+    if (!readRawData(registerBuffer, first, last - first + 1)) return (0);  // Shortest burst
+    BME280_Reading reading;
+#ifdef BME280_STATISTICS
+    _stats.compensations++;
+#endif
+    convert(registerBuffer, reading, active);  // Only compensate what is needed
+    if (active & TemperatureChannel) temp = reading.temperature;
+    if (active & HumidityChannel) hum = reading.humidity;
+    if (active & PressureChannel) press = reading.pressure;
+    return (active);
+  }  // of method getSensorData()
+  uint8_t activeChannels() {
+    /*!
+     * @brief     returns which channels are measured with the current oversampling settings
+     * @return    Combination of TemperatureChannel, HumidityChannel and PressureChannel
+     */
+    uint8_t channels = 0;
+    for (uint8_t sensor = 0; sensor < UnknownSensor; sensor++)
+      if (getOversampling(sensor) != SensorOff) channels |= 1 << sensor;
+    return (channels);
+  }  // of method activeChannels()
+  bool reset() {
+    /*!
+     * @brief      performs a device reset, as if it were powered down and back up again
+     * @details    The bus keeps its settings, so after the device has finished its 2ms start-up
+     * time only the chip id and calibration values need to be read again. All settings are back
+     * at their power-on values, recover() resets the device and restores them
+     * @return     returns "true" if the device answered with the chip id and the calibration
+     * values read by begin(). If the calibration registers differ the values read by begin() are
+     * kept and lastError() returns CalibrationError
+     */
+    putData(BME280_SOFTRESET_REG, BME280_SOFTWARE_CODE);  // writing code here resets device
+    _bus.delay(BME280_STARTUP_TIME);                      // Wait for device start-up time
+    _regControlHumid = _regControl = _regConfig = 0;  // Registers are back at power-on values
+    _measurePending = _streamValid = false;           // Pending readings are lost
+    if (readByte(BME280_CHIPID_REG) != BME280_CHIPID) return fail(ChipIdError);
+    BME280_CalibrationRegisters regs;          // Raw image of both calibration blocks
+    if (!readCalibration(regs)) return false;  // Read both blocks
+    if (crc8((const uint8_t *)&regs, sizeof(regs)) != _calibrationCrc)
+      return fail(CalibrationError);  // Keep the calibration values read by begin()
+    decodeCalibration(regs);          // Same registers, reload the values
+    return true;
+  }  // of method reset()
+  bool recover() {
+    /*!
+     * @brief      resets the device and restores the current settings
+     * @details    This is done automatically when a reading fails, i.e. when the device is still
+     * measuring after the maximum conversion time, a transfer fails or the device has lost its
+     * settings. The settings are always written back, even if the reset fails, so that a later
+     * recovery restores the same settings. Streaming continues with the restored settings
+     * @return     returns "true" if the device was reset and has the restored settings
+     */
+    uint8_t controlHumid = _regControlHumid;  // Settings to restore
+    uint8_t control      = _regControl;
+    uint8_t config       = _regConfig;
+    bool    returnValue  = reset();
+    _regControlHumid     = controlHumid;  // ctrl_hum, config and ctrl_meas in that order, as
+    _regConfig           = config;        // the device is in sleep mode after the reset and
+    _regControl          = control;       // ctrl_hum only applies after a ctrl_meas write
+    putData(BME280_CONTROLHUMID_REG, controlHumid);
+    putData(BME280_CONFIG_REG, config);
+    putData(BME280_CONTROL_REG, control);
+    if (_streaming) _streamLast = _bus.micros();  // Give streaming a full timeout to restart
+    return (returnValue && checkHealth());
+  }  // of method recover()
+  bool checkHealth() {
+    /*!
+     * @brief      checks that the device still answers correctly and has kept its settings
+     * @details    The chip id, a CRC-8 of the calibration registers and the control and
+     * configuration registers are read and compared with the values expected. The mode bits aren't
+     * compared as the device returns to sleep mode after each forced measurement
+     * @return     returns "true" if everything matches, otherwise lastError() returns the reason
+     */
+    if (readByte(BME280_CHIPID_REG) != BME280_CHIPID) return fail(ChipIdError);
+    BME280_CalibrationRegisters regs;  // Raw image of both calibration blocks
+    if (!readCalibration(regs)) return false;
+    if (crc8((const uint8_t *)&regs, sizeof(regs)) != _calibrationCrc)
+      return fail(CalibrationError);
+    uint8_t registers[4];  // 0xF2-0xF5, includes the status register
+    if (getData(BME280_CONTROLHUMID_REG, registers) != sizeof(registers)) return false;
+    if (registers[0] != _regControlHumid ||
+        BME280_ModeField::insert(registers[BME280_CONTROL_REG - BME280_CONTROLHUMID_REG], 0) !=
+            BME280_ModeField::insert(_regControl, 0) ||
+        registers[BME280_CONFIG_REG - BME280_CONTROLHUMID_REG] != _regConfig)
+      return fail(DeviceResetError);
+    return true;
+  }  // of method checkHealth()
+  uint8_t lastError() {
+    /*!
+     * @brief      returns the first error since the last call and clears it
+     * @details    Transfer errors are noted by every bus access, the other errors by the
+     * measurement methods, reset(), recover() and checkHealth()
+     * @return     see errorTypes, NoError if there was no error
+     */
+    uint8_t returnValue = _error;
+    _error              = NoError;
+    return (returnValue);
+  }  // of method lastError()
+  bool apply(const BME280_Config &config) {
+    /*!
+     * @brief     writes a complete set of settings to the device
+     * @details   All values are checked before anything is written. The device is put into sleep
+     * mode once, then ctrl_hum, config and ctrl_meas are written in that order, since config
+     * writes may be ignored outside of sleep mode and ctrl_hum only takes effect after a write to
+     * ctrl_meas. The final ctrl_meas write also sets the requested operating mode
+     * @param[in] config Settings to apply, e.g. one of the recommended BME280_* settings
+     * @return    returns "false" without changing anything if a value is out of range, "false" if
+     * a register write failed in which case the copies only hold the registers which were written
+     */
+    if (config.temperatureSampling >= UnknownOversample ||
+        config.pressureSampling >= UnknownOversample ||
+        config.humiditySampling >= UnknownOversample || config.iirFilter >= UnknownIIR ||
+        config.inactiveTime >= UnknownInactive || config.mode >= UnknownMode)
+      return (false);  // return error if out of range
+    uint8_t controlHumid =
+        BME280_HumiditySamplingField::insert(_regControlHumid, config.humiditySampling);
+    uint8_t configReg = BME280_InactiveTimeField::insert(
+        BME280_IIRFilterField::insert(_regConfig, config.iirFilter), config.inactiveTime);
+    uint8_t control = BME280_ModeField::insert(
+        BME280_PressureSamplingField::insert(
+            BME280_TemperatureSamplingField::insert(0, config.temperatureSampling),
+            config.pressureSampling),
+        config.mode);
+    if (!goToSleep() || !updateRegister(BME280_CONTROLHUMID_REG, _regControlHumid, controlHumid) ||
+        !updateRegister(BME280_CONFIG_REG, _regConfig, configReg) ||
+        putData(BME280_CONTROL_REG, control) == 0)  // Always write, ctrl_hum applies after this
+      return (false);
+    _regControl = control;
+    _mode       = config.mode;
+    return (true);
+  }  // of method apply()
+  BME280_Config getConfig() {
+    /*!
+     * @brief     returns the current settings
+     * @details   The settings are taken from the copy of the control registers, so no bus access
+     * is made. The mode is the last one set rather than the current device state, which returns
+     * to sleep mode after each forced measurement
+     * @return    current settings
+     */
+    BME280_Config config;
+    config.temperatureSampling = getOversampling(TemperatureSensor);
+    config.pressureSampling    = getOversampling(PressureSensor);
+    config.humiditySampling    = getOversampling(HumiditySensor);
+    config.iirFilter           = iirFilter();
+    config.inactiveTime        = inactiveTime();
+    config.mode                = (_mode == UINT8_MAX) ? mode() : _mode;
+    return (config);
+  }  // of method getConfig()
+  void syncFromDevice() {
+    /*!
+     * @brief      reloads the copies of the control and configuration registers from the device
+     * @details    All settings are served from a copy of registers 0xF2, 0xF4 and 0xF5 which is
+     * kept up to date by the setter methods. If the device has been reset or reconfigured by other
+     * means this method reads the registers again in a single burst
+     */
+    uint8_t registers[4];                            // 0xF2-0xF5, includes the status register
+    if (getData(BME280_CONTROLHUMID_REG, registers) != sizeof(registers))
+      return;                                        // Keep the copies if the read fails
+    _regControlHumid = registers[0];                 // 0xF2
+    _regControl      = registers[BME280_CONTROL_REG - BME280_CONTROLHUMID_REG];  // 0xF4
+    _regConfig       = registers[BME280_CONFIG_REG - BME280_CONTROLHUMID_REG];   // 0xF5
+  }  // of method syncFromDevice()
+  Bus &bus() {
+    /*!
+     * @brief      returns the bus policy instance used by this device
+     * @return     reference to the bus policy
+     */
+    return _bus;
+  }  // of method bus()
+  uint8_t readRegisters(const uint8_t addr, uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief      reads a block of consecutive registers in a single burst
+     * @param[in]  addr First register address
+     * @param[out] buffer Storage for the register contents
+     * @param[in]  length Number of registers to read
+     * @return     Number of bytes actually read, less than "length" if the bus read was cut short
+     */
+    uint8_t bytesRead = _bus.read(addr, buffer, length);
+    if (bytesRead != length) fail(bytesRead ? ShortReadError : BusError);
+#ifdef BME280_STATISTICS
+    countTransaction(length, bytesRead);
+#endif
+    return (bytesRead);
+  }  // of method readRegisters()
+  uint8_t writeRegisters(const uint8_t addr, const uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     writes a block of consecutive registers in a single transaction
+     * @details   The register copies used by the settings methods aren't updated, so call
+     * syncFromDevice() after writing to the control or configuration registers
+     * @param[in] addr First register address
+     * @param[in] buffer Register contents to write
+     * @param[in] length Number of registers to write
+     * @return    Number of bytes written, 0 if the bus reported an error
+     */
+    uint8_t bytesWritten = _bus.write(addr, buffer, length);
+    if (bytesWritten != length) fail(BusError);
+#ifdef BME280_STATISTICS
+    countTransaction(length, bytesWritten);
+#endif
+    return (bytesWritten);
+  }  // of method writeRegisters()
+#ifdef BME280_STATISTICS
+  const BME280_Statistics &statistics() const {
+    /*!
+     * @brief     returns the bus and timing statistics collected since the start or the last reset
+     * @details   Only available if BME280_STATISTICS is defined as a compiler option for all
+     * files, see BME280_Options.h, without it no code or memory is used for the statistics. The
+     * number of status polls per sample is statusPolls / samples, and the average measurement time
+     * is returned by averageLatency(). stream() and report() don't compensate unchanged raw
+     * readings, so compensations can be lower than samples
+     * @return    reference to the statistics
+     */
+    return (_stats);
+  }  // of method statistics()
+  uint32_t averageLatency() const {
+    /*!
+     * @brief     returns the average measurement time
+     * @return    microseconds from trigger to completion, 0 if there have been no measurements
+     */
+    return (_stats.samples ? (uint32_t)(_stats.totalLatency / _stats.samples) : 0);
+  }  // of method averageLatency()
+  void resetStatistics() {
+    /*!
+     * @brief     sets all statistics back to zero
+     */
+    _stats            = {};
+    _stats.minLatency = UINT32_MAX;  // So the first sample sets the minimum
+  }  // of method resetStatistics()
+#endif
 
  private:
-  uint8_t  readByte(const uint8_t addr);
-  void     readSensors();
-  void     getCalibration();
-  bool     _TransmissionStatus = false;  ///< I2C communications status
-  uint8_t  _I2CAddress         = 0;      ///< Default is no I2C address known
-  uint8_t  _cs, _sck, _mosi, _miso;      ///< Hardware and software SPI pins for SPI
-  uint8_t  _cal_dig_H1, _cal_dig_H3;     ///< Calibration variables
-  int8_t   _cal_dig_H6 = 0;              ///< Calibration variables
-  uint16_t _cal_dig_T1, _cal_dig_P1;     ///< Calibration variables
-  int16_t _cal_dig_T2, _cal_dig_T3, _cal_dig_P2, _cal_dig_P3, _cal_dig_P4, _cal_dig_P5, _cal_dig_P6,
-      _cal_dig_P7, _cal_dig_P8, _cal_dig_P9, _cal_dig_H2, _cal_dig_H4,
-      _cal_dig_H5;                                     ///< Calibration variables
-  uint8_t _mode = UINT8_MAX;                           ///< Last mode set
-  int32_t _tfine, _Temperature, _Pressure, _Humidity;  ///< Sensor global variables
+  Bus                   _bus;                     ///< Bus policy instance used for all I/O
+  bool                  _measurePending = false;  ///< Set by startMeasurement() until done
+  uint32_t              _measureStart   = 0;      ///< micros() value when measurement started
+  uint32_t              _measureWait    = 0;      ///< Microseconds before first status check
+  bool                  _measureFailed  = false;  ///< Set when the measurement timed out
+  BME280_StreamCallback _streamCallback = nullptr;  ///< Called by stream() for new samples
+  uint32_t              _streamPeriod   = 0;        ///< Microseconds between conversions
+  uint32_t              _streamPoll     = 0;        ///< Microseconds between status checks
+  uint32_t              _streamNext     = 0;        ///< micros() value of the next stream() read
+  uint32_t              _streamLast     = 0;        ///< micros() value of the last new sample
+  uint32_t              _streamTimeout  = 0;        ///< Microseconds without samples until check
+  uint8_t               _streamRaw[BME280_RAW_DATA_LENGTH];  ///< Raw readings of last sample
+  BME280_Reading        _streamReading  = {};     ///< Compensated readings of _streamRaw
+  bool                  _streamValid    = false;  ///< Set when _streamRaw holds a sample
+  bool                  _streamMeasured = false;  ///< Device was busy since the last sample
+  bool                  _streaming      = false;  ///< Set while streaming, see startStreaming()
+  uint8_t               _reportRaw[BME280_RAW_DATA_LENGTH];   ///< Raw readings of last report()
+  int32_t               _reportValue[UnknownSensor]      = {};  ///< Last reported values
+  int8_t                _reportDirection[UnknownSensor]  = {};  ///< Direction of the last change
+  uint16_t              _reportDeadband[UnknownSensor]   = {};  ///< Largest unreported change
+  uint16_t              _reportHysteresis[UnknownSensor] = {};  ///< Extra change to reverse
+  uint32_t              _reportInterval = 0;      ///< Longest time without a report in ms
+  uint32_t              _reportTime     = 0;      ///< millis() value of the last report
+  bool                  _reportValid    = false;  ///< Set after the first report
+  uint8_t               _calibrationCrc = 0;        ///< CRC-8 of the calibration registers
+  uint8_t               _error          = NoError;  ///< First error since lastError() was called
+#ifdef BME280_STATISTICS
+  BME280_Statistics _stats = {0, 0, 0, 0, 0, 0, UINT32_MAX, 0, 0};  ///< Bus and timing statistics
+  void countTransaction(const uint8_t requested, const uint8_t transferred) {
+    /*!
+     * @brief     adds a bus transfer to the statistics
+     * @param[in] requested Number of bytes requested
+     * @param[in] transferred Number of bytes actually transferred
+     */
+    _stats.transactions++;
+    _stats.bytes += transferred;
+    if (transferred != requested) _stats.errors++;
+  }  // of method countTransaction()
+  void countSample(const uint32_t latency) {
+    /*!
+     * @brief     adds a completed measurement to the statistics
+     * @param[in] latency Microseconds from trigger to completion
+     */
+    _stats.samples++;
+    _stats.totalLatency += latency;
+    if (latency < _stats.minLatency) _stats.minLatency = latency;
+    if (latency > _stats.maxLatency) _stats.maxLatency = latency;
+  }  // of method countSample()
+#endif
+  uint8_t readByte(const uint8_t addr) {
+    /*!
+     * @brief     interlude function to the getData() function. Reads 1 byte from the given address
+     * @param[in] addr Address to read data from
+     * @return    returns byte of data read
+     */
+    uint8_t returnValue = 0;     // Storage for returned value, 0 if the read fails
+    getData(addr, returnValue);  // Read just one byte
+    return (returnValue);        // Return byte just read
+  }                              // of method readByte()
+  uint8_t readStatus() {
+    /*!
+     * @brief     reads the status register, bit 3 is set while measuring and bit 0 while the
+     * calibration values are being copied
+     * @return    status register contents, both bits set if the register couldn't be read so that
+     * a failed transfer isn't taken as a completed measurement
+     */
+#ifdef BME280_STATISTICS
+    _stats.statusPolls++;
+#endif
+    uint8_t status = BME280_STATUS_BUSY;  // Storage for returned value, busy if the read fails
+    getData(BME280_STATUS_REG, status);
+    return (status);
+  }  // of method readStatus()
+  bool updateRegister(const uint8_t addr, uint8_t &shadow, const uint8_t value) {
+    /*!
+     * @brief     writes a register and its copy, but only if the value has changed
+     * @param[in] addr Register address
+     * @param[in,out] shadow Copy of the register contents, unchanged if the write fails
+     * @param[in] value New register value
+     * @return    returns "false" if the write failed
+     */
+    if (value == shadow) return true;             // Nothing to do
+    if (putData(addr, value) == 0) return false;  // Write the new value
+    shadow = value;                               // and remember it
+    return true;
+  }  // of method updateRegister()
+  uint8_t &shadowRegister(const uint8_t addr) {
+    /*!
+     * @brief     returns the copy of a control register, resolved at compile time for constants
+     * @param[in] addr BME280_CONTROLHUMID_REG, BME280_CONTROL_REG or BME280_CONFIG_REG
+     * @return    Reference to the register copy
+     */
+    if (addr == BME280_CONTROLHUMID_REG) return (_regControlHumid);
+    if (addr == BME280_CONFIG_REG) return (_regConfig);
+    return (_regControl);
+  }  // of method shadowRegister()
+  bool writeMode(const uint8_t operatingMode) {
+    /*!
+     * @brief     sets the mode bits, see mode()
+     * @param[in] operatingMode Device operating mode to set
+     * @return    returns "false" if the write failed
+     */
+    _mode = BME280_ModeField::extract(BME280_ModeField::insert(0, operatingMode));  // 2 bits only
+    uint8_t controlRegister = BME280_ModeField::insert(_regControl, _mode);  // set the new value
+    if (_mode == ForcedMode || _mode == ForcedMode2)  // Forced mode triggers a measurement, so
+    {                                                 // the register is always written
+      if (putData(BME280_CONTROL_REG, controlRegister) == 0) return false;
+      _regControl = controlRegister;
+      return true;
+    }  // of if-then forced mode
+    return (updateRegister(BME280_CONTROL_REG, _regControl, controlRegister));  // Write if changed
+  }  // of method writeMode()
+  template <typename Field>
+  bool writeField(const uint8_t value) {
+    /*!
+     * @brief     writes one field of a control register if it changes
+     * @param[in] value New field value, masked to the field width
+     * @return    returns "false" if the write failed
+     */
+    uint8_t &shadow = shadowRegister(Field::address);
+    return (updateRegister(Field::address, shadow, Field::insert(shadow, value)));
+  }  // of method writeField()
+  bool goToSleep() {
+    /*!
+     * @brief     puts the device into sleep mode, needed before changing the measurement settings
+     * @return    returns "false" if the write failed
+     */
+    return (updateRegister(BME280_CONTROL_REG, _regControl,
+                           BME280_ModeField::insert(_regControl, SleepMode)));
+  }  // of method goToSleep()
+  void conversionDone() {
+    /*!
+     * @brief     notes that a conversion has completed
+     * @details   In forced mode the device goes back to sleep mode after a conversion, so the copy
+     * of the control register is updated to match
+     */
+    if (BME280_ModeField::extract(_regControl) != NormalMode)
+      _regControl = BME280_ModeField::insert(_regControl, SleepMode);
+  }  // of method conversionDone()
+  bool loadWarmStart(BME280_StorageCallback storage, BME280_WarmStart &data) {
+    /*!
+     * @brief      loads the warm start data and checks it
+     * @param[in]  storage Function which loads and saves the data
+     * @param[out] data Warm start data
+     * @return     returns "true" if data was loaded and its checksum is correct
+     */
+    uint8_t *bytes = (uint8_t *)&data;  // Stored as bytes
+    return (storage(bytes, sizeof(data), false) &&
+            data.checksum == crc8(bytes + 1, sizeof(data) - 1));
+  }  // of method loadWarmStart()
+  bool resumeWarmStart(const BME280_WarmStart &data) {
+    /*!
+     * @brief     takes over the calibration values of the warm start data
+     * @param[in] data Warm start data, loaded and checked
+     * @return    returns "true" if the data was saved for this bus and the device on the resumed
+     * bus answers with the chip id
+     */
+    if (data.address != _bus.address()) return false;  // Saved for another bus, e.g. I2C for SPI
+    if (readByte(BME280_CHIPID_REG) != BME280_CHIPID) return false;  // Stored device has gone
+    _error          = NoError;
+    _calibrationCrc = data.calibrationCrc;
+    calibration(data.calibration);  // also prepares the compensation coefficients
+    syncFromDevice();               // get the current settings
+    return true;
+  }  // of method resumeWarmStart()
+  void saveWarmStart(BME280_StorageCallback storage) {
+    /*!
+     * @brief     saves the warm start data after a cold start
+     * @param[in] storage Function which loads and saves the data
+     */
+    BME280_WarmStart data;                      // Data kept across power cycles
+    uint8_t         *bytes = (uint8_t *)&data;  // Stored as bytes
+    memset(bytes, 0, sizeof(data));             // Clear the padding bytes for the checksum
+    data.address        = _bus.address();
+    data.calibrationCrc = _calibrationCrc;
+    data.calibration    = _cal;
+    data.checksum       = crc8(bytes + 1, sizeof(data) - 1);
+    storage(bytes, sizeof(data), true);
+  }  // of method saveWarmStart()
+  bool getCalibration() {
+    /*!
+     * @brief     reads the calibration register data into local variables for use in converting
+     * readings
+     * @details   The trimming values live in two contiguous blocks, 0x88-0xA1 and 0xE1-0xE7, so
+     * each block is read with a single burst transfer and all values are then decoded from that
+     * buffer. A checksum of the registers is kept for checkHealth()
+     * @return    returns "false" and keeps the previous values if the registers couldn't be read
+     */
+    BME280_CalibrationRegisters regs;          // Raw image of both calibration blocks
+    if (!readCalibration(regs)) return false;  // Read both blocks
+    decodeCalibration(regs);                   // Convert into calibration values
+    _calibrationCrc = crc8((const uint8_t *)&regs, sizeof(regs));
+    return true;
+  }  // of method getCalibration()
+  bool readCalibration(BME280_CalibrationRegisters &regs) {
+    /*!
+     * @brief      reads both calibration blocks
+     * @param[out] regs Raw image of both calibration blocks
+     * @return     returns "true" if all registers were read
+     */
+    return (getData(BME280_T1_REG, regs.tp) == sizeof(regs.tp) &&  // Read 0x88-0xA1 in one go
+            getData(BME280_H2_REG, regs.h) == sizeof(regs.h));     // Read 0xE1-0xE7 in one go
+  }  // of method readCalibration()
+  bool readRawData(uint8_t (&registerBuffer)[BME280_RAW_DATA_LENGTH],
+                   const uint8_t firstRegister = BME280_PRESSUREDATA_REG,
+                   const uint8_t length        = BME280_RAW_DATA_LENGTH) {
+    /*!
+     * @brief      reads the uncompensated sensor values from the registers
+     * @details    A forced measurement is triggered if necessary and, once it has completed, the
+     * readings are read in one operation. By default all 3 readings are read, a shorter burst
+     * can be requested in which case the bytes are stored at their usual position in the buffer.
+     * If the measurement fails the device is recovered and the measurement is repeated once
+     * @param[out] registerBuffer Measurement registers 0xF7-0xFE
+     * @param[in]  firstRegister First register to read
+     * @param[in]  length Number of registers to read
+     * @return     returns "false" if the readings couldn't be read, see lastError()
+     */
+    if (readMeasurement(registerBuffer, firstRegister, length)) return true;
+    return (recover() && readMeasurement(registerBuffer, firstRegister, length));
+  }  // of method readRawData()
+  bool readMeasurement(uint8_t (&registerBuffer)[BME280_RAW_DATA_LENGTH],
+                       const uint8_t firstRegister, const uint8_t length) {
+    /*!
+     * @brief      waits for a measurement and reads it, see readRawData()
+     * @details    The status register is polled for no longer than the maximum conversion time
+     * @param[out] registerBuffer Measurement registers 0xF7-0xFE
+     * @param[in]  firstRegister First register to read
+     * @param[in]  length Number of registers to read
+     * @return     returns "true" if a valid measurement was read
+     */
+    uint32_t startMicros = _bus.micros();  // Note when the measurement was requested
+    if ((_mode == ForcedMode || _mode == ForcedMode2) && mode() == SleepMode) {
+      mode(_mode);                             // Force a reading if necessary
+      if (mode() == SleepMode) return false;  // The write failed, see lastError()
+    }  // of if-then trigger a forced measurement
+    while ((readStatus() & BME280_STATUS_BUSY) != 0)
+      if (_bus.micros() - startMicros > timeout()) return fail(TimeoutError);  // Device is stuck
+    conversionDone();  // Device is back in sleep if forced
+    if (readRegisters(firstRegister, registerBuffer + (firstRegister - BME280_PRESSUREDATA_REG),
+                      length) != length)
+      return false;  // read the requested bytes in one go
+    if (settingsLost(registerBuffer, firstRegister, length)) return false;
+#ifdef BME280_STATISTICS
+    countSample(_bus.micros() - startMicros);
+#endif
+    return true;
+  }  // of method readMeasurement()
+  bool settingsLost(const uint8_t registerBuffer[BME280_RAW_DATA_LENGTH],
+                    const uint8_t firstRegister = BME280_PRESSUREDATA_REG,
+                    const uint8_t length        = BME280_RAW_DATA_LENGTH) {
+    /*!
+     * @brief     returns whether the readings show that the device has lost its settings
+     * @details   After a reset all measurement registers hold the value the device reports for a
+     * skipped measurement, 0x80000 or 0x8000. As that can also be a genuine reading or normal mode
+     * may not have completed its first conversion yet, checkHealth() decides when an enabled
+     * channel holds that value
+     * @param[in] registerBuffer Measurement registers 0xF7-0xFE
+     * @param[in] firstRegister First register read
+     * @param[in] length Number of registers read
+     * @return    returns "true" if the device has to be recovered
+     */
+    for (uint8_t sensor = 0; sensor < UnknownSensor; sensor++) {
+      uint8_t reg = (sensor == TemperatureSensor) ? BME280_TEMPDATA_REG
+                    : (sensor == HumiditySensor)  ? BME280_HUMIDDATA_REG
+                                                  : BME280_PRESSUREDATA_REG;
+      if (reg < firstRegister || reg + 1 >= firstRegister + length) continue;  // Wasn't read
+      const uint8_t *data = registerBuffer + (reg - BME280_PRESSUREDATA_REG);
+      if (data[0] == 0x80 && data[1] == 0 && getOversampling(sensor) != SensorOff)
+        return (!checkHealth());  // Skipped reading, check the device
+    }                             // of for-next each sensor
+    return false;
+  }  // of method settingsLost()
+  bool readSensors() {
+    /*!
+     * @brief     reads all 3 sensor values from the registers
+     * @details   Read all 3 in one operation and then convert the raw temperature, pressure and
+     * humidity readings into standard metric units
+     * @return    returns "false" and keeps the previous values if the readings couldn't be read
+     */
+    uint8_t registerBuffer[BME280_RAW_DATA_LENGTH];
+    if (!readRawData(registerBuffer)) return false;  // Get the raw readings
+#ifdef BME280_STATISTICS
+    _stats.compensations++;
+#endif
+    compensate(registerBuffer);                      // Convert to temperature etc.
+    return true;
+  }  // of method readSensors()
+  bool readResult(uint8_t (&registerBuffer)[BME280_RAW_DATA_LENGTH]) {
+    /*!
+     * @brief      reads the result of a completed startMeasurement()
+     * @details    If the device has lost its settings during the measurement it is recovered and
+     * the measurement counts as failed
+     * @param[out] registerBuffer Measurement registers 0xF7-0xFE
+     * @return     returns "true" if valid readings were read
+     */
+    if (getData(BME280_PRESSUREDATA_REG, registerBuffer) != sizeof(registerBuffer)) return false;
+    if (!settingsLost(registerBuffer)) return true;
+    _measureFailed = true;  // The readings are lost
+    recover();
+    return false;
+  }  // of method readResult()
+  void streamStalled() {
+    /*!
+     * @brief     handles a stream without new samples for two maximum measurement cycles
+     * @details   Only a status which stays busy or failing transfers stop the samples, a device
+     * which has been reset is found by settingsLost() on the next read. The device is recovered
+     * if it is still busy or fails checkHealth()
+     */
+    _streamLast = _bus.micros();  // Don't check again until the next timeout
+    if ((readStatus() & BME280_STATUS_BUSY) != 0)
+      fail(TimeoutError);            // Still measuring
+    else if (checkHealth()) return;  // Readings just haven't changed
+    recover();
+  }  // of method streamStalled()
+  uint32_t timeout() {
+    /*!
+     * @brief     returns the longest time a measurement can take, see readMeasurement()
+     * @return    maximum conversion time plus the start-up time in microseconds
+     */
+    return (conversionTime(MaximumMeasure) + BME280_STARTUP_TIME * 1000UL);
+  }  // of method timeout()
+  bool fail(const uint8_t error) {
+    /*!
+     * @brief     notes an error for lastError(), only the first error is kept until it is read
+     * @param[in] error see errorTypes
+     * @return    always "false", so that it can be returned directly
+     */
+    if (_error == NoError) _error = error;
+    return false;
+  }  // of method fail()
   /*********************************************************************************************
   ** Declare the getData and putData methods as template functions. All device I/O is done    **
-  ** through these two functions regardless of whether I2C, hardware SPI or software SPI is   **
-  ** being used. The two functions are designed so that only the address and a variable are   **
-  ** passed in and the functions determine the size of the parameter variable and reads or    **
-  ** writes that many bytes. So if a read is called using a character array[10] then 10 bytes **
-  ** are read, if called with a int8 then only one byte is read. The return value, if used,   **
-  ** is the number of bytes read or written. This is done by using template function          **
+  ** through these two functions which pass the request on to readRegisters() and             **
+  ** writeRegisters(). The two functions are designed so that only the address and a variable **
+  ** are passed in and the functions determine the size of the parameter variable and reads   **
+  ** or writes that many bytes. So if a read is called using a character array[10] then 10    **
+  ** bytes are read, if called with a int8 then only one byte is read. The return value, if   **
+  ** used, is the number of bytes read or written. This is done by using template function    **
   ** definitions which need to be defined in this header file rather than in the c++ program  **
   ** library file.                                                                            **
   *********************************************************************************************/
   template <typename T>
-  uint8_t &getData(const uint8_t addr, T &value) {
+  uint8_t getData(const uint8_t addr, T &value) {
     /*!
      * @brief     Template function for reading from the I2C or SPI bus
      * @details   As a template it supports compile-time data type definitions
      * @param[in] addr Memory address
      * @param[in] value Data Type "T" to read
-     * @return    Size of data read
+     * @return    Number of bytes actually read
      */
-
-    uint8_t *      bytePtr    = (uint8_t *)&value;  // Pointer to structure beginning
-    static uint8_t structSize = sizeof(T);          // Number of bytes in structure
-    if (_I2CAddress)  // If I2C address is non-zero then assume I2C bus
-    {
-      Wire.beginTransmission(_I2CAddress);           // Address the I2C device
-      Wire.write(addr);                              // Send register address to read
-      _TransmissionStatus = Wire.endTransmission();  // Close transmission
-      Wire.requestFrom(_I2CAddress, sizeof(T));      // Request 1 byte of data
-      structSize = Wire.available();                 // Use the actual number of bytes
-      for (uint8_t i = 0; i < structSize; i++)
-        *bytePtr++ = Wire.read();  // loop for each byte to be read
-    } else                         // Otherwise use SPI bus
-    {
-      if (_sck == 0)  // if sck is zero then hardware SPI
-      {
-        SPI.beginTransaction(
-            SPISettings(SPI_HERTZ, MSBFIRST, SPI_MODE0));  // Start the SPI transaction
-        digitalWrite(_cs, LOW);                            // Tell BME280 to listen up
-        SPI.transfer(addr | 0x80);                         // bit 7 is high, so read a byte
-        for (uint8_t i = 0; i < structSize; i++)
-          *bytePtr++ = SPI.transfer(0);  // loop for each byte to be read
-        digitalWrite(_cs, HIGH);         // Tell BME280 to stop listening
-        SPI.endTransaction();            // End the transaction
-      } else                             // otherwise we are using software SPI
-      {
-        int8_t  i, j;
-        uint8_t reply;
-        digitalWrite(_cs, LOW);                             // Tell BME280 to listen up
-        for (j = 7; j >= 0; j--) {                          // First send the address byte
-          digitalWrite(_sck, LOW);                          // set the clock signal
-          digitalWrite(_mosi, ((addr) | 0x80) & (1 << j));  // set the MOSI pin state
-          digitalWrite(_sck, HIGH);                         // reset the clock signal
-        }                                                   // of for-next each bit
-        for (i = 0; i < structSize; i++) {
-          reply = 0;                // reset our return byte
-          for (j = 7; j >= 0; j--)  // Now read the data at that byte
-          {
-            reply <<= 1;                         // shift buffer one bit left
-            digitalWrite(_sck, LOW);             // set and reset the clock signal
-            digitalWrite(_sck, HIGH);            // pin to get the next MISO bit
-            if (digitalRead(_miso)) reply |= 1;  // read the MISO bit, add to reply
-          }                                      // of for-next each bit
-          *bytePtr++ = reply;                    // Add byte just read to return data
-        }                                        // of for-next each byte to be read
-        digitalWrite(_cs, HIGH);                 // Tell BME280 to stop listening
-      }                                          // of  if-then-else we are using hardware SPI
-    }                                            // of if-then-else we are using I2C
-    return (structSize);                         // return the number of bytes read
-  }                                              // of method getData()
-
+    return (readRegisters(addr, (uint8_t *)&value, sizeof(T)));
+  }  // of method getData()
   template <typename T>
-  uint8_t &putData(const uint8_t addr, const T &value) {
+  uint8_t putData(const uint8_t addr, const T &value) {
     /*!
      * @brief     Template for writing to the I2C or SPI bus
      * @details   As a template it can support compile-time data type definitions
      * @param[in] addr Memory address
-     * @param[in] value Data Type "T" to read
-     * @return    Size of data written
+     * @param[in] value Data Type "T" to write
+     * @return    Number of bytes written
+     */
+    return (writeRegisters(addr, (const uint8_t *)&value, sizeof(T)));
+  }  // of method putData()
+};  // of BME280_Device class definition
+
+/*! The original BME280 class, which selects the bus at runtime through its begin() overloads */
+typedef BME280_Device<BME280_AnyBus> BME280_Class;
+
+template <uint8_t N, class Device = BME280_Class>
+class BME280_Array {
+  /*!
+    @class   BME280_Array
+    @brief   Manages up to N BME280 devices and measures them all in a single conversion window
+    @details Instead of triggering a device and waiting for its conversion before going on to the
+    next one, all devices are triggered back to back, the longest conversion time is waited for
+    once and then all results are read. The devices are stored in the class so no dynamic memory
+    is used. The default device type is BME280_Class so I2C and SPI devices can be mixed, if all
+    devices use the same bus a BME280_Device<> with that bus policy saves memory
+  */
+ public:
+  template <typename... Args>
+  bool add(Args... args) {
+    /*!
+     * @brief     Adds a device, the parameters are those of the device's begin() method
+     * @param[in] args Bus-specific parameters, e.g. a chip select pin for hardware SPI
+     * @return    returns "true" if a BME280 was found and added
+     */
+    if (_count >= N) return false;                       // No more space
+    if (!_sensors[_count].begin(args...)) return false;  // No BME280 found
+    _count++;                                            // Keep this device
+    return true;
+  }  // of method add()
+  uint8_t scanI2C(const uint32_t i2cSpeed = I2C_STANDARD_MODE) {
+    /*!
+     * @brief     Adds every BME280 found on the I2C bus
+     * @details   Unlike the begin() method of a single device the scan doesn't stop at the first
+     * BME280 found. The bus is started once, then each free address is probed by reading the chip
+     * id. Addresses of devices already managed are skipped, so the scan can be repeated to pick up
+     * devices connected later
+     * @param[in] i2cSpeed I2C speed rate in baud
+     * @return    returns the total number of devices now managed
+     */
+    Wire.begin();             // Start I2C as master device
+    Wire.setClock(i2cSpeed);  // Set I2C bus speed
+    for (uint8_t address = 1; address < 127 && _count < N; address++)
+      if (!managed(address)) add(I2C_BUS_STARTED, address);  // Probe and add a new BME280
+    return (_count);
+  }  // of method scanI2C()
+  uint8_t count() const {
+    /*!
+     * @brief     returns the number of devices managed
+     * @return    number of devices
      */
-    const uint8_t *bytePtr    = (const uint8_t *)&value;  // Pointer to structure beginning
-    static uint8_t structSize = sizeof(T);                // Number of bytes in structure
-    if (_I2CAddress)                                      // Use I2C protocol if address is non-zero
+    return (_count);
+  }  // of method count()
+  Device &operator[](const uint8_t index) {
+    /*!
+     * @brief     returns a device so that it can be accessed individually
+     * @param[in] index Device number, from 0 to count()-1
+     * @return    reference to the device
+     */
+    return (_sensors[index]);
+  }  // of operator[]
+  bool apply(const BME280_Config &config) {
+    /*!
+     * @brief     writes the same settings to all devices
+     * @param[in] config Settings to apply
+     * @return    returns "false" if the settings are out of range
+     */
+    bool returnValue = true;
+    for (uint8_t i = 0; i < _count; i++) returnValue &= _sensors[i].apply(config);
+    return (returnValue);
+  }  // of method apply()
+  uint8_t getSensorData(int32_t temp[], int32_t hum[], int32_t press[]) {
+    /*!
+     * @brief      measures all devices and returns their readings
+     * @details    All devices are started back to back, then the longest conversion time is waited
+     * for once before the results are read, so a cycle takes about one conversion time no matter
+     * how many devices there are. The time is taken from the bus policy of the first device, so
+     * the array works with the same clock as its devices, e.g. when replaying a trace
+     * @param[out] temp  temperature values, one per device
+     * @param[out] hum   humidity values, one per device
+     * @param[out] press pressure values, one per device
+     * @return     returns the number of devices read, a failed device keeps its previous values
+     */
+    if (_count == 0) return (0);                    // Nothing to measure
+    uint32_t longest = 0;                           // Longest conversion time of all devices
+    uint32_t start   = _sensors[0].bus().micros();  // Time at which the first device was started
+    for (uint8_t i = 0; i < _count; i++)            // Trigger all devices back to back
     {
-      Wire.beginTransmission(_I2CAddress);  // Address the I2C device
-      Wire.write(addr);                     // Send register address to write
-      for (uint8_t i = 0; i < sizeof(T); i++)
-        Wire.write(*bytePtr++);                      // loop for each byte to be written
-      _TransmissionStatus = Wire.endTransmission();  // Close transmission
-    } else {
-      if (_sck == 0)  // if sck is zero then use hardware SPI
-      {
-        SPI.beginTransaction(
-            SPISettings(SPI_HERTZ, MSBFIRST, SPI_MODE0));  // start the SPI transaction
-        digitalWrite(_cs, LOW);                            // Tell BME280 to listen up
-        SPI.transfer(addr & ~0x80);                        // bit 7 is low, so write a byte
-        for (uint8_t i = 0; i < structSize; i++)
-          SPI.transfer(*bytePtr++);  // loop for each byte to be written
-        digitalWrite(_cs, HIGH);     // Tell BME280 to stop listening
-        SPI.endTransaction();        // End the transaction
-      } else                         // Otherwise use software SPI
-      {
-        int8_t  i, j;
-        uint8_t reply;
-        for (i = 0; i < structSize; i++) {
-          reply = 0;                                         // reset our return byte
-          digitalWrite(_cs, LOW);                            // Tell BME280 to listen up
-          for (j = 7; j >= 0; j--) {                         // First send the address byte
-            digitalWrite(_sck, LOW);                         // set the clock signal
-            digitalWrite(_mosi, (addr & ~0x80) & (1 << j));  // set the MOSI pin state
-            digitalWrite(_sck, HIGH);                        // reset the clock signal
-          }                                                  // of for-next each bit
-          for (j = 7; j >= 0; j--)                           // Now read the data at that byte
-          {
-            reply <<= 1;                               // shift buffer one bit left
-            digitalWrite(_sck, LOW);                   // set the clock signal
-            digitalWrite(_mosi, *bytePtr & (1 << j));  // set the MOSI pin state
-            digitalWrite(_sck, HIGH);                  // reset the clock signal
-          }                                            // of for-next each bit
-#ifdef ESP32
-          static uint8_t dummyVar =
-              *bytePtr++;  // go to next byte to write (dummyVar only required for ESP32)
-#else
-          *bytePtr++;  // go to next byte to write
-#endif
-          digitalWrite(_cs, HIGH);  // Tell BME280 to stop listening
-        }                           // of for-next each byte to be read
-      }                             // of  if-then-else we are using hardware SPI
-    }                               // of if-then-else we are using I2C
-    return (structSize);            // return number of bytes written
-  }                                 // of method putData()
-};                                  // of BME280 class definition
+      _sensors[i].startMeasurement();
+      uint32_t conversion = _sensors[i].conversionTime(TypicalMeasure);
+      if (conversion > longest) longest = conversion;
+    }  // of for-next each device
+    uint32_t elapsed = _sensors[0].bus().micros() - start;  // Time taken to start the devices
+    if (elapsed < longest) _sensors[0].bus().delay((longest - elapsed) / 1000);  // Wait once
+    uint8_t devicesRead = 0;              // Number of devices read
+    for (uint8_t i = 0; i < _count; i++)  // Read all results
+    {
+      while (!_sensors[i].isReady()) {}  // Waits on the device's clock, completes or times out
+      if (_sensors[i].fetchResult(temp[i], hum[i], press[i])) devicesRead++;
+    }  // of for-next each device
+    return (devicesRead);
+  }  // of method getSensorData()
+
+ private:
+  bool managed(const uint8_t address) {
+    /*!
+     * @brief     returns whether a managed device uses an I2C address
+     * @param[in] address I2C address
+     * @return    returns "true" if a device already uses the address
+     */
+    for (uint8_t i = 0; i < _count; i++)
+      if (_sensors[i].bus().address() == address) return true;
+    return false;
+  }  // of method managed()
+  Device  _sensors[N];  ///< Managed devices
+  uint8_t _count = 0;   ///< Number of devices in use
+};                      // of class BME280_Array
 #endif
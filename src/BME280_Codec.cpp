@@ -0,0 +1,350 @@
+/*!
+ * @file BME280_Codec.cpp
+ * @section BME280_Codeccpp_intro_section Description
+ *
+ * Arduino Library for the BME280 Bosch sensor\n\n
+ * This file contains the sample format declared in BME280_Codec.h and doesn't use any Arduino
+ * functions\n\n
+ * See main library header file for details
+ */
+#include "BME280_Codec.h"
+/*************************************************************************************************
+** Header layout, multi-byte values are little-endian: the 2 magic bytes, the format version,   **
+** the BME280_Config fields, the calibration values dig_T1 to dig_H6 in numerical order and a   **
+** CRC-8 of all previous header bytes. A reading record starts with a variable-length integer   **
+** whose lowest bit is set for keyframes. Keyframes continue with the sample number in the      **
+** other bits and the zigzag-encoded temperature, humidity and pressure, other records with the **
+** zigzag-encoded temperature difference in the other bits, a byte holding the lowest 8 bits of **
+** the sample number and the humidity and pressure differences                                  **
+*************************************************************************************************/
+static const uint8_t MAGIC[2] = {0xB2, 0x80};  ///< First bytes of a header
+
+static inline uint32_t zigzag(const int32_t value) {
+  /*!
+   * @brief     returns a signed value mapped to an unsigned one, 0, -1, 1, -2, 2 become 0 to 4
+   * @param[in] value Signed value
+   * @return    Unsigned value
+   */
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}  // of function zigzag()
+static inline int32_t unzigzag(const uint32_t value) {
+  /*!
+   * @brief     returns the signed value of a zigzag-encoded value
+   * @param[in] value Unsigned value
+   * @return    Signed value
+   */
+  return (int32_t)((value >> 1) ^ (0 - (value & 1)));
+}  // of function unzigzag()
+static inline int32_t difference(const int32_t value, const int32_t previous) {
+  /*!
+   * @brief     returns the difference of two values, wrapping around instead of overflowing
+   * @param[in] value New value
+   * @param[in] previous Previous value
+   * @return    Difference
+   */
+  return (int32_t)((uint32_t)value - (uint32_t)previous);
+}  // of function difference()
+static uint8_t writeVarint(uint8_t *out, uint8_t length, uint32_t value) {
+  /*!
+   * @brief     appends a value using 7 bits per byte, the top bit is set when more bytes follow
+   * @param[in] out Output buffer
+   * @param[in] length Bytes already in the output buffer
+   * @param[in] value Value to write
+   * @return    New number of bytes in the output buffer
+   */
+  while (value >= 0x80) {
+    out[length++] = (uint8_t)value | 0x80;
+    value >>= 7;
+  }  // of while-loop more bytes follow
+  out[length++] = (uint8_t)value;
+  return (length);
+}  // of function writeVarint()
+static uint8_t writeWord(uint8_t *out, const uint8_t length, const uint16_t value) {
+  /*!
+   * @brief     appends a 16-bit value in little-endian order
+   * @param[in] out Output buffer
+   * @param[in] length Bytes already in the output buffer
+   * @param[in] value Value to write
+   * @return    New number of bytes in the output buffer
+   */
+  out[length]     = (uint8_t)value;
+  out[length + 1] = (uint8_t)(value >> 8);
+  return (length + 2);
+}  // of function writeWord()
+static inline uint16_t readWord(const uint8_t *buffer, const uint8_t offset) {
+  /*!
+   * @brief     returns the little-endian 16-bit value stored at the given offset of a buffer
+   * @param[in] buffer Buffer containing the header
+   * @param[in] offset Byte offset of the low byte
+   * @return    16-bit value
+   */
+  return ((uint16_t)buffer[offset + 1] << 8) | buffer[offset];
+}  // of function readWord()
+
+void BME280_Encoder::begin(uint8_t *buffer, const uint16_t size, const uint16_t keyframeInterval) {
+  /*!
+   * @brief     starts writing into a new buffer
+   * @details   The values of the previous buffer carry over, so the first reading in the new buffer
+   * is a difference unless it is due for a keyframe
+   * @param[in] buffer Output buffer
+   * @param[in] size Size of the output buffer in bytes
+   * @param[in] keyframeInterval Readings between keyframes, 0 for only the first and requested ones
+   */
+  _buffer   = buffer;
+  _size     = size;
+  _length   = 0;
+  _interval = keyframeInterval;
+}  // of method begin()
+bool BME280_Encoder::header(const BME280_Config &config, const BME280_Calibration &cal) {
+  /*!
+   * @brief     writes the header, normally once at the start of a stream
+   * @param[in] config Device settings, e.g. from getConfig()
+   * @param[in] cal Calibration values, e.g. from calibration()
+   * @return    returns "false" if the header doesn't fit into the buffer
+   */
+  if (_buffer == nullptr || _size - _length < BME280_CODEC_HEADER_LENGTH) return false;
+  uint8_t *out = _buffer + _length;
+  uint8_t  n   = 0;
+  out[n++]     = MAGIC[0];
+  out[n++]     = MAGIC[1];
+  out[n++]     = BME280_CODEC_VERSION;
+  out[n++]     = config.temperatureSampling;
+  out[n++]     = config.pressureSampling;
+  out[n++]     = config.humiditySampling;
+  out[n++]     = config.iirFilter;
+  out[n++]     = config.inactiveTime;
+  out[n++]     = config.mode;
+  n            = writeWord(out, n, cal.dig_T1);
+  n            = writeWord(out, n, (uint16_t)cal.dig_T2);
+  n            = writeWord(out, n, (uint16_t)cal.dig_T3);
+  n            = writeWord(out, n, cal.dig_P1);
+  n            = writeWord(out, n, (uint16_t)cal.dig_P2);
+  n            = writeWord(out, n, (uint16_t)cal.dig_P3);
+  n            = writeWord(out, n, (uint16_t)cal.dig_P4);
+  n            = writeWord(out, n, (uint16_t)cal.dig_P5);
+  n            = writeWord(out, n, (uint16_t)cal.dig_P6);
+  n            = writeWord(out, n, (uint16_t)cal.dig_P7);
+  n            = writeWord(out, n, (uint16_t)cal.dig_P8);
+  n            = writeWord(out, n, (uint16_t)cal.dig_P9);
+  out[n++]     = cal.dig_H1;
+  n            = writeWord(out, n, (uint16_t)cal.dig_H2);
+  out[n++]     = cal.dig_H3;
+  n            = writeWord(out, n, (uint16_t)cal.dig_H4);
+  n            = writeWord(out, n, (uint16_t)cal.dig_H5);
+  out[n++]     = (uint8_t)cal.dig_H6;
+  out[n]       = BME280_Core::crc8(out, n);
+  _length += BME280_CODEC_HEADER_LENGTH;
+  return true;
+}  // of method header()
+bool BME280_Encoder::add(const BME280_Reading &reading) {
+  /*!
+   * @brief     writes a reading
+   * @details   The record is built in a local buffer first, so a reading is either written
+   * completely or not at all
+   * @param[in] reading Compensated reading, e.g. from getSensorData()
+   * @return    returns "false" if the record doesn't fit into the buffer, call begin() with the
+   * next buffer and add the reading again
+   */
+  uint8_t  record[BME280_CODEC_MAX_RECORD];  // Record being built
+  uint8_t  n     = 0;                        // Bytes in the record
+  uint32_t first = zigzag(difference(reading.temperature, _last.temperature));
+  bool     key   = _keyframe || (_interval != 0 && _sinceKey >= _interval) ||
+               first >= 0x80000000;  // The difference doesn't fit next to the tag bit
+  if (key) {
+    n = writeVarint(record, n, (_samples << 1) | 1);
+    n = writeVarint(record, n, zigzag(reading.temperature));
+    n = writeVarint(record, n, zigzag(reading.humidity));
+    n = writeVarint(record, n, zigzag(reading.pressure));
+  } else {
+    n           = writeVarint(record, n, first << 1);
+    record[n++] = (uint8_t)_samples;  // Lets the decoder find lost records
+    n           = writeVarint(record, n, zigzag(difference(reading.humidity, _last.humidity)));
+    n           = writeVarint(record, n, zigzag(difference(reading.pressure, _last.pressure)));
+  }  // of if-then-else keyframe
+  if (_buffer == nullptr || _size - _length < n) return false;
+  for (uint8_t i = 0; i < n; i++) _buffer[_length++] = record[i];
+  _last     = reading;
+  _keyframe = false;
+  _sinceKey = key ? 1 : _sinceKey + 1;
+  _samples++;
+  return true;
+}  // of method add()
+void BME280_Encoder::keyframe() {
+  /*!
+   * @brief     writes the next reading as a keyframe, e.g. when a buffer has to be decodable alone
+   */
+  _keyframe = true;
+}  // of method keyframe()
+void BME280_Encoder::reset() {
+  /*!
+   * @brief     starts a new stream, the sample number restarts at 0 and the next reading is a
+   * keyframe. The buffer is kept
+   */
+  _length   = 0;
+  _sinceKey = 0;
+  _keyframe = true;
+  _samples  = 0;
+  _last     = {};
+}  // of method reset()
+uint16_t BME280_Encoder::length() const {
+  /*!
+   * @brief     returns the number of bytes written to the current buffer
+   * @return    bytes written
+   */
+  return (_length);
+}  // of method length()
+uint32_t BME280_Encoder::samples() const {
+  /*!
+   * @brief     returns the number of readings written since the start of the stream
+   * @return    readings written
+   */
+  return (_samples);
+}  // of method samples()
+
+void BME280_Decoder::begin(const uint8_t *data, const uint16_t length) {
+  /*!
+   * @brief     starts reading a new buffer
+   * @details   The values of the previous buffer carry over, call reset() first when the buffer is
+   * from another stream
+   * @param[in] data Encoded bytes
+   * @param[in] length Number of bytes
+   */
+  _data     = data;
+  _length   = length;
+  _position = 0;
+}  // of method begin()
+bool BME280_Decoder::header(BME280_Config &config, BME280_Calibration &cal) {
+  /*!
+   * @brief      reads the header at the current position
+   * @param[out] config Device settings
+   * @param[out] cal Calibration values
+   * @return     returns "false" and leaves the position unchanged if there is no valid header
+   */
+  if (_data == nullptr || _length - _position < BME280_CODEC_HEADER_LENGTH) return false;
+  const uint8_t *in = _data + _position;
+  if (in[0] != MAGIC[0] || in[1] != MAGIC[1] || in[2] != BME280_CODEC_VERSION ||
+      in[BME280_CODEC_HEADER_LENGTH - 1] !=
+          BME280_Core::crc8(in, BME280_CODEC_HEADER_LENGTH - 1))
+    return false;
+  config.temperatureSampling = in[3];
+  config.pressureSampling    = in[4];
+  config.humiditySampling    = in[5];
+  config.iirFilter           = in[6];
+  config.inactiveTime        = in[7];
+  config.mode                = in[8];
+  cal.dig_T1                 = readWord(in, 9);
+  cal.dig_T2                 = (int16_t)readWord(in, 11);
+  cal.dig_T3                 = (int16_t)readWord(in, 13);
+  cal.dig_P1                 = readWord(in, 15);
+  cal.dig_P2                 = (int16_t)readWord(in, 17);
+  cal.dig_P3                 = (int16_t)readWord(in, 19);
+  cal.dig_P4                 = (int16_t)readWord(in, 21);
+  cal.dig_P5                 = (int16_t)readWord(in, 23);
+  cal.dig_P6                 = (int16_t)readWord(in, 25);
+  cal.dig_P7                 = (int16_t)readWord(in, 27);
+  cal.dig_P8                 = (int16_t)readWord(in, 29);
+  cal.dig_P9                 = (int16_t)readWord(in, 31);
+  cal.dig_H1                 = in[33];
+  cal.dig_H2                 = (int16_t)readWord(in, 34);
+  cal.dig_H3                 = in[36];
+  cal.dig_H4                 = (int16_t)readWord(in, 37);
+  cal.dig_H5                 = (int16_t)readWord(in, 39);
+  cal.dig_H6                 = (int8_t)in[41];
+  _position += BME280_CODEC_HEADER_LENGTH;
+  return true;
+}  // of method header()
+bool BME280_Decoder::next(BME280_Reading &reading) {
+  /*!
+   * @brief      reads the next reading
+   * @details    Differences before the first keyframe are skipped. A difference whose sequence
+   * byte doesn't follow the last reading returned means that records have been lost, e.g. with a
+   * dropped buffer, so it and all further differences are skipped until the next keyframe
+   * @param[out] reading Compensated reading
+   * @return     returns "false" at the end of the buffer or if the rest of the buffer isn't a
+   * complete record
+   */
+  uint32_t value[4];  // Tagged value, sample number or sequence byte and the differences
+  while (true) {
+    uint16_t position = _position;
+    if (!readVarint(position, value[0])) return false;
+    if (value[0] & 1) {  // Keyframes have the sample number in the tagged value
+      if (!readVarint(position, value[1])) return false;
+    } else {
+      if (position >= _length) return false;
+      value[1] = _data[position++];
+    }  // of if-then-else keyframe
+    if (!readVarint(position, value[2]) || !readVarint(position, value[3])) return false;
+    _position = position;
+    if (value[0] & 1) {  // Keyframe
+      if (_synced && value[0] >> 1 != ((_sample + 1) & 0x7FFFFFFF)) _gaps++;
+      _sample           = value[0] >> 1;
+      _last.temperature = unzigzag(value[1]);
+      _last.humidity    = unzigzag(value[2]);
+      _last.pressure    = unzigzag(value[3]);
+      _synced           = true;
+      break;
+    }  // of if-then keyframe
+    if (_synced && value[1] == (uint8_t)(_sample + 1)) {
+      _sample++;
+      _last.temperature += unzigzag(value[0] >> 1);
+      _last.humidity    += unzigzag(value[2]);
+      _last.pressure    += unzigzag(value[3]);
+      break;
+    }  // of if-then next difference
+    if (_synced) {
+      _synced = false;  // Previous values unknown until the next keyframe
+      _gaps++;
+    }  // of if-then records lost
+  }    // of loop until a reading can be returned
+  reading = _last;
+  return true;
+}  // of method next()
+void BME280_Decoder::reset() {
+  /*!
+   * @brief     starts a new stream, readings are skipped until the next keyframe
+   */
+  _synced = false;
+  _sample = 0;
+  _gaps   = 0;
+  _last   = {};
+}  // of method reset()
+uint16_t BME280_Decoder::position() const {
+  /*!
+   * @brief     returns the position of the next byte to read, i.e. the bytes used so far
+   * @return    position in the buffer
+   */
+  return (_position);
+}  // of method position()
+uint32_t BME280_Decoder::sample() const {
+  /*!
+   * @brief     returns the sample number of the last reading returned by next()
+   * @details   Keyframes store the sample number modulo 2^31
+   * @return    sample number, counting from 0 at the start of the stream
+   */
+  return (_sample);
+}  // of method sample()
+uint32_t BME280_Decoder::gaps() const {
+  /*!
+   * @brief     returns the number of places where records were found to be missing
+   * @details   Differences are checked with the lowest byte of the sample number, so a gap of a
+   * multiple of 256 records between two differences isn't seen. Keyframes are always checked
+   * @return    gaps found since reset()
+   */
+  return (_gaps);
+}  // of method gaps()
+bool BME280_Decoder::readVarint(uint16_t &position, uint32_t &value) const {
+  /*!
+   * @brief         reads a value written with 7 bits per byte
+   * @param[in,out] position Position of the first byte, moved past the value
+   * @param[out]    value Value read
+   * @return        returns "false" if the buffer ends before the value or it is longer than 5 bytes
+   */
+  value = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7) {
+    if (position >= _length) return false;
+    uint8_t in = _data[position++];
+    value |= (uint32_t)(in & 0x7F) << shift;
+    if (!(in & 0x80)) return true;
+  }  // of for-next each byte
+  return false;
+}  // of method readVarint()
@@ -0,0 +1,89 @@
+/*!
+ @file BME280_Codec.h
+
+ @section BME280_Codec_intro_section Description
+
+ Compact binary format for logging or transmitting series of compensated readings\n\n
+
+ A stream starts with an optional header holding the settings and the calibration values of the
+ device, so raw and compensated values can be related later. Each reading is then stored as the
+ difference to the previous one, zigzag-encoded so that small negative differences are small
+ numbers, and written as a variable-length integer with 7 bits per byte. A byte with the lowest 8
+ bits of the sample number follows the temperature difference. Slowly changing readings take 4 to
+ 5 bytes instead of 12. Keyframes hold the absolute values and the full sample number and are
+ written for the first reading, every keyframeInterval readings and when requested with
+ keyframe(), so a stream can be decoded starting at any keyframe, e.g. after a lost radio packet
+ or from the middle of a log file. The decoder uses the sample numbers to find lost records and
+ skips the differences after them until the next keyframe instead of adding them to the wrong
+ values. A record is never split between two buffers.\n\n
+
+ Neither class allocates memory, the caller provides the buffers. The code only depends on
+ BME280_Core.h, so the decoder can also be run on a computer.\n\n
+
+ See main library header file for details
+*/
+#ifndef BME280_Codec_h
+/*! @brief Define guard code to prevent multiple inclusions */
+#define BME280_Codec_h
+#include "BME280_Core.h"  // Include the BME280 Sensor library types
+
+const uint8_t BME280_CODEC_VERSION       = 2;   ///< Format version stored in the header
+const uint8_t BME280_CODEC_HEADER_LENGTH = 43;  ///< Bytes taken by the header
+const uint8_t BME280_CODEC_MAX_RECORD    = 20;  ///< Most bytes taken by one reading
+
+class BME280_Encoder {
+  /*!
+    @class   BME280_Encoder
+    @brief   Writes readings into a caller-provided buffer
+    @details When add() returns "false" the buffer is full, the caller then stores or sends the
+    length() bytes written and calls begin() with the next buffer. The stream continues in the new
+    buffer, call keyframe() first if the buffer has to be decodable on its own
+  */
+ public:
+  void     begin(uint8_t *buffer, const uint16_t size, const uint16_t keyframeInterval = 0);
+  bool     header(const BME280_Config &config, const BME280_Calibration &cal);
+  bool     add(const BME280_Reading &reading);
+  void     keyframe();
+  void     reset();
+  uint16_t length() const;
+  uint32_t samples() const;
+
+ private:
+  uint8_t       *_buffer   = nullptr;  ///< Output buffer
+  uint16_t       _size     = 0;        ///< Size of the output buffer
+  uint16_t       _length   = 0;        ///< Bytes written to the output buffer
+  uint16_t       _interval = 0;        ///< Readings between keyframes, 0 for none
+  uint16_t       _sinceKey = 0;        ///< Readings since the last keyframe
+  bool           _keyframe = true;     ///< Next reading is written as a keyframe
+  uint32_t       _samples  = 0;        ///< Readings written since reset()
+  BME280_Reading _last     = {};       ///< Previous reading
+};                                     // of class BME280_Encoder
+
+class BME280_Decoder {
+  /*!
+    @class   BME280_Decoder
+    @brief   Reads the readings written by BME280_Encoder
+    @details Consecutive buffers of one stream are decoded by calling begin() for each one, the
+    values carry over. Readings before the first keyframe seen and after records have been lost are
+    skipped as they can't be reconstructed, gaps() counts the places records were lost
+  */
+ public:
+  void     begin(const uint8_t *data, const uint16_t length);
+  bool     header(BME280_Config &config, BME280_Calibration &cal);
+  bool     next(BME280_Reading &reading);
+  void     reset();
+  uint16_t position() const;
+  uint32_t sample() const;
+  uint32_t gaps() const;
+
+ private:
+  bool           readVarint(uint16_t &position, uint32_t &value) const;
+  const uint8_t *_data     = nullptr;  ///< Input buffer
+  uint16_t       _length   = 0;        ///< Bytes in the input buffer
+  uint16_t       _position = 0;        ///< Next byte to read
+  bool           _synced   = false;    ///< A keyframe has been read
+  uint32_t       _sample   = 0;        ///< Sample number of the last reading returned
+  uint32_t       _gaps     = 0;        ///< Places where records were lost
+  BME280_Reading _last     = {};       ///< Last reading returned
+};                                     // of class BME280_Decoder
+#endif
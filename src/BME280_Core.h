@@ -0,0 +1,366 @@
+/*!
+ @file BME280_Core.h
+
+ @section BME280_Core_intro_section Description
+
+ Platform-independent part of the BME280 library\n\n
+
+ This file holds the register map, the enumerated types and structures, the decoding of the
+ calibration values and the compensation math. It only depends on the standard integer types, so
+ together with BME280.cpp it can be compiled and profiled on any computer while BME280.h adds the
+ Arduino bus code on top of it.\n\n
+
+ See main library header file for details
+*/
+#ifndef BME280_Core_h
+/*! @brief Define guard code to prevent multiple inclusions */
+#define BME280_Core_h
+#include <stdint.h>  // Standard integer types
+
+#include "BME280_Options.h"  // Library-wide build options
+/*************************************************************************************************
+** Declare constants used in the class                                                          **
+*************************************************************************************************/
+const uint8_t BME280_CHIPID_REG       = 0xD0;  ///< Chip-Id register
+const uint8_t BME280_CHIPID           = 0x60;  ///< Hard-coded value 0x60 for BME280
+const uint8_t BME280_SOFTRESET_REG    = 0xE0;  ///< Reset when 0xB6 is written here
+const uint8_t BME280_CONTROLHUMID_REG = 0xF2;  ///< Humidity control register
+const uint8_t BME280_STATUS_REG       = 0xF3;  ///< Device status register
+const uint8_t BME280_CONTROL_REG      = 0xF4;  ///< Device control register
+const uint8_t BME280_CONFIG_REG       = 0xF5;  ///< Device configuration register
+const uint8_t BME280_PRESSUREDATA_REG = 0xF7;  ///< Pressure readings register
+const uint8_t BME280_TEMPDATA_REG     = 0xFA;  ///< Temperature readings register
+const uint8_t BME280_HUMIDDATA_REG    = 0xFD;  ///< Humidity readings register
+const uint8_t BME280_SOFTWARE_CODE    = 0xB6;  ///< Reset on this written to resetreg
+const uint8_t BME280_T1_REG           = 0x88;  ///< Declare BME280 registers for the
+const uint8_t BME280_T2_REG           = 0x8A;  ///< calibration data register
+const uint8_t BME280_T3_REG           = 0x8C;  ///< calibration data register
+const uint8_t BME280_P1_REG           = 0x8E;  ///< calibration data register
+const uint8_t BME280_P2_REG           = 0x90;  ///< calibration data register
+const uint8_t BME280_P3_REG           = 0x92;  ///< calibration data register
+const uint8_t BME280_P4_REG           = 0x94;  ///< calibration data register
+const uint8_t BME280_P5_REG           = 0x96;  ///< calibration data register
+const uint8_t BME280_P6_REG           = 0x98;  ///< calibration data register
+const uint8_t BME280_P7_REG           = 0x9A;  ///< calibration data register
+const uint8_t BME280_P8_REG           = 0x9C;  ///< calibration data register
+const uint8_t BME280_P9_REG           = 0x9E;  ///< calibration data register
+const uint8_t BME280_H1_REG           = 0xA1;  ///< calibration data register
+const uint8_t BME280_H2_REG           = 0xE1;  ///< calibration data register
+const uint8_t BME280_H3_REG           = 0xE3;  ///< calibration data register
+const uint8_t BME280_H4_REG           = 0xE4;  ///< calibration data register
+const uint8_t BME280_H5_REG           = 0xE5;  ///< calibration data register
+const uint8_t BME280_H6_REG           = 0xE7;  ///< calibration data register
+const uint8_t BME280_TP_CALIB_LENGTH  = 26;    ///< Bytes in calibration block 0x88-0xA1
+const uint8_t BME280_H_CALIB_LENGTH   = 7;     ///< Bytes in calibration block 0xE1-0xE7
+const uint8_t BME280_RAW_DATA_LENGTH  = 8;     ///< Bytes in measurement block 0xF7-0xFE
+const uint8_t BME280_STARTUP_TIME     = 2;     ///< Milliseconds from reset until device is usable
+
+/*************************************************************************************************
+** Declare enumerated types used in the class                                                   **
+*************************************************************************************************/
+/*! Device Mode list */
+enum modeTypes { SleepMode, ForcedMode, ForcedMode2, NormalMode, UnknownMode };
+/*! Sensor type list */
+enum sensorTypes { TemperatureSensor, HumiditySensor, PressureSensor, UnknownSensor };
+/*! Channel selection bits, one bit per sensorTypes value */
+enum channelTypes {
+  TemperatureChannel = 1 << TemperatureSensor,
+  HumidityChannel    = 1 << HumiditySensor,
+  PressureChannel    = 1 << PressureSensor,
+  AllChannels        = TemperatureChannel | HumidityChannel | PressureChannel
+};
+/*! Oversampling type list */
+enum oversamplingTypes {
+  SensorOff,
+  Oversample1,
+  Oversample2,
+  Oversample4,
+  Oversample8,
+  Oversample16,
+  UnknownOversample
+};
+/*! iir Filter type list */
+enum iirFilterTypes { IIROff, IIR2, IIR4, IIR8, IIR16, UnknownIIR };
+/*! inactive time type list */
+enum inactiveTimeTypes {
+  inactiveHalf,
+  inactive63ms,
+  inactive125ms,
+  inactive250ms,
+  inactive500ms,
+  inactive1000ms,
+  inactive10ms,
+  inactive20ms,
+  UnknownInactive
+};
+/*! Measure time type list */
+enum measureTimeTypes { TypicalMeasure, MaximumMeasure, UnknownMeasure };
+/*! Error list, see lastError() */
+enum errorTypes {
+  NoError,           ///< No error since the last call to lastError()
+  BusError,          ///< A transfer wasn't acknowledged, e.g. an I2C NAK
+  ShortReadError,    ///< Fewer bytes than requested were read
+  TimeoutError,      ///< The device was still measuring after the maximum conversion time
+  ChipIdError,       ///< The device didn't return the BME280 chip id
+  CalibrationError,  ///< The calibration values don't match those read by begin()
+  DeviceResetError,  ///< The device lost its settings, e.g. after a brown-out
+  UnknownError
+};
+
+/*************************************************************************************************
+** Register bit fields. Each descriptor holds the register, position and width of a field and  **
+** the enumerated type of its values, so all masks are derived from one table at compile time   **
+*************************************************************************************************/
+template <uint8_t Address, uint8_t Shift, uint8_t Width, typename Type, uint8_t Limit>
+struct BME280_Field {
+  /*!
+    @brief   Describes a bit field of a device register
+    @details All members are compile-time constants, so insert() and extract() with constant fields
+    compile down to a single mask and shift. The value passed to insert() is masked to the field
+    width so that it can never change neighbouring fields
+  */
+  static_assert(Shift + Width <= 8, "Register fields must fit into 8 bits");
+  static_assert(Limit >= 1 && Limit <= (1 << Width), "Field values must fit into the field");
+  typedef Type type;  ///< Enumerated type of the field values
+  enum : uint8_t {
+    address = Address,                                  ///< Register address
+    shift   = Shift,                                    ///< Position of the lowest field bit
+    mask    = (uint8_t)(((1U << Width) - 1) << Shift),  ///< Field bits within the register
+    limit   = Limit                                     ///< Lowest invalid value
+  };
+  static constexpr uint8_t insert(const uint8_t registerValue, const uint8_t value) {
+    /*!
+     * @brief     returns the register value with the field set to a new value
+     * @param[in] registerValue Current register contents
+     * @param[in] value New field value
+     * @return    New register contents
+     */
+    return ((registerValue & (uint8_t)~mask) | ((value << shift) & mask));
+  }  // of method insert()
+  static constexpr uint8_t extract(const uint8_t registerValue) {
+    /*!
+     * @brief     returns the field value from the register contents
+     * @param[in] registerValue Register contents
+     * @return    Field value
+     */
+    return ((registerValue & mask) >> shift);
+  }  // of method extract()
+};   // of struct BME280_Field
+/*! Humidity oversampling, ctrl_hum bits 2:0 */
+typedef BME280_Field<BME280_CONTROLHUMID_REG, 0, 3, oversamplingTypes, UnknownOversample>
+    BME280_HumiditySamplingField;
+/*! Measuring flag, status bit 3 */
+typedef BME280_Field<BME280_STATUS_REG, 3, 1, uint8_t, 2> BME280_MeasuringField;
+/*! NVM copy in progress flag, status bit 0 */
+typedef BME280_Field<BME280_STATUS_REG, 0, 1, uint8_t, 2> BME280_UpdatingField;
+/*! Temperature oversampling, ctrl_meas bits 7:5 */
+typedef BME280_Field<BME280_CONTROL_REG, 5, 3, oversamplingTypes, UnknownOversample>
+    BME280_TemperatureSamplingField;
+/*! Pressure oversampling, ctrl_meas bits 4:2 */
+typedef BME280_Field<BME280_CONTROL_REG, 2, 3, oversamplingTypes, UnknownOversample>
+    BME280_PressureSamplingField;
+/*! Operating mode, ctrl_meas bits 1:0 */
+typedef BME280_Field<BME280_CONTROL_REG, 0, 2, modeTypes, UnknownMode> BME280_ModeField;
+/*! Inactive time in normal mode, config bits 7:5 */
+typedef BME280_Field<BME280_CONFIG_REG, 5, 3, inactiveTimeTypes, UnknownInactive>
+    BME280_InactiveTimeField;
+/*! IIR filter coefficient, config bits 4:2 */
+typedef BME280_Field<BME280_CONFIG_REG, 2, 3, iirFilterTypes, UnknownIIR> BME280_IIRFilterField;
+/*! 3-wire SPI interface, config bit 0 */
+typedef BME280_Field<BME280_CONFIG_REG, 0, 1, uint8_t, 2> BME280_SPI3WireField;
+/*! Status bits which are set while the device is busy */
+const uint8_t BME280_STATUS_BUSY = BME280_MeasuringField::mask | BME280_UpdatingField::mask;
+/*************************************************************************************************
+** Compile-time checks of the field table, they also run whenever the library is compiled on a  **
+** computer                                                                                     **
+*************************************************************************************************/
+static_assert((BME280_TemperatureSamplingField::mask | BME280_PressureSamplingField::mask |
+               BME280_ModeField::mask) == 0xFF,
+              "ctrl_meas fields must cover the register without gaps");
+static_assert((BME280_TemperatureSamplingField::mask & BME280_PressureSamplingField::mask) == 0 &&
+                  (BME280_PressureSamplingField::mask & BME280_ModeField::mask) == 0,
+              "ctrl_meas fields must not overlap");
+static_assert((BME280_InactiveTimeField::mask & BME280_IIRFilterField::mask) == 0 &&
+                  (BME280_IIRFilterField::mask & BME280_SPI3WireField::mask) == 0,
+              "config fields must not overlap");
+static_assert(BME280_IIRFilterField::insert(0xFF, IIR16) == 0xF3,
+              "IIR filter must only change config bits 4:2");
+static_assert(BME280_IIRFilterField::insert(0x00, 0xFF) == BME280_IIRFilterField::mask,
+              "Out of range IIR values must not reach other fields");
+static_assert(BME280_InactiveTimeField::insert(0x1D, inactive20ms) == 0xFD,
+              "Inactive time must keep the IIR filter and SPI bits");
+static_assert(BME280_InactiveTimeField::insert(0x00, 0xFF) == 0xE0,
+              "Out of range inactive times must not reach other fields");
+static_assert(BME280_ModeField::insert(0xB7, ForcedMode) == 0xB5,
+              "Mode must only change ctrl_meas bits 1:0");
+static_assert(BME280_TemperatureSamplingField::extract(0x57) == Oversample2 &&
+                  BME280_PressureSamplingField::extract(0x57) == Oversample16 &&
+                  BME280_ModeField::extract(0x57) == NormalMode,
+              "Fields must decode ctrl_meas 0x57 as x2 / x16 / normal mode");
+static_assert(BME280_STATUS_BUSY == 0x09, "Busy status bits are measuring and im_update");
+
+/*************************************************************************************************
+** Declare structures used in the class                                                         **
+*************************************************************************************************/
+/*! Raw image of both calibration blocks, each of which is read in a single burst transfer */
+struct BME280_CalibrationRegisters {
+  uint8_t tp[BME280_TP_CALIB_LENGTH];  ///< Temperature and pressure trimming, 0x88 - 0xA1
+  uint8_t h[BME280_H_CALIB_LENGTH];    ///< Humidity trimming, 0xE1 - 0xE7
+};
+/*! Decoded calibration values, see section 4.2.2 "Trimming parameter readout" of the datasheet */
+struct BME280_Calibration {
+  uint16_t dig_T1;  ///< Temperature trim 1
+  int16_t  dig_T2;  ///< Temperature trim 2
+  int16_t  dig_T3;  ///< Temperature trim 3
+  uint16_t dig_P1;  ///< Pressure trim 1
+  int16_t  dig_P2;  ///< Pressure trim 2
+  int16_t  dig_P3;  ///< Pressure trim 3
+  int16_t  dig_P4;  ///< Pressure trim 4
+  int16_t  dig_P5;  ///< Pressure trim 5
+  int16_t  dig_P6;  ///< Pressure trim 6
+  int16_t  dig_P7;  ///< Pressure trim 7
+  int16_t  dig_P8;  ///< Pressure trim 8
+  int16_t  dig_P9;  ///< Pressure trim 9
+  int16_t  dig_H2;  ///< Humidity trim 2
+  int16_t  dig_H4;  ///< Humidity trim 4, 12 bits split over 0xE4 and 0xE5
+  int16_t  dig_H5;  ///< Humidity trim 5, 12 bits split over 0xE5 and 0xE6
+  uint8_t  dig_H1;  ///< Humidity trim 1
+  uint8_t  dig_H3;  ///< Humidity trim 3
+  int8_t   dig_H6;  ///< Humidity trim 6
+};
+#if BME280_COMPENSATION == BME280_COMPENSATION_FLOAT
+/*! Calibration values of the floating point engine converted once, with the constant factors of
+ * the formulas applied where the datasheet formula computes them on their own, so the results are
+ * unchanged. Only the terms of the engine selected by BME280_COMPENSATION are declared, files
+ * compiled with different engines don't link, see BME280_Options.h */
+struct BME280_Coefficients {
+  double T1d1024;   ///< dig_T1 / 1024
+  double T1d8192;   ///< dig_T1 / 8192
+  double T2;        ///< dig_T2
+  double T3;        ///< dig_T3
+  double P1;        ///< dig_P1
+  double P2;        ///< dig_P2
+  double P3;        ///< dig_P3
+  double P4x65536;  ///< dig_P4 * 65536
+  double P5;        ///< dig_P5
+  double P6;        ///< dig_P6
+  double P7;        ///< dig_P7
+  double P8;        ///< dig_P8
+  double P9;        ///< dig_P9
+  double H1;        ///< dig_H1
+  double H2d65536;  ///< dig_H2 / 65536
+  double H3d2p26;   ///< dig_H3 / 2^26
+  double H4x64;     ///< dig_H4 * 64
+  double H5d16384;  ///< dig_H5 / 16384
+  double H6d2p26;   ///< dig_H6 / 2^26
+};
+#elif BME280_COMPENSATION == BME280_COMPENSATION_INT32
+/*! Calibration terms of the 32-bit formulas which don't depend on the readings, see
+ * BME280_Calibration for the other values */
+struct BME280_Coefficients {
+  int32_t T1x2;      ///< dig_T1 * 2
+  int32_t P4x65536;  ///< dig_P4 * 65536
+  int32_t P5x2;      ///< dig_P5 * 2
+  int32_t H4x2p20;   ///< dig_H4 * 2^20
+};
+#else
+/*! Calibration terms of the 64-bit formulas which don't depend on the readings, see
+ * BME280_Calibration for the other values. The 64-bit shifts are slow library calls on 8-bit
+ * processors */
+struct BME280_Coefficients {
+  int64_t P4x2p35;  ///< dig_P4 * 2^35
+  int64_t P5x2p17;  ///< dig_P5 * 2^17
+  int32_t P2x4096;  ///< dig_P2 * 4096
+  int32_t P7x16;    ///< dig_P7 * 16
+  int32_t T1x2;     ///< dig_T1 * 2
+  int32_t H4x2p20;  ///< dig_H4 * 2^20
+};
+#endif
+/*! Uncompensated readings, the measurement registers 0xF7-0xFE as read in a single burst */
+struct BME280_RawSample {
+  uint8_t data[BME280_RAW_DATA_LENGTH];  ///< Pressure, temperature and humidity ADC values
+};
+/*! Compensated readings */
+struct BME280_Reading {
+  int32_t temperature;  ///< Temperature in centi-degrees Celsius
+  int32_t humidity;     ///< Humidity in centi-percent
+  int32_t pressure;     ///< Pressure in Pascals
+};
+/*! Bus and timing statistics, collected when BME280_STATISTICS is defined */
+struct BME280_Statistics {
+  uint32_t transactions;   ///< Bus reads and writes
+  uint32_t bytes;          ///< Bytes transferred
+  uint32_t errors;         ///< Transfers which failed or were cut short, e.g. an I2C NAK
+  uint32_t statusPolls;    ///< Status register reads while waiting for measurements
+  uint32_t samples;        ///< Completed measurements
+  uint32_t compensations;  ///< Raw readings converted into temperature, humidity and pressure
+  uint32_t minLatency;     ///< Shortest measurement in microseconds
+  uint32_t maxLatency;     ///< Longest measurement in microseconds
+  uint64_t totalLatency;   ///< Sum of all measurement times in microseconds
+};
+/*! Data kept across power cycles for a warm start, see BME280_Device<>::begin() */
+struct BME280_WarmStart {
+  uint8_t            checksum;        ///< CRC-8 of all following bytes
+  uint8_t            address;         ///< I2C address, 0 for SPI
+  uint8_t            calibrationCrc;  ///< CRC-8 of the calibration registers
+  BME280_Calibration calibration;     ///< Decoded calibration values
+};
+/*! Complete set of measurement settings, written to the device in one go by apply() */
+struct BME280_Config {
+  uint8_t temperatureSampling;  ///< Temperature oversampling, see oversamplingTypes
+  uint8_t pressureSampling;     ///< Pressure oversampling, see oversamplingTypes
+  uint8_t humiditySampling;     ///< Humidity oversampling, see oversamplingTypes
+  uint8_t iirFilter;            ///< IIR filter coefficient, see iirFilterTypes
+  uint8_t inactiveTime;         ///< Standby time in normal mode, see inactiveTimeTypes
+  uint8_t mode;                 ///< Operating mode, see modeTypes
+};
+/*************************************************************************************************
+** Recommended settings for typical use cases, see section 3.5 of the datasheet                 **
+*************************************************************************************************/
+/*! Weather monitoring - forced mode once a minute, 1x oversampling and no filter */
+const BME280_Config BME280_WEATHER_MONITORING = {Oversample1, Oversample1, Oversample1,
+                                                 IIROff,      inactive1000ms, ForcedMode};
+/*! Humidity sensing - forced mode once a second, pressure off, 1x oversampling, no filter */
+const BME280_Config BME280_HUMIDITY_SENSING = {Oversample1, SensorOff, Oversample1,
+                                               IIROff,      inactive1000ms, ForcedMode};
+/*! Indoor navigation - normal mode, 0.5ms standby, pressure 16x, temperature 2x, filter 16 */
+const BME280_Config BME280_INDOOR_NAVIGATION = {Oversample2, Oversample16, Oversample1,
+                                                IIR16,       inactiveHalf, NormalMode};
+/*! Gaming - normal mode, 0.5ms standby, pressure 4x, temperature 1x, humidity off, filter 16 */
+const BME280_Config BME280_GAMING = {Oversample1, Oversample4, SensorOff,
+                                     IIR16,       inactiveHalf, NormalMode};
+
+inline namespace BME280_ENGINE {  // Conversion math depends on the engine, see BME280_Options.h
+class BME280_Core {
+  /*!
+    @class   BME280_Core
+    @brief   Bus-independent part of the BME280 class
+    @details Holds the calibration values and the conversion math, neither of which depend on how
+    the device is connected, so this code lives in the library's c++ file and is shared by every
+    BME280_Device<> instantiation
+  */
+ public:
+  BME280_Core();
+  ~BME280_Core();
+  void compensate(const BME280_RawSample raw[], BME280_Reading out[], const uint16_t count,
+                  const uint8_t channels = AllChannels) const;
+  const BME280_Calibration &calibration() const;
+  void                      calibration(const BME280_Calibration &cal);
+  static uint8_t crc8(const uint8_t *data, const uint8_t length, const uint8_t crc = 0xFF);
+
+ protected:
+  void                decodeCalibration(const BME280_CalibrationRegisters &regs);
+  void                prepareCoefficients();
+  void                compensate(const uint8_t registerBuffer[8]);
+  void                convert(const uint8_t registerBuffer[8], BME280_Reading &out,
+                              const uint8_t channels = AllChannels) const;
+  uint8_t             _mode = UINT8_MAX;                          ///< Last mode set
+  uint8_t             _regControlHumid = 0;                       ///< Copy of register 0xF2
+  uint8_t             _regControl      = 0;                       ///< Copy of register 0xF4
+  uint8_t             _regConfig       = 0;                       ///< Copy of register 0xF5
+  int32_t             _Temperature, _Pressure, _Humidity;         ///< Sensor global variables
+  BME280_Calibration  _cal  = {};                                 ///< Decoded calibration values
+  BME280_Coefficients _coef = {};                                 ///< Terms derived from _cal
+};                                                                // of class BME280_Core
+}  // namespace BME280_ENGINE
+#endif
@@ -0,0 +1,238 @@
+/*!
+ * @file BME280_Metrics.cpp
+ * @section BME280_Metricscpp_intro_section Description
+ *
+ * Arduino Library for the BME280 Bosch sensor\n\n
+ * This file contains the derived values declared in BME280_Metrics.h and doesn't use any Arduino
+ * functions\n\n
+ * See main library header file for details
+ */
+#include "BME280_Metrics.h"
+#if defined(__AVR__)
+#include <avr/pgmspace.h>  // The tables are kept in flash memory
+/*! @brief Reads a 32-bit table entry */
+#define BME280_TABLE_DWORD(entry) ((int32_t)pgm_read_dword(&(entry)))
+/*! @brief Reads a 16-bit table entry */
+#define BME280_TABLE_WORD(entry) ((uint16_t)pgm_read_word(&(entry)))
+#else
+#define PROGMEM  ///< Tables are ordinary constants on other processors
+/*! @brief Reads a 32-bit table entry */
+#define BME280_TABLE_DWORD(entry) (entry)
+/*! @brief Reads a 16-bit table entry */
+#define BME280_TABLE_WORD(entry) (entry)
+#endif
+/*************************************************************************************************
+** Altitude in centimeters for pressure / sea-level pressure ratios from 0.25 in steps of       **
+** 1/128, from 44330m * (1 - ratio ^ 0.190295). The last entry is only used to interpolate      **
+*************************************************************************************************/
+static const int32_t ALTITUDE[130] PROGMEM = {
+    1027909, 1007911, 988398, 969345, 950727, 932524, 914714, 897280, 880204, 863471, 847065,
+    830972, 815179, 799675, 784447, 769484, 754777, 740317, 726093, 712098, 698323, 684761, 671405,
+    658247, 645282, 632503, 619904, 607480, 595225, 583135, 571203, 559427, 547801, 536322, 524984,
+    513785, 502720, 491786, 480980, 470298, 459737, 449294, 438967, 428752, 418646, 408648, 398754,
+    388963, 379271, 369677, 360178, 350773, 341459, 332234, 323097, 314045, 305077, 296192, 287387,
+    278660, 270011, 261438, 252939, 244513, 236159, 227875, 219659, 211512, 203430, 195414, 187462,
+    179572, 171745, 163978, 156270, 148622, 141031, 133497, 126018, 118595, 111225, 103908, 96644,
+    89431, 82269, 75156, 68093, 61078, 54110, 47190, 40315, 33486, 26702, 19962, 13265, 6611, 0,
+    -6570, -13098, -19586, -26034, -32443, -38813, -45144, -51438, -57694, -63913, -70096, -76243,
+    -82355, -88431, -94473, -100481, -106455, -112396, -118304, -124180, -130023, -135835, -141616,
+    -147366, -153085, -158774, -164433, -170062, -175663, -181234, -186778, -192293, -197780
+};
+static const uint8_t  ALTITUDE_STEP  = 15;                 ///< Ratio bits below a table step
+static const uint32_t ALTITUDE_FIRST = (uint32_t)1 << 20;  ///< Ratio 0.25 with 22 fraction bits
+static const uint32_t ALTITUDE_LAST  = (uint32_t)5 << 20;  ///< Ratio 1.25 with 22 fraction bits
+/*! (2^(i/32) - 1) * 32768 for i = 0 to 32 */
+static const uint16_t EXP2[33] PROGMEM = {
+    0,     718,   1451,  2200,  2966,  3748,  4548,  5365,  6200,  7053,  7925,  8816,
+    9727,  10657, 11608, 12580, 13573, 14588, 15625, 16684, 17767, 18874, 20005, 21160,
+    22341, 23548, 24781, 26041, 27329, 28645, 29989, 31364, 32768};
+static const int32_t LN2        = 22713;   ///< ln(2) with 15 fraction bits
+static const int32_t LOG2E      = 47274;   ///< 1 / ln(2) with 15 fraction bits
+static const int32_t LOG2_10000 = 435413;  ///< log2(10000) with 15 fraction bits
+static const int32_t MAGNUS_B   = 1762;    ///< Magnus formula b = 17.62, times 100
+static const int32_t MAGNUS_C   = 24312;   ///< Magnus formula c = 243.12 degrees, times 100
+static const int32_t ZERO_C     = 27315;   ///< 0 degrees Celsius in centi-Kelvin
+static const int32_t ABSOLUTE   = 13244;   ///< 100 * 6.112hPa / 461.5J/(kg*K) * 10^4 in mg/m^3
+
+static int64_t divide(const int64_t dividend, const int64_t divisor) {
+  /*!
+   * @brief     returns the quotient rounded to the nearest integer
+   * @param[in] dividend Number to divide
+   * @param[in] divisor Positive number to divide by
+   * @return    rounded quotient
+   */
+  return ((dividend + (dividend < 0 ? -divisor : divisor) / 2) / divisor);
+}  // of function divide()
+static int32_t log2Fixed(uint32_t value) {
+  /*!
+   * @brief     returns the base 2 logarithm of a fixed-point number
+   * @details   The number is scaled to 1 <= value < 2 and each further result bit is found by
+   * squaring the value, so there is no table and the result is exact to the last bit
+   * @param[in] value Number with 15 fraction bits, must be greater than 0
+   * @return    logarithm with 15 fraction bits
+   */
+  int32_t result = 0;
+  while (value >= (uint32_t)2 << 15) {
+    value >>= 1;
+    result += (int32_t)1 << 15;
+  }  // of while-loop value too large
+  while (value < (uint32_t)1 << 15) {
+    value <<= 1;
+    result -= (int32_t)1 << 15;
+  }  // of while-loop value too small
+  for (int32_t bit = (int32_t)1 << 14; bit != 0; bit >>= 1) {
+    value = (value * value) >> 15;  // value < 2^16, so the square fits
+    if (value >= (uint32_t)2 << 15) {
+      value >>= 1;
+      result += bit;
+    }  // of if-then this bit is set
+  }    // of for-next each fraction bit
+  return (result);
+}  // of function log2Fixed()
+static uint32_t exp2Fraction(const uint16_t fraction) {
+  /*!
+   * @brief     returns 2 to the power of a fraction
+   * @param[in] fraction 0 <= fraction < 1 with 15 fraction bits
+   * @return    1 <= result < 2 with 15 fraction bits
+   */
+  uint8_t  index = fraction >> 10;  // 32 table steps
+  uint32_t low   = BME280_TABLE_WORD(EXP2[index]);
+  uint32_t high  = BME280_TABLE_WORD(EXP2[index + 1]);
+  return (((uint32_t)1 << 15) + low + (((high - low) * (fraction & 0x3FF) + 512) >> 10));
+}  // of function exp2Fraction()
+static int32_t magnus(const int32_t temperature) {
+  /*!
+   * @brief     returns the exponent of the Magnus formula, b * T / (c + T)
+   * @param[in] temperature Temperature in centi-degrees
+   * @return    exponent with 15 fraction bits
+   */
+  return ((int64_t)temperature * MAGNUS_B * ((int32_t)1 << 15) / 100 / (MAGNUS_C + temperature));
+}  // of function magnus()
+static int32_t altitudeOfRatio(uint32_t ratio) {
+  /*!
+   * @brief     returns the altitude for a pressure ratio
+   * @details   The altitude is interpolated with a parabola through 3 table entries, which is
+   * accurate to within 2 centimeters where straight lines between entries would be off by up to
+   * 50cm. Ratios outside of the table are limited to its range
+   * @param[in] ratio Pressure / sea-level pressure with 22 fraction bits
+   * @return    altitude in centimeters
+   */
+  if (ratio < ALTITUDE_FIRST) ratio = ALTITUDE_FIRST;
+  if (ratio >= ALTITUDE_LAST) ratio = ALTITUDE_LAST - 1;
+  ratio -= ALTITUDE_FIRST;
+  uint8_t index = ratio >> ALTITUDE_STEP;
+  int32_t part  = ratio & (((uint32_t)1 << ALTITUDE_STEP) - 1);  // Position between entries
+  int32_t first = BME280_TABLE_DWORD(ALTITUDE[index]);
+  int32_t slope = BME280_TABLE_DWORD(ALTITUDE[index + 1]) - first;
+  int32_t bend  = BME280_TABLE_DWORD(ALTITUDE[index + 2]) - first - 2 * slope;
+  int32_t curve = (part * (part - ((int32_t)1 << ALTITUDE_STEP))) >> (ALTITUDE_STEP + 1);
+  return (first + (((int64_t)slope * part + (int64_t)bend * curve) >> ALTITUDE_STEP));
+}  // of function altitudeOfRatio()
+int32_t BME280_Metrics::altitude(const int32_t pressure, const int32_t seaLevel) {
+  /*!
+   * @brief     returns the altitude above the given sea-level pressure
+   * @details   The pressure ratio is computed with 22 fraction bits and looked up in the altitude
+   * table. Ratios outside of 0.25 to 1.25 are limited to that range
+   * @param[in] pressure Pressure in Pascals
+   * @param[in] seaLevel Sea-level pressure in Pascals, by default the standard 101325Pa
+   * @return    altitude in centimeters
+   */
+  if (pressure <= 0 || seaLevel <= 0) return (0);
+  uint32_t ratio = ((uint32_t)pressure << 14) / seaLevel;  // pressure < 262144, so it fits
+  uint32_t rest  = ((uint32_t)pressure << 14) % seaLevel;
+  return (altitudeOfRatio((ratio << 8) + (rest << 8) / seaLevel));  // 22 fraction bits
+}  // of method altitude()
+int32_t BME280_Metrics::seaLevelPressure(const int32_t pressure, const int32_t altitude) {
+  /*!
+   * @brief     returns the pressure at sea level for a pressure measured at a known altitude
+   * @details   The pressure ratio for the altitude is found in the same table as for altitude(),
+   * first between the two entries around it and then refined with one Newton step
+   * @param[in] pressure Pressure in Pascals
+   * @param[in] altitude Altitude in centimeters, from -1900m to 10000m
+   * @return    sea-level pressure in Pascals
+   */
+  uint8_t first = 0, last = 128;  // Binary search, the table values decrease
+  while (last - first > 1) {
+    uint8_t middle = (first + last) / 2;
+    if (BME280_TABLE_DWORD(ALTITUDE[middle]) >= altitude)
+      first = middle;
+    else
+      last = middle;
+  }  // of while-loop search
+  int32_t  step  = BME280_TABLE_DWORD(ALTITUDE[first]) - BME280_TABLE_DWORD(ALTITUDE[last]);
+  int32_t  above = BME280_TABLE_DWORD(ALTITUDE[first]) - altitude;
+  uint32_t ratio = ALTITUDE_FIRST + ((uint32_t)first << ALTITUDE_STEP);
+  if (above > 0) ratio += (((int64_t)(above < step ? above : step) << ALTITUDE_STEP) / step);
+  ratio += ((int64_t)(altitudeOfRatio(ratio) - altitude) << ALTITUDE_STEP) / step;  // Newton
+  return ((((int64_t)pressure << 22) + ratio / 2) / ratio);
+}  // of method seaLevelPressure()
+int32_t BME280_Metrics::dewPoint(const int32_t temperature, const int32_t humidity) {
+  /*!
+   * @brief     returns the dew point, the temperature at which the humidity would be 100%
+   * @details   gamma = ln(RH) + b * T / (c + T) and dew point = c * gamma / (b - gamma)
+   * @param[in] temperature Temperature in centi-degrees
+   * @param[in] humidity Relative humidity in centi-percent, 0.01% is used for 0
+   * @return    dew point in centi-degrees
+   */
+  uint32_t relative = (humidity < 1 ? 1 : humidity > 10000 ? 10000 : humidity);
+  int32_t  gamma    = ((int64_t)(log2Fixed(relative << 15) - LOG2_10000) * LN2 >> 15) +
+                  magnus(temperature);  // 15 fraction bits
+  return (divide((int64_t)MAGNUS_C * gamma, ((int64_t)MAGNUS_B << 15) / 100 - gamma));
+}  // of method dewPoint()
+int32_t BME280_Metrics::absoluteHumidity(const int32_t temperature, const int32_t humidity) {
+  /*!
+   * @brief     returns the mass of water vapour per volume of air
+   * @details   The saturation vapour pressure 6.112hPa * e^(b * T / (c + T)) times the relative
+   * humidity is divided by the specific gas constant of water vapour and the absolute temperature
+   * @param[in] temperature Temperature in centi-degrees
+   * @param[in] humidity Relative humidity in centi-percent
+   * @return    absolute humidity in mg/m^3
+   */
+  if (humidity <= 0) return (0);
+  int32_t  power    = (int64_t)magnus(temperature) * LOG2E >> 15;  // e^x = 2^(x / ln(2))
+  int8_t   shift    = power >> 15;                                 // Integer part, rounded down
+  uint64_t vapour   = (uint64_t)ABSOLUTE * exp2Fraction(power & 0x7FFF) * humidity;
+  uint64_t divisor  = (uint64_t)(ZERO_C + temperature) << 15;
+  if (shift >= 0)
+    vapour <<= shift;
+  else
+    divisor <<= -shift;
+  return ((vapour + divisor / 2) / divisor);
+}  // of method absoluteHumidity()
+int32_t BME280_Metrics::heatIndex(const int32_t temperature, const int32_t humidity) {
+  /*!
+   * @brief     returns the heat index, the temperature felt by a person in the shade
+   * @details   As described by the US National Weather Service the simple formula is used when its
+   * average with the temperature is below 80F, otherwise the Rothfusz regression together with
+   * the adjustments for low and high humidity. The regression is computed in milli-Fahrenheit,
+   * which holds centi-degrees Celsius exactly, with the coefficients scaled by 10^8 in 64-bit
+   * integers. Results only differ from the floating point formulas by more than 0.01 degrees where
+   * rounding puts the two on different sides of the 80F switch-over
+   * @param[in] temperature Temperature in centi-degrees
+   * @param[in] humidity Relative humidity in centi-percent
+   * @return    heat index in centi-degrees
+   */
+  int64_t t     = (int64_t)temperature * 18 + 32000;  // milli-Fahrenheit
+  int64_t r     = humidity;
+  int64_t index = (t + 61000 + (t - 68000) * 12 / 10 + r * 94 / 100) / 2;  // Simple formula
+  if ((index + t) / 2 >= 80000) {
+    int64_t t2 = t * t, r2 = r * r;
+    index      = divide(-4237900000LL + 204901523LL * t / 1000 + 1014333127LL * r / 100 -
+                       22475541LL * t * r / 100000 - 683783LL * t2 / 1000000 -
+                       5481717LL * r2 / 10000 + 122874LL * (t2 * r / 1000) / 100000 +
+                       85282LL * t * r2 / 10000000 - 199LL * (t2 * r2 / 1000000) / 10000,
+                   100000);  // Rothfusz regression, 10^-8 F to milli-F
+    if (r < 1300 && t >= 80000 && t <= 112000) {
+      int32_t  offset = t > 95000 ? t - 95000 : 95000 - t;
+      uint32_t ratio  = ((uint32_t)(17000 - offset) << 15) / 17000;  // (17 - |T - 95|) / 17
+      int32_t  root   = 0;                                          // Square root of the ratio
+      if (ratio != 0) {
+        int32_t power = log2Fixed(ratio) >> 1;  // sqrt(x) = 2^(log2(x) / 2), at most 0
+        root          = exp2Fraction(power & 0x7FFF) >> -(power >> 15);
+      }  // of if-then ratio isn't 0
+      index -= divide((1300 - r) * 5 * root, (int64_t)2 << 15);
+    }  // of if-then low humidity adjustment
+    if (r > 8500 && t >= 80000 && t <= 87000) index += divide((r - 8500) * (87000 - t), 5000);
+  }  // of if-then use the regression
+  return (divide((index - 32000) * 5, 90));
+}  // of method heatIndex()
@@ -0,0 +1,52 @@
+/*!
+ @file BME280_Metrics.h
+
+ @section BME280_Metrics_intro_section Description
+
+ Derived values computed from the readings returned by getSensorData()\n\n
+
+ Altitude, sea-level pressure, dew point, absolute humidity and heat index are computed with
+ integer arithmetic only, so using them doesn't pull the floating point pow(), log() and exp()
+ functions into a program. The altitude uses a table of the barometric formula interpolated with
+ parabolas, the other values use fixed-point logarithm and power-of-2 functions. The inputs and
+ results use the same units as the library, i.e. centi-degrees Celsius, centi-percent and Pascals.
+ The largest differences to the floating point formulas over the sensor's operating range, as
+ checked by test/test_metrics.cpp, are:
+
+ Value              | Unit          | Largest error
+ ------------------ | ------------- | -----------------------------------------------------
+ altitude()         | centimeters   | 2cm for pressure ratios of 0.26 to 1.25, 3cm from 0.25
+ seaLevelPressure() | Pascals       | 2Pa from -1900m to 10000m
+ dewPoint()         | centi-degrees | 1, i.e. 0.01 degrees, for 1% to 100% humidity
+ absoluteHumidity() | mg/m^3        | 0.02% of the value plus 1mg/m^3
+ heatIndex()        | centi-degrees | 1 for heat indices up to 60 degrees, see heatIndex()
+
+ The code only depends on BME280_Core.h, so it can also be run on a computer.\n\n
+
+ See main library header file for details
+*/
+#ifndef BME280_Metrics_h
+/*! @brief Define guard code to prevent multiple inclusions */
+#define BME280_Metrics_h
+#include "BME280_Core.h"  // Include the BME280 Sensor library types
+
+/*! @brief Standard sea-level pressure in Pascals */
+const int32_t BME280_SEA_LEVEL_PRESSURE = 101325;
+
+class BME280_Metrics {
+  /*!
+    @class   BME280_Metrics
+    @brief   Integer-only derived values, all methods are static
+    @details The formulas are the international barometric formula for altitude and sea-level
+    pressure, the Magnus formula with the Sonntag constants for the saturation vapour pressure and
+    dew point, and the Rothfusz regression with the NWS adjustments for the heat index
+  */
+ public:
+  static int32_t altitude(const int32_t pressure,
+                          const int32_t seaLevel = BME280_SEA_LEVEL_PRESSURE);
+  static int32_t seaLevelPressure(const int32_t pressure, const int32_t altitude);
+  static int32_t dewPoint(const int32_t temperature, const int32_t humidity);
+  static int32_t absoluteHumidity(const int32_t temperature, const int32_t humidity);
+  static int32_t heatIndex(const int32_t temperature, const int32_t humidity);
+};  // of class BME280_Metrics
+#endif
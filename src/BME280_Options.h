@@ -0,0 +1,55 @@
+/*!
+ @file BME280_Options.h
+
+ @section BME280_Options_intro_section Description
+
+ Library-wide build options of the BME280 library\n\n
+
+ The options in this file change the code in the library's c++ files as well as in the headers, so
+ every file of a program has to see the same values. They can only be set in one of two ways:
+ - by editing the default values below, or
+ - as a compiler option for all files of the build, e.g. -DBME280_COMPENSATION=1 in the
+   "build_flags" of PlatformIO or the "compiler.cpp.extra_flags" of the Arduino platform.
+
+ A "#define" in a sketch before including BME280.h only reaches the sketch and not the library's
+ c++ files. The classes which depend on the compensation engine are therefore placed in an inline
+ namespace named after the engine, so a program which mixes engines fails to link with undefined
+ references to e.g. "bme280_int32::BME280_Core" instead of silently using the wrong math.\n\n
+
+ The options are:
+ - BME280_COMPENSATION selects the compensation engine, see below.
+ - BME280_STATISTICS, if defined, adds the bus and timing counters of BME280_Device<>::statistics().
+   The counters change the size and layout of the device class, so the same rule applies: a file
+   which sees a different setting than the others breaks the one definition rule, and the device
+   objects are then accessed with the wrong layout without any error from the compiler or linker.
+   Define it as a compiler option only, never in a sketch.\n\n
+
+ See main library header file for details
+*/
+#ifndef BME280_Options_h
+/*! @brief Define guard code to prevent multiple inclusions */
+#define BME280_Options_h
+
+/*! @brief Compensation using 64-bit integers, the datasheet's most accurate integer formulas */
+#define BME280_COMPENSATION_INT64 0
+/*! @brief Compensation using only 32-bit integers, much faster on 8-bit processors */
+#define BME280_COMPENSATION_INT32 1
+/*! @brief Compensation using the datasheet's floating point formulas */
+#define BME280_COMPENSATION_FLOAT 2
+#ifndef BME280_COMPENSATION
+/*! @brief Selected compensation engine, one of the BME280_COMPENSATION_* values. See above for how
+ * to change it */
+#define BME280_COMPENSATION BME280_COMPENSATION_INT64
+#endif
+
+#if BME280_COMPENSATION == BME280_COMPENSATION_INT64
+/*! @brief Inline namespace of the classes which depend on the compensation engine */
+#define BME280_ENGINE bme280_int64
+#elif BME280_COMPENSATION == BME280_COMPENSATION_INT32
+#define BME280_ENGINE bme280_int32
+#elif BME280_COMPENSATION == BME280_COMPENSATION_FLOAT
+#define BME280_ENGINE bme280_float
+#else
+#error "BME280_COMPENSATION must be BME280_COMPENSATION_INT64, _INT32 or _FLOAT"
+#endif
+#endif
@@ -0,0 +1,200 @@
+/*!
+ @file BME280_Replay.h
+
+ @section BME280_Replay_intro_section Description
+
+ Replaying the register traffic recorded by BME280_TraceBus of BME280_Trace.h\n\n
+
+ BME280_ReplayBus is a bus policy which answers the library's transfers from a trace instead of a
+ device, so the behaviour of a field unit can be reproduced and benchmarked on a computer. It also
+ supplies the time functions of the bus policy from the recorded times, so the library sees the
+ timing of the field unit and a replay doesn't depend on the clock of the computer.\n\n
+
+ Trace layout, multi-byte values are little-endian. The first 4 bytes are the micros() value of
+ the first record. Each record starts with a byte holding the data length in bits 5-0, bit 6 set
+ if fewer bytes than requested were transferred and bit 7 set for writes. It is followed by the
+ register, the microseconds since the previous record with 7 bits per byte and the top bit set
+ when more bytes follow, which is ignored for the first record, and the data.\n\n
+
+ The code only depends on BME280_Core.h and not on the Arduino core.\n\n
+
+ See main library header file for details
+*/
+#ifndef BME280_Replay_h
+/*! @brief Define guard code to prevent multiple inclusions */
+#define BME280_Replay_h
+#include "BME280_Core.h"  // Register map
+
+const uint8_t BME280_TRACE_WRITE  = 0x80;  ///< Record flag for a write
+const uint8_t BME280_TRACE_SHORT  = 0x40;  ///< Record flag for a short or failed transfer
+const uint8_t BME280_TRACE_LENGTH = 0x3F;  ///< Record mask for the number of data bytes
+
+class BME280_ReplayBus {
+  /*!
+    @class   BME280_ReplayBus
+    @brief   Bus policy which answers transfers from a recorded trace instead of a device
+    @details Each read returns the recorded bytes and each write is checked against the recorded
+    one. The number of status register polls depends on timing, so polls are skipped or answered
+    with "not busy" when the library polls fewer or more times than recorded. micros() returns the
+    recorded time of the last transfer, or that of the next one when it is called again without a
+    transfer in between, so a wait for the next transfer ends when it did on the field unit.
+    delay() returns at once as the recorded times include the waits, so a replay of an unchanged
+    library has no mismatches() and doesn't depend on the speed of the computer
+  */
+ public:
+  bool begin(const uint8_t *trace, const uint16_t length) {
+    /*!
+     * @brief     Starts replaying a trace
+     * @param[in] trace Trace as written by copyTrace() or dump()
+     * @param[in] length Number of bytes in the trace
+     * @return    returns "false" if the trace holds no records
+     */
+    if (length <= 4) return false;
+    _trace      = trace;
+    _length     = length;
+    _position   = 4;
+    _time       = 0;
+    _mismatches = 0;
+    _waiting    = false;
+    for (uint8_t i = 0; i < 4; i++) _time |= (uint32_t)trace[i] << 8 * i;
+    return true;
+  }  // of method begin()
+  uint8_t read(const uint8_t addr, uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     returns the bytes of the next recorded read of the register
+     * @param[in] addr Register address
+     * @param[out] buffer Storage for the bytes read
+     * @param[in] length Number of bytes to read
+     * @return    Number of bytes recorded, 0 if the trace doesn't match
+     */
+    if (!seek(0, addr)) {
+      if (addr != BME280_STATUS_REG) return (0);
+      buffer[0] = 0;  // An extra poll finds the device idle
+      return (1);
+    }  // of if-then no matching record
+    uint8_t recorded = advance();  // Bytes in the trace
+    uint8_t bytes    = recorded < length ? recorded : length;
+    for (uint8_t i = 0; i < bytes; i++) buffer[i] = _trace[_data + i];
+    if (recorded != length && !(_trace[_record] & BME280_TRACE_SHORT)) _mismatches++;
+    return (bytes);
+  }  // of method read()
+  uint8_t write(const uint8_t addr, const uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     checks a write against the next recorded write of the register
+     * @param[in] addr Register address
+     * @param[in] buffer Bytes to write
+     * @param[in] length Number of bytes to write
+     * @return    Number of bytes written, 0 if the recorded write failed or doesn't match
+     */
+    if (!seek(BME280_TRACE_WRITE, addr)) return (0);
+    uint8_t recorded = advance();  // Bytes in the trace
+    bool    same     = (recorded == length);
+    for (uint8_t i = 0; same && i < length; i++) same = (buffer[i] == _trace[_data + i]);
+    if (!same) _mismatches++;
+    return ((_trace[_record] & BME280_TRACE_SHORT) ? 0 : length);
+  }  // of method write()
+  uint32_t micros() {
+    /*!
+     * @brief     returns the recorded micros() value of the last transfer, or of the next one if
+     * there was no transfer since the last call
+     * @return    time in microseconds
+     */
+    if (!_waiting) {
+      _waiting = true;  // The next call is waiting for a transfer
+      return (_time);
+    }  // of if-then first call since the last transfer
+    if (_position == 4 || finished()) return (_time);  // The first record is at the start time
+    uint32_t delta = 0;
+    uint16_t index = _position + 2;  // Skip header and register
+    for (uint8_t shift = 0; index < _length; shift += 7) {
+      delta |= (uint32_t)(_trace[index] & 0x7F) << shift;
+      if (!(_trace[index++] & 0x80)) break;
+    }  // of for-next each time byte
+    return (_time + delta);
+  }  // of method micros()
+  uint32_t millis() {
+    /*!
+     * @brief     returns the recorded time in milliseconds, see micros()
+     * @return    time in milliseconds
+     */
+    return (micros() / 1000);
+  }  // of method millis()
+  void delay(const uint32_t ms) const {
+    /*!
+     * @brief     returns at once, the recorded times already include the wait
+     * @param[in] ms Milliseconds the library waits, unused
+     */
+    (void)ms;
+  }  // of method delay()
+  uint32_t time() const {
+    /*!
+     * @brief     returns the recorded micros() value of the last transfer replayed
+     * @return    time in microseconds
+     */
+    return (_time);
+  }  // of method time()
+  uint16_t mismatches() const {
+    /*!
+     * @brief     returns the number of transfers which differed from the trace
+     * @return    number of differences, including extra and skipped status polls
+     */
+    return (_mismatches);
+  }  // of method mismatches()
+  bool finished() const {
+    /*!
+     * @brief     returns whether all records have been replayed
+     * @return    returns "true" at the end of the trace
+     */
+    return (_position >= _length);
+  }  // of method finished()
+
+ private:
+  bool seek(const uint8_t direction, const uint8_t addr) {
+    /*!
+     * @brief     moves to the next record for a transfer, skipping status polls the library didn't
+     * make
+     * @param[in] direction BME280_TRACE_WRITE or 0 for a read
+     * @param[in] addr Register address
+     * @return    returns "true" if the next record matches the transfer
+     */
+    while (_position + 2 < _length) {
+      uint8_t header = _trace[_position];
+      if ((header & BME280_TRACE_WRITE) == direction && _trace[_position + 1] == addr) return true;
+      if ((header & BME280_TRACE_WRITE) || _trace[_position + 1] != BME280_STATUS_REG) break;
+      advance();  // Skip a recorded status poll
+      _mismatches++;
+    }  // of while-loop records left
+    _mismatches++;
+    return false;
+  }  // of method seek()
+  uint8_t advance() {
+    /*!
+     * @brief     moves past the record at the current position, noting its time and data
+     * @return    Number of data bytes, less than recorded if the trace is cut off
+     */
+    uint8_t  length = _trace[_position] & BME280_TRACE_LENGTH;
+    uint32_t delta  = 0;
+    _record         = _position;
+    _waiting        = false;
+    _position += 2;
+    for (uint8_t shift = 0; _position < _length; shift += 7) {
+      uint8_t value = _trace[_position++];
+      delta |= (uint32_t)(value & 0x7F) << shift;
+      if (!(value & 0x80)) break;
+    }                                  // of for-next each time byte
+    if (_record != 4) _time += delta;  // The first record is at the start time
+    _data = _position;
+    if (_length - _position < length) length = _length - _position;
+    _position += length;
+    return (length);
+  }  // of method advance()
+  const uint8_t *_trace      = nullptr;  ///< Trace being replayed
+  uint16_t       _length     = 0;        ///< Bytes in the trace
+  uint16_t       _position   = 0;        ///< Next record
+  uint16_t       _record     = 0;        ///< Last record replayed
+  uint16_t       _data       = 0;        ///< Data of the last record replayed
+  uint32_t       _time       = 0;        ///< micros() value of the last record replayed
+  uint16_t       _mismatches = 0;        ///< Transfers which differed from the trace
+  bool           _waiting    = false;    ///< micros() was called since the last transfer
+};                                       // of class BME280_ReplayBus
+#endif
@@ -0,0 +1,214 @@
+/*!
+ @file BME280_SampleRing.h
+
+ @section BME280_SampleRing_intro_section Description
+
+ Fixed-size ring buffer for timestamped BME280 readings\n\n
+
+ The ring buffer is sized at compile time and uses no dynamic memory. The readings are stored as
+ separate arrays per value (struct-of-arrays) using the smallest data type which holds the range of
+ the compensated values, which takes 12 bytes per sample. One producer (e.g. the measurement loop)
+ and one consumer (e.g. an interrupt routine or a task on a second core) can use the buffer at the
+ same time without locking. The producer also keeps a running minimum, maximum and mean of the last
+ N samples pushed which are updated with each new sample rather than by rescanning the buffer.\n\n
+
+ The running minimum and maximum need two queues of sample indices per value, another 6 bytes per
+ sample for buffers of up to 128 samples and 12 bytes for larger ones, so a sample takes 18 or 24
+ bytes in all. A 64 sample buffer uses about 1.1KB, more than half of the RAM of an ATmega328P, so
+ on AVR processors a buffer which needs more than half of the RAM doesn't compile. With the MinMax
+ template parameter set to false the queues are left out and a sample takes 12 bytes, mean() is
+ still available.\n\n
+
+ See main library header file for details
+*/
+#ifndef BME280_SampleRing_h
+/*! @brief Define guard code to prevent multiple inclusions */
+#define BME280_SampleRing_h
+#include "BME280_Core.h"  // Include the BME280 Sensor library types
+
+#if defined(__AVR__)
+#include <avr/io.h>  // RAMSTART and RAMEND for the size check
+/*! @brief Single-core AVR processors only need the compiler not to reorder memory accesses */
+#define BME280_MEMORY_BARRIER() __asm__ __volatile__("" ::: "memory")
+#else
+/*! @brief Other processors might reorder memory accesses or have more than one core */
+#define BME280_MEMORY_BARRIER() __sync_synchronize()
+#endif
+
+/*! @brief Index type selection, 8 bits are used for small buffers so that access is atomic */
+template <bool Small>
+struct BME280_RingIndex {
+  typedef uint16_t type;  ///< Index type for buffers with more than 128 samples
+};
+/*! @brief Index type selection, 8 bits are used for small buffers so that access is atomic */
+template <>
+struct BME280_RingIndex<true> {
+  typedef uint8_t type;  ///< Index type for buffers with up to 128 samples
+};
+
+template <uint16_t N, bool MinMax = true>
+class BME280_SampleRing {
+  /*!
+    @class   BME280_SampleRing
+    @brief   Lock-free single-producer / single-consumer ring buffer of N timestamped samples
+    @details N must be a power of 2. push() and the minimum(), maximum() and mean() methods belong
+    to the producer, pop() and available() to the consumer. The summary methods cover the last N
+    samples pushed, regardless of whether they have already been read with pop(). The sensor
+    parameter of the summary methods is one of TemperatureSensor, HumiditySensor or PressureSensor.
+    If MinMax is false minimum() and maximum() don't compile and their queues shrink to one entry
+  */
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "Ring buffer size must be a power of 2");
+  static_assert(N <= 16384, "Ring buffer size too large for the running sums");
+#if defined(__AVR__)
+  static_assert(N <= 128, "AVR ring buffers are limited to 128 samples for atomic indices");
+#if defined(RAMSTART) && defined(RAMEND)
+  static_assert((uint32_t)N * (MinMax ? 18 : 12) <= (RAMEND - RAMSTART + 1UL) / 2,
+                "Ring buffer would use more than half of the RAM, use a smaller N or MinMax false");
+#endif
+#endif
+  typedef typename BME280_RingIndex<(N <= 128)>::type index_t;  ///< Free-running index type
+  static const uint16_t Q = MinMax ? N : 1;  ///< Entries of each minimum and maximum queue
+
+ public:
+  bool push(const uint32_t timestamp, const int32_t temp, const int32_t hum,
+            const int32_t press) {
+    /*!
+     * @brief     Adds a sample to the buffer, called by the producer only
+     * @param[in] timestamp Time of the sample, e.g. from millis()
+     * @param[in] temp Temperature in centi-degrees Celsius
+     * @param[in] hum Humidity in centi-percent
+     * @param[in] press Pressure in Pascals
+     * @return    returns "false" if the buffer is full because the consumer hasn't kept up
+     */
+    index_t head = _head;                            // Only the producer changes this
+    if ((index_t)(head - _tail) >= N) return false;  // Buffer is full
+    if (_windowCount == N)                           // Oldest sample leaves the window
+    {
+      index_t oldest = head - N;  // Its slot is the one reused below
+      for (uint8_t sensor = 0; sensor < UnknownSensor; sensor++) {
+        _sum[sensor] -= value(sensor, oldest);
+        if (!MinMax) continue;  // No queues to update
+        if (_minQueue[sensor][_minFront[sensor] & (Q - 1)] == oldest) _minFront[sensor]++;
+        if (_maxQueue[sensor][_maxFront[sensor] & (Q - 1)] == oldest) _maxFront[sensor]++;
+      }  // of for-next each sensor
+    } else {
+      _windowCount++;
+    }                                 // of if-then-else window is full
+    uint16_t slot      = head & (N - 1);  // Position in the arrays
+    _timestamp[slot]   = timestamp;
+    _temperature[slot] = (int16_t)temp;
+    _humidity[slot]    = (uint16_t)hum;
+    _pressure[slot]    = press;
+    for (uint8_t sensor = 0; sensor < UnknownSensor; sensor++) {
+      int32_t newValue = value(sensor, head);
+      _sum[sensor] += newValue;
+      if (!MinMax) continue;                           // No queues to update
+      while (_minBack[sensor] != _minFront[sensor] &&  // Drop larger values from the back
+             value(sensor, _minQueue[sensor][(index_t)(_minBack[sensor] - 1) & (Q - 1)]) >=
+                 newValue)
+        _minBack[sensor]--;
+      _minQueue[sensor][_minBack[sensor]++ & (Q - 1)] = head;
+      while (_maxBack[sensor] != _maxFront[sensor] &&  // Drop smaller values from the back
+             value(sensor, _maxQueue[sensor][(index_t)(_maxBack[sensor] - 1) & (Q - 1)]) <=
+                 newValue)
+        _maxBack[sensor]--;
+      _maxQueue[sensor][_maxBack[sensor]++ & (Q - 1)] = head;
+    }                         // of for-next each sensor
+    BME280_MEMORY_BARRIER();  // Sample must be complete before it is published
+    _head = head + 1;         // Publish the sample to the consumer
+    return true;
+  }  // of method push()
+  bool pop(uint32_t &timestamp, int32_t &temp, int32_t &hum, int32_t &press) {
+    /*!
+     * @brief      Removes the oldest sample from the buffer, called by the consumer only
+     * @param[out] timestamp Time of the sample
+     * @param[out] temp Temperature in centi-degrees Celsius
+     * @param[out] hum Humidity in centi-percent
+     * @param[out] press Pressure in Pascals
+     * @return     returns "false" if the buffer is empty
+     */
+    index_t tail = _tail;             // Only the consumer changes this
+    if (tail == _head) return false;  // Buffer is empty
+    BME280_MEMORY_BARRIER();          // Read the sample only after checking the index
+    uint16_t slot = tail & (N - 1);   // Position in the arrays
+    timestamp     = _timestamp[slot];
+    temp          = _temperature[slot];
+    hum           = _humidity[slot];
+    press         = _pressure[slot];
+    BME280_MEMORY_BARRIER();  // Sample must be read before the slot is released
+    _tail = tail + 1;         // Release the slot to the producer
+    return true;
+  }  // of method pop()
+  uint16_t available() const {
+    /*!
+     * @brief     returns the number of samples which can be read with pop()
+     * @return    number of samples in the buffer
+     */
+    return ((index_t)(_head - _tail));
+  }  // of method available()
+  uint16_t windowSize() const {
+    /*!
+     * @brief     returns the number of samples covered by minimum(), maximum() and mean()
+     * @return    number of samples, at most N
+     */
+    return (_windowCount);
+  }  // of method windowSize()
+  int32_t minimum(const uint8_t sensor) const {
+    /*!
+     * @brief     returns the smallest value of the last N samples pushed
+     * @param[in] sensor TemperatureSensor, HumiditySensor or PressureSensor
+     * @return    smallest value, 0 if there are no samples
+     */
+    static_assert(MinMax, "minimum() needs a BME280_SampleRing with MinMax true");
+    if (sensor >= UnknownSensor || _windowCount == 0) return (0);
+    return (value(sensor, _minQueue[sensor][_minFront[sensor] & (Q - 1)]));
+  }  // of method minimum()
+  int32_t maximum(const uint8_t sensor) const {
+    /*!
+     * @brief     returns the largest value of the last N samples pushed
+     * @param[in] sensor TemperatureSensor, HumiditySensor or PressureSensor
+     * @return    largest value, 0 if there are no samples
+     */
+    static_assert(MinMax, "maximum() needs a BME280_SampleRing with MinMax true");
+    if (sensor >= UnknownSensor || _windowCount == 0) return (0);
+    return (value(sensor, _maxQueue[sensor][_maxFront[sensor] & (Q - 1)]));
+  }  // of method maximum()
+  int32_t mean(const uint8_t sensor) const {
+    /*!
+     * @brief     returns the average value of the last N samples pushed
+     * @param[in] sensor TemperatureSensor, HumiditySensor or PressureSensor
+     * @return    average value, 0 if there are no samples
+     */
+    if (sensor >= UnknownSensor || _windowCount == 0) return (0);
+    return (_sum[sensor] / (int32_t)_windowCount);
+  }  // of method mean()
+
+ private:
+  int32_t value(const uint8_t sensor, const index_t index) const {
+    /*!
+     * @brief     returns the stored value of one sensor for a sample
+     * @param[in] sensor TemperatureSensor, HumiditySensor or PressureSensor
+     * @param[in] index Free-running sample index
+     * @return    stored value
+     */
+    uint16_t slot = index & (N - 1);
+    if (sensor == TemperatureSensor) return (_temperature[slot]);
+    if (sensor == HumiditySensor) return (_humidity[slot]);
+    return (_pressure[slot]);
+  }                                  // of method value()
+  uint32_t         _timestamp[N];    ///< Sample times
+  int16_t          _temperature[N];  ///< Temperatures, -4000 to 8500
+  uint16_t         _humidity[N];     ///< Humidities, 0 to 10000
+  int32_t          _pressure[N];     ///< Pressures, 30000 to 110000
+  volatile index_t _head        = 0;  ///< Next sample to write, owned by the producer
+  volatile index_t _tail        = 0;  ///< Next sample to read, owned by the consumer
+  uint16_t         _windowCount = 0;  ///< Samples covered by the summary values
+  int32_t          _sum[UnknownSensor] = {};      ///< Running sums for mean()
+  index_t          _minQueue[UnknownSensor][Q];   ///< Candidate minimum samples, ascending
+  index_t          _maxQueue[UnknownSensor][Q];   ///< Candidate maximum samples, descending
+  index_t          _minFront[UnknownSensor] = {};  ///< Oldest entry of the minimum queue
+  index_t          _minBack[UnknownSensor]  = {};  ///< Next free entry of the minimum queue
+  index_t          _maxFront[UnknownSensor] = {};  ///< Oldest entry of the maximum queue
+  index_t          _maxBack[UnknownSensor]  = {};  ///< Next free entry of the maximum queue
+};                                                 // of class BME280_SampleRing
+#endif
@@ -0,0 +1,196 @@
+/*!
+ @file BME280_Trace.h
+
+ @section BME280_Trace_intro_section Description
+
+ Recording the register traffic between the library and a BME280\n\n
+
+ BME280_TraceBus<Bus, Size> is a bus policy which passes all transfers on to another bus policy
+ and records them in a fixed-size buffer, keeping the most recent ones when it is full. Each
+ record holds the direction, the register, the time since the previous record and the bytes
+ transferred, the layout is described in BME280_Replay.h. dump() writes the records as
+ hexadecimal text, e.g. to Serial, one record per line. The output of dump() turns back into a
+ trace e.g. with "xxd -r -p", which BME280_ReplayBus of BME280_Replay.h plays back on a computer
+ without the Arduino core.\n\n
+
+ See main library header file for details
+*/
+#ifndef BME280_Trace_h
+/*! @brief Define guard code to prevent multiple inclusions */
+#define BME280_Trace_h
+#include "BME280.h"         // Include the BME280 Sensor library
+#include "BME280_Replay.h"  // Trace layout
+
+template <class Bus, uint16_t Size = 256>
+class BME280_TraceBus : public Bus {
+  /*!
+    @class   BME280_TraceBus
+    @brief   Bus policy which records the transfers of another bus policy
+    @details Used in place of the bus policy, e.g. BME280_Device<BME280_TraceBus<BME280_I2CBus>>,
+    all other methods of the bus policy are inherited. The trace is reached with bus(). Size is
+    the buffer size in bytes, a status poll takes 4 bytes and reading the measurements 11
+  */
+  static_assert(Size >= 8 && Size <= 32768, "Trace buffer size out of range");
+
+ public:
+  uint8_t read(const uint8_t addr, uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     Reads from the device and records the transfer
+     * @param[in] addr Register address
+     * @param[out] buffer Storage for the bytes read
+     * @param[in] length Number of bytes to read
+     * @return    Number of bytes actually read
+     */
+    uint8_t bytesRead = Bus::read(addr, buffer, length);
+    record(bytesRead < length ? BME280_TRACE_SHORT : 0, addr, buffer, bytesRead);
+    return (bytesRead);
+  }  // of method read()
+  uint8_t write(const uint8_t addr, const uint8_t *buffer, const uint8_t length) {
+    /*!
+     * @brief     Writes to the device and records the transfer
+     * @param[in] addr Register address
+     * @param[in] buffer Bytes to write
+     * @param[in] length Number of bytes to write
+     * @return    Number of bytes written
+     */
+    uint8_t bytesWritten = Bus::write(addr, buffer, length);
+    record(BME280_TRACE_WRITE | (bytesWritten < length ? BME280_TRACE_SHORT : 0), addr, buffer,
+           length);
+    return (bytesWritten);
+  }  // of method write()
+  void tracing(const bool enabled) {
+    /*!
+     * @brief     Switches recording on or off, it is on by default
+     * @param[in] enabled "true" to record transfers
+     */
+    _enabled = enabled;
+  }  // of method tracing()
+  void clearTrace() {
+    /*!
+     * @brief     Removes all records
+     */
+    _head = _tail = 0;
+    _dropped      = 0;
+  }  // of method clearTrace()
+  uint16_t traceLength() const {
+    /*!
+     * @brief     returns the number of bytes of the trace without the 4-byte start time
+     * @return    bytes used in the buffer
+     */
+    return ((_head - _tail + Size) % Size);
+  }  // of method traceLength()
+  uint32_t dropped() const {
+    /*!
+     * @brief     returns the number of records removed to make room for newer ones
+     * @return    records dropped since clearTrace()
+     */
+    return (_dropped);
+  }  // of method dropped()
+  uint16_t copyTrace(uint8_t *trace, const uint16_t size) const {
+    /*!
+     * @brief      copies the trace in the layout read by BME280_ReplayBus
+     * @param[out] trace Storage for the trace
+     * @param[in]  size Size of the storage, the trace is cut off if it is too small
+     * @return     Number of bytes copied
+     */
+    uint16_t length = 0;
+    for (uint8_t i = 0; i < 4 && length < size; i++) trace[length++] = (uint8_t)(_start >> 8 * i);
+    for (uint16_t i = _tail; i != _head && length < size; i = (i + 1) % Size)
+      trace[length++] = _trace[i];
+    return (length);
+  }  // of method copyTrace()
+  void dump(Print &out) const {
+    /*!
+     * @brief     writes the trace as hexadecimal text, the start time first and then one line per
+     * record
+     * @param[in] out Where to write, e.g. Serial
+     */
+    for (uint8_t i = 0; i < 4; i++) printHex(out, (uint8_t)(_start >> 8 * i));
+    out.println();
+    for (uint16_t i = _tail; i != _head;) {
+      uint16_t next = skip(i);
+      for (; i != next; i = (i + 1) % Size) printHex(out, _trace[i]);
+      out.println();
+    }  // of for-next each record
+  }    // of method dump()
+
+ private:
+  void record(const uint8_t flags, const uint8_t addr, const uint8_t *buffer, uint8_t length) {
+    /*!
+     * @brief     adds a record, removing the oldest ones if there isn't enough room
+     * @param[in] flags BME280_TRACE_WRITE and BME280_TRACE_SHORT
+     * @param[in] addr Register address
+     * @param[in] buffer Bytes transferred
+     * @param[in] length Number of bytes transferred
+     */
+    if (!_enabled) return;
+    uint32_t now = Bus::micros();
+    if (_head == _tail) _start = _last = now;  // First record
+    uint32_t delta = now - _last;
+    if (length > BME280_TRACE_LENGTH) length = BME280_TRACE_LENGTH;
+    uint8_t size = 3 + length;  // Header, register, data and the first byte of the time
+    for (uint32_t i = delta; i >= 0x80; i >>= 7) size++;
+    if (size >= Size) return;  // Never fits
+    while (Size - 1 - traceLength() < size) {  // Drop the oldest record
+      _tail = skip(_tail);
+      if (_tail != _head) _start += timeOf(_tail);  // The next record is now the first one
+      _dropped++;
+    }  // of while-loop not enough room
+    if (_head == _tail) _start = now;  // Everything was dropped
+    put(flags | length);
+    put(addr);
+    for (; delta >= 0x80; delta >>= 7) put((uint8_t)delta | 0x80);
+    put((uint8_t)delta);
+    for (uint8_t i = 0; i < length; i++) put(buffer[i]);
+    _last = now;
+  }  // of method record()
+  void put(const uint8_t value) {
+    /*!
+     * @brief     appends a byte to the buffer
+     * @param[in] value Byte to append
+     */
+    _trace[_head] = value;
+    _head         = (_head + 1) % Size;
+  }  // of method put()
+  uint16_t skip(uint16_t index) const {
+    /*!
+     * @brief     returns the position of the record after the one at index
+     * @param[in] index Position of a record header
+     * @return    Position of the next record
+     */
+    uint8_t length = _trace[index] & BME280_TRACE_LENGTH;
+    index          = (index + 2) % Size;                      // Skip header and register,
+    while (_trace[index] & 0x80) index = (index + 1) % Size;  // the time
+    return ((index + 1 + length) % Size);                     // and the data
+  }  // of method skip()
+  uint32_t timeOf(uint16_t index) const {
+    /*!
+     * @brief     returns the microseconds between a record and the one before
+     * @param[in] index Position of a record header
+     * @return    Time in microseconds
+     */
+    uint32_t time = 0;
+    index         = (index + 2) % Size;  // Skip header and register
+    for (uint8_t shift = 0;; shift += 7, index = (index + 1) % Size) {
+      time |= (uint32_t)(_trace[index] & 0x7F) << shift;
+      if (!(_trace[index] & 0x80)) return (time);
+    }  // of for-next each time byte
+  }    // of method timeOf()
+  static void printHex(Print &out, const uint8_t value) {
+    /*!
+     * @brief     writes a byte as 2 hexadecimal digits
+     * @param[in] out Where to write
+     * @param[in] value Byte to write
+     */
+    if (value < 0x10) out.print('0');
+    out.print(value, HEX);
+  }  // of method printHex()
+  uint8_t  _trace[Size];     ///< Records, oldest at _tail
+  uint16_t _head    = 0;     ///< Next byte to write
+  uint16_t _tail    = 0;     ///< First byte of the oldest record
+  uint32_t _start   = 0;     ///< micros() value of the oldest record
+  uint32_t _last    = 0;     ///< micros() value of the newest record
+  uint32_t _dropped = 0;     ///< Records removed to make room
+  bool     _enabled = true;  ///< Set while recording
+};                           // of class BME280_TraceBus
+#endif
@@ -0,0 +1,273 @@
+/*!
+ * @file BME280_Tuner.cpp
+ * @section BME280_Tunercpp_intro_section Description
+ *
+ * Arduino Library for the BME280 Bosch sensor\n\n
+ * This file contains the settings selection declared in BME280_Tuner.h and doesn't use any Arduino
+ * functions\n\n
+ * See main library header file for details
+ */
+#include "BME280_Tuner.h"
+/*************************************************************************************************
+** Datasheet figures. The noise is in 1/100 of the reading unit for Oversample1 to Oversample16.  **
+** Pressure noise is from table 3, temperature noise is the resolution from table 4 and humidity **
+** noise is the 0.02%RH from table 1 reduced by the square root of the number of samples         **
+*************************************************************************************************/
+static const uint16_t OVERSAMPLE_NOISE[UnknownSensor][UnknownOversample - 1] = {
+    {50, 25, 12, 6, 3},          // Temperature
+    {200, 141, 100, 71, 50},     // Humidity
+    {330, 260, 210, 160, 130}};  // Pressure
+/*! RMS noise factor of the IIR filter, sqrt(1/(2*coefficient-1)) * 256, for IIROff to IIR16 */
+static const uint16_t IIR_NOISE[UnknownIIR] = {256, 148, 97, 66, 46};
+/*! Samples until the IIR filter output reaches 75% of a step, table 6 of the datasheet */
+static const uint8_t IIR_SETTLE[UnknownIIR] = {1, 2, 5, 11, 22};
+/*! Normal mode inactive time in microseconds for inactiveHalf to inactive20ms, table 27 */
+static const uint32_t INACTIVE_TIME[UnknownInactive] = {500,    62500,   125000, 250000,
+                                                        500000, 1000000, 10000,  20000};
+/*! Measurement current in uA of the temperature, humidity and pressure channels, table 1 */
+static const uint16_t CURRENT[UnknownSensor] = {350, 340, 714};
+static const uint16_t CURRENT_STANDBY = 200;  ///< Normal mode inactive current in nA
+static const uint16_t CURRENT_SLEEP   = 100;  ///< Sleep mode current in nA
+static const uint16_t TUNE_SAMPLES    = 512;  ///< Readings needed before comparing the noise
+static const uint16_t TUNE_AVERAGE    = 256;  ///< Readings averaged for the variance
+
+static uint32_t squareRoot(uint32_t value) {
+  /*!
+   * @brief     returns the integer square root, rounded down
+   * @param[in] value Number to take the root of
+   * @return    square root
+   */
+  uint32_t result = 0;
+  uint32_t bit    = (uint32_t)1 << 30;  // Highest power of 4 in range
+  while (bit > value) bit >>= 2;
+  while (bit != 0) {
+    if (value >= result + bit) {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }  // of if-then-else bit is set
+    bit >>= 2;
+  }  // of while-loop each bit
+  return (result);
+}  // of function squareRoot()
+static uint16_t filterCoefficient(const uint8_t sensor, const uint8_t iirFilter) {
+  /*!
+   * @brief     returns the IIR filter coefficient applied to a sensor
+   * @details   The filter is only used for the temperature and pressure readings
+   * @param[in] sensor TemperatureSensor, HumiditySensor or PressureSensor
+   * @param[in] iirFilter IIR filter setting
+   * @return    filter coefficient, 1 if unfiltered
+   */
+  return ((sensor == HumiditySensor) ? 1 : 1 << iirFilter);
+}  // of function filterCoefficient()
+bool BME280_Tuner::tune(const BME280_Targets &targets) {
+  /*!
+   * @brief     chooses the settings with the lowest current which meet the targets
+   * @details   Any noise estimate left over from update() is discarded
+   * @param[in] targets Wanted sample period, noise, current and response time
+   * @return    returns "false" if no setting meets all targets, the settings closest to them are
+   * chosen in that case
+   */
+  _targets = targets;
+  for (uint8_t sensor = 0; sensor < UnknownSensor; sensor++) _scale[sensor] = 16;
+  return (select());
+}  // of method tune()
+bool BME280_Tuner::select() {
+  /*!
+   * @brief     chooses the settings for the stored targets and noise scales
+   * @details   Each IIR setting is tried with the lowest oversampling which meets the noise targets
+   * and the longest inactive time which meets the sample period, as more oversampling and shorter
+   * periods only ever cost more current. The period is planned with the maximum conversion time,
+   * so that measurementTime() fits it on every device, and the current with the typical one. The
+   * IIR filter costs no current but slows the response. If no setting meets all targets the one
+   * closest to the noise targets is chosen
+   * @return    returns "false" if no setting meets all targets
+   */
+  bool     bestOk     = false;
+  uint32_t bestExcess = 0;
+  _samples    = 0;  // The noise history doesn't apply to new settings
+  if ((_targets.noise[TemperatureSensor] | _targets.noise[HumiditySensor] |
+       _targets.noise[PressureSensor]) == 0) {  // Nothing to measure
+    _config  = {SensorOff, SensorOff, SensorOff, IIROff, inactiveHalf, SleepMode};
+    _period  = 0;
+    _current = CURRENT_SLEEP;
+    for (uint8_t sensor = 0; sensor < UnknownSensor; sensor++) _noise[sensor] = 0;
+    return (true);
+  }  // of if-then all channels off
+  for (uint8_t iir = IIROff; iir < UnknownIIR; iir++) {
+    bool          ok     = true;
+    uint32_t      excess = 0;  // Sum of the relative noise above the targets
+    uint8_t       sampling[UnknownSensor];
+    uint16_t      noise[UnknownSensor];
+    BME280_Config config;
+    for (uint8_t sensor = 0; sensor < UnknownSensor; sensor++) {
+      sampling[sensor] = SensorOff;
+      noise[sensor]    = 0;
+      if (_targets.noise[sensor] == 0) continue;  // Channel not wanted
+      for (uint8_t os = Oversample1; os < UnknownOversample; os++) {
+        sampling[sensor] = os;
+        noise[sensor]    = (uint32_t)OVERSAMPLE_NOISE[sensor][os - 1] * _scale[sensor] *
+                            (sensor == HumiditySensor ? 256 : IIR_NOISE[iir]) / 4096;
+        if (noise[sensor] <= _targets.noise[sensor]) break;  // Lowest setting that is enough
+      }  // of for-next each oversampling setting
+      if (noise[sensor] > _targets.noise[sensor]) {
+        ok = false;
+        excess += (uint32_t)(noise[sensor] - _targets.noise[sensor]) * 256 / _targets.noise[sensor];
+      }  // of if-then noise target not met
+    }  // of for-next each sensor
+    if (sampling[TemperatureSensor] == SensorOff) {  // Needed to compensate the other readings
+      sampling[TemperatureSensor] = Oversample1;
+      noise[TemperatureSensor]    = (uint32_t)OVERSAMPLE_NOISE[TemperatureSensor][0] *
+                                 _scale[TemperatureSensor] * IIR_NOISE[iir] / 4096;
+    }  // of if-then temperature isn't wanted
+    uint32_t conversion = 1250;  // Maximum start-up time, section 9.1 of the datasheet
+    uint32_t active     = 1000;  // Typical start-up time, for the current
+    uint32_t charge     = 1000UL * CURRENT[TemperatureSensor];  // In uA * us per conversion
+    for (uint8_t sensor = 0; sensor < UnknownSensor; sensor++) {
+      if (sampling[sensor] == SensorOff) continue;
+      uint32_t time = 2000UL << (sampling[sensor] - 1);  // 2ms per sample
+      if (sensor != TemperatureSensor) time += 500;       // Plus set-up for pressure and humidity
+      conversion += (2300UL << (sampling[sensor] - 1)) + (sensor != TemperatureSensor ? 575 : 0);
+      active += time;
+      charge += time * CURRENT[sensor];
+    }  // of for-next each sensor
+    config.temperatureSampling = sampling[TemperatureSensor];
+    config.humiditySampling    = sampling[HumiditySensor];
+    config.pressureSampling    = sampling[PressureSensor];
+    config.iirFilter           = iir;
+    uint32_t period;
+    uint16_t idleCurrent;
+    if (_targets.samplePeriod > conversion + INACTIVE_TIME[inactive1000ms]) {
+      config.mode         = ForcedMode;  // Too slow for normal mode, program triggers
+      config.inactiveTime = inactive1000ms;
+      period              = _targets.samplePeriod;
+      idleCurrent         = CURRENT_SLEEP;
+    } else {
+      config.mode         = NormalMode;
+      config.inactiveTime = inactiveHalf;  // Shortest, used if the period can't be met
+      for (uint8_t standby = 0; standby < UnknownInactive; standby++)
+        if (conversion + INACTIVE_TIME[standby] <= _targets.samplePeriod &&
+            INACTIVE_TIME[standby] > INACTIVE_TIME[config.inactiveTime])
+          config.inactiveTime = standby;
+      period      = conversion + INACTIVE_TIME[config.inactiveTime];
+      idleCurrent = CURRENT_STANDBY;
+      if (period > _targets.samplePeriod) ok = false;
+    }  // of if-then-else forced or normal mode
+    if (_targets.maxResponse != 0 && (uint64_t)IIR_SETTLE[iir] * period > _targets.maxResponse) {
+      if (iir != IIROff) break;  // Stronger filters respond even more slowly
+      ok = false;
+    }  // of if-then response too slow
+    uint32_t current =
+        ((uint64_t)charge * 1000 + (uint64_t)idleCurrent * (period - active)) / period;
+    if (_targets.maxCurrent != 0 && current > _targets.maxCurrent) ok = false;
+    if (iir == IIROff || (ok && !bestOk) ||
+        (ok == bestOk && (excess < bestExcess || (excess == bestExcess && current < _current)))) {
+      bestOk     = ok;
+      bestExcess = excess;
+      _config    = config;
+      _period    = period;
+      _current   = current;
+      for (uint8_t sensor = 0; sensor < UnknownSensor; sensor++) _noise[sensor] = noise[sensor];
+    }  // of if-then better settings
+  }    // of for-next each IIR setting
+  return (bestOk);
+}  // of method select()
+bool BME280_Tuner::update(const BME280_Reading &reading) {
+  /*!
+   * @brief     compares the noise of the readings with the estimate and re-tunes if needed
+   * @details   Call with each new reading, e.g. from a streaming callback. A slow running mean
+   * and the variance around it are tracked for each channel. After enough readings the variance is
+   * converted back to the noise before the IIR filter, allowing for the filter and the rounding of
+   * the readings, and compared with the datasheet figure. When the ratio of any channel has changed
+   * by more than 25% the settings are chosen again with the datasheet noise scaled by that ratio.
+   * The ratio is never less than 1, as the surroundings can only add noise
+   * @param[in] reading Latest compensated reading
+   * @return    returns "true" when config() has changed and needs to be applied
+   */
+  const int32_t value[UnknownSensor] = {reading.temperature, reading.humidity, reading.pressure};
+  uint16_t      weight               = _samples < TUNE_AVERAGE ? _samples : TUNE_AVERAGE;
+  for (uint8_t sensor = 0; sensor < UnknownSensor; sensor++) {
+    int32_t scaled = value[sensor] * 16;  // 4 fraction bits for the mean
+    if (_samples == 0) {
+      _mean[sensor]     = scaled;  // Start with the first reading
+      _variance[sensor] = 0;
+      continue;
+    }  // of if-then first reading
+    _mean[sensor] += (scaled - _mean[sensor]) / 64;
+    int32_t deviation = (scaled - _mean[sensor]) * 100 / 16;  // In 1/100 reading unit
+    if (deviation < 0) deviation = -deviation;
+    if (deviation > 65535) deviation = 65535;  // Limit so that the square fits
+    uint32_t square   = (uint32_t)deviation * deviation;
+    _variance[sensor] = _variance[sensor] - _variance[sensor] / weight + square / weight;
+  }  // of for-next each sensor
+  if (_samples < UINT16_MAX) _samples++;
+  if (_samples < TUNE_SAMPLES) return (false);  // Not enough readings yet
+  const uint8_t sampling[UnknownSensor] = {_config.temperatureSampling, _config.humiditySampling,
+                                           _config.pressureSampling};
+  uint16_t      scale[UnknownSensor];
+  bool          changed = false;
+  for (uint8_t sensor = 0; sensor < UnknownSensor; sensor++) {
+    scale[sensor] = _scale[sensor];
+    if (sampling[sensor] == SensorOff) continue;
+    uint32_t filter    = filterCoefficient(sensor, _config.iirFilter);
+    uint32_t rounding  = 10000 / 12;  // Rounding to 1 unit adds 1/12 unit^2 to each reading
+    uint64_t variance  = _variance[sensor] > rounding ? _variance[sensor] - rounding : 0;
+    variance           = variance * (2 * filter - 1);  // Noise before the filter
+    uint32_t datasheet = OVERSAMPLE_NOISE[sensor][sampling[sensor] - 1];
+    uint64_t ratio     = variance * 256 / (datasheet * datasheet);  // (ratio * 16)^2
+    if (ratio > 65536) ratio = 65536;                               // At most 16 times
+    uint16_t observed = squareRoot((uint32_t)ratio);
+    if (observed < 16) observed = 16;
+    if (observed * 4 > _scale[sensor] * 5 || observed * 5 < _scale[sensor] * 4) changed = true;
+    scale[sensor] = observed;
+  }  // of for-next each sensor
+  if (!changed) return (false);
+  BME280_Config previous = _config;
+  for (uint8_t sensor = 0; sensor < UnknownSensor; sensor++) _scale[sensor] = scale[sensor];
+  select();
+  return (previous.temperatureSampling != _config.temperatureSampling ||
+          previous.humiditySampling != _config.humiditySampling ||
+          previous.pressureSampling != _config.pressureSampling ||
+          previous.iirFilter != _config.iirFilter ||
+          previous.inactiveTime != _config.inactiveTime || previous.mode != _config.mode);
+}  // of method update()
+const BME280_Config &BME280_Tuner::config() const {
+  /*!
+   * @brief     returns the chosen settings, which are written to the device with apply()
+   * @return    chosen settings
+   */
+  return (_config);
+}  // of method config()
+uint32_t BME280_Tuner::period() const {
+  /*!
+   * @brief     returns the sample period of the chosen settings
+   * @return    time between samples in microseconds
+   */
+  return (_period);
+}  // of method period()
+uint32_t BME280_Tuner::current() const {
+  /*!
+   * @brief     returns the estimated average current of the chosen settings
+   * @return    current in nanoamperes
+   */
+  return (_current);
+}  // of method current()
+uint16_t BME280_Tuner::noise(const uint8_t sensor) const {
+  /*!
+   * @brief     returns the estimated RMS noise of a channel with the chosen settings
+   * @param[in] sensor TemperatureSensor, HumiditySensor or PressureSensor
+   * @return    noise in 1/100 of the reading unit, 0 if the channel is off
+   */
+  if (sensor >= UnknownSensor) return (0);
+  return (_noise[sensor]);
+}  // of method noise()
+uint16_t BME280_Tuner::noiseScale(const uint8_t sensor) const {
+  /*!
+   * @brief     returns the ratio of the observed to the datasheet noise used by the last selection
+   * @param[in] sensor TemperatureSensor, HumiditySensor or PressureSensor
+   * @return    ratio times 16, i.e. 16 means the datasheet figures apply
+   */
+  if (sensor >= UnknownSensor) return (0);
+  return (_scale[sensor]);
+}  // of method noiseScale()
@@ -0,0 +1,63 @@
+/*!
+ @file BME280_Tuner.h
+
+ @section BME280_Tuner_intro_section Description
+
+ Chooses the oversampling, IIR filter and inactive time settings for a wanted sample period, noise
+ level and current budget\n\n
+
+ The noise of each channel is estimated from the datasheet noise figures for each oversampling
+ setting and the noise reduction of the IIR filter, the current from the datasheet measurement and
+ standby currents weighted by the time spent in each state. Of all settings which meet the targets
+ the one with the lowest average current is chosen. While running, update() compares the noise of
+ the readings with the estimate and re-tunes when the surroundings are noisier than the
+ datasheet figures. The code only depends on BME280_Core.h, so it can also be run on a computer to
+ try out settings.\n\n
+
+ See main library header file for details
+*/
+#ifndef BME280_Tuner_h
+/*! @brief Define guard code to prevent multiple inclusions */
+#define BME280_Tuner_h
+#include "BME280_Core.h"  // Include the BME280 Sensor library types
+
+/*! Targets for BME280_Tuner::tune() */
+struct BME280_Targets {
+  uint32_t samplePeriod;          ///< Longest wanted time between samples in microseconds
+  uint16_t noise[UnknownSensor];  ///< Largest RMS noise, 1/100 of the reading unit, 0 for off
+  uint32_t maxCurrent;            ///< Average current budget in nanoamperes, 0 for no limit
+  uint32_t maxResponse;           ///< Longest time to reach 75% of a step in us, 0 for no limit
+};
+
+class BME280_Tuner {
+  /*!
+    @class   BME280_Tuner
+    @brief   Picks the cheapest BME280_Config which meets a set of BME280_Targets
+    @details The noise targets are in 1/100 of the units returned by getSensorData(), i.e. 1/10000
+    of a degree Celsius, 1/10000 of a percent humidity and 1/100 of a Pascal, and are indexed by
+    TemperatureSensor, HumiditySensor and PressureSensor. A sample period up to the longest inactive
+    time plus the conversion time uses normal mode, longer periods use forced mode and the program
+    triggers each measurement. The chosen settings are written with apply(config())
+  */
+ public:
+  bool                 tune(const BME280_Targets &targets);
+  bool                 update(const BME280_Reading &reading);
+  const BME280_Config &config() const;
+  uint32_t             period() const;
+  uint32_t             current() const;
+  uint16_t             noise(const uint8_t sensor) const;
+  uint16_t             noiseScale(const uint8_t sensor) const;
+
+ private:
+  bool           select();
+  BME280_Targets _targets                 = {};  ///< Targets of the last tune() call
+  BME280_Config  _config                  = {};  ///< Chosen settings
+  uint32_t       _period                  = 0;   ///< Sample period of the chosen settings
+  uint32_t       _current                 = 0;   ///< Estimated average current in nanoamperes
+  uint16_t       _noise[UnknownSensor]    = {};  ///< Estimated RMS noise of the chosen settings
+  uint16_t       _scale[UnknownSensor]    = {};  ///< Observed / datasheet noise, 16 = 1.0
+  uint32_t       _variance[UnknownSensor] = {};  ///< Variance of the readings, (1/100 unit)^2
+  int32_t        _mean[UnknownSensor]     = {};  ///< Running mean of the readings * 16
+  uint16_t       _samples                 = 0;   ///< Readings since the last selection
+};                                               // of class BME280_Tuner
+#endif
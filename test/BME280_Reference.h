@@ -0,0 +1,196 @@
+/*!
+ @file BME280_Reference.h
+
+ @section BME280_Reference_intro_section Description
+
+ Reference compensation formulas for the host tests of the BME280 library\n\n
+
+ These are the formulas of section 4.2.3 and chapter 8 of the datasheet as the library used them
+ before the calibration-dependent terms were precomputed, i.e. every term is computed from the
+ calibration values for every reading. All three engines are always compiled, so a test can
+ compare the library's engine with the same formulas and measure its error against the 64-bit
+ ones.\n\n
+
+ See main library header file for details
+*/
+#ifndef BME280_Reference_h
+/*! @brief Define guard code to prevent multiple inclusions */
+#define BME280_Reference_h
+#include "BME280_Core.h"  // Calibration and reading structures
+
+static inline int32_t referenceRound(const double value) {
+  /*!
+   * @brief     returns a floating point value rounded to the nearest integer
+   * @param[in] value Value to round
+   * @return    Rounded value
+   */
+  return (value < 0.0) ? (int32_t)(value - 0.5) : (int32_t)(value + 0.5);
+}  // of function referenceRound()
+static inline BME280_Reading referenceFloat(const BME280_Calibration &cal, const int32_t adcT,
+                                            const int32_t adcP, const int32_t adcH) {
+  /*!
+   * @brief     double precision formulas of section 8.1 of the datasheet
+   * @param[in] cal Calibration values
+   * @param[in] adcT Raw temperature reading
+   * @param[in] adcP Raw pressure reading
+   * @param[in] adcH Raw humidity reading
+   * @return    Compensated readings
+   */
+  BME280_Reading out;
+  double         i, j, p, h;
+  i = ((double)adcT / 16384.0 - (double)cal.dig_T1 / 1024.0) * (double)cal.dig_T2;
+  j = ((double)adcT / 131072.0 - (double)cal.dig_T1 / 8192.0) *
+      ((double)adcT / 131072.0 - (double)cal.dig_T1 / 8192.0) * (double)cal.dig_T3;
+  int32_t tfine   = (int32_t)(i + j);
+  out.temperature = referenceRound((i + j) / 51.2);
+  i               = (double)tfine / 2.0 - 64000.0;
+  j               = i * i * (double)cal.dig_P6 / 32768.0;
+  j               = j + i * (double)cal.dig_P5 * 2.0;
+  j               = j / 4.0 + (double)cal.dig_P4 * 65536.0;
+  i = ((double)cal.dig_P3 * i * i / 524288.0 + (double)cal.dig_P2 * i) / 524288.0;
+  i = (1.0 + i / 32768.0) * (double)cal.dig_P1;
+  if (i == 0.0)
+    out.pressure = 0;
+  else {
+    p            = 1048576.0 - (double)adcP;
+    p            = (p - j / 4096.0) * 6250.0 / i;
+    i            = (double)cal.dig_P9 * p * p / 2147483648.0;
+    j            = p * (double)cal.dig_P8 / 32768.0;
+    out.pressure = referenceRound(p + (i + j + (double)cal.dig_P7) / 16.0);
+  }  // of if-then-else division by zero
+  h = (double)tfine - 76800.0;
+  h = ((double)adcH - ((double)cal.dig_H4 * 64.0 + (double)cal.dig_H5 / 16384.0 * h)) *
+      ((double)cal.dig_H2 / 65536.0 *
+       (1.0 + (double)cal.dig_H6 / 67108864.0 * h * (1.0 + (double)cal.dig_H3 / 67108864.0 * h)));
+  h            = h * (1.0 - (double)cal.dig_H1 * h / 524288.0);
+  h            = (h < 0.0) ? 0.0 : h;
+  h            = (h > 100.0) ? 100.0 : h;
+  out.humidity = referenceRound(h * 100.0);
+  return (out);
+}  // of function referenceFloat()
+static inline BME280_Reading referenceInt32(const BME280_Calibration &cal, const int32_t adcT,
+                                            const int32_t adcP, const int32_t adcH) {
+  /*!
+   * @brief     32-bit integer formulas of section 8.2 of the datasheet
+   * @param[in] cal Calibration values
+   * @param[in] adcT Raw temperature reading
+   * @param[in] adcP Raw pressure reading
+   * @param[in] adcH Raw humidity reading
+   * @return    Compensated readings
+   */
+  BME280_Reading out;
+  int32_t        i, j;
+  uint32_t       p;
+  i = (((adcT >> 3) - ((int32_t)cal.dig_T1 << 1)) * ((int32_t)cal.dig_T2)) >> 11;
+  j = (((((adcT >> 4) - ((int32_t)cal.dig_T1)) * ((adcT >> 4) - ((int32_t)cal.dig_T1))) >> 12) *
+       ((int32_t)cal.dig_T3)) >>
+      14;
+  int32_t tfine   = i + j;
+  out.temperature = (tfine * 5 + 128) >> 8;
+  i               = (tfine >> 1) - (int32_t)64000;
+  j               = (((i >> 2) * (i >> 2)) >> 11) * ((int32_t)cal.dig_P6);
+  j               = j + ((i * ((int32_t)cal.dig_P5)) << 1);
+  j               = (j >> 2) + (((int32_t)cal.dig_P4) << 16);
+  i = (((cal.dig_P3 * (((i >> 2) * (i >> 2)) >> 13)) >> 3) + ((((int32_t)cal.dig_P2) * i) >> 1)) >>
+      18;
+  i = ((((32768 + i)) * ((int32_t)cal.dig_P1)) >> 15);
+  if (i == 0)
+    out.pressure = 0;
+  else {
+    p = (((uint32_t)(((int32_t)1048576) - adcP) - (j >> 12))) * 3125;
+    if (p < 0x80000000)
+      p = (p << 1) / ((uint32_t)i);
+    else
+      p = (p / (uint32_t)i) * 2;
+    i            = (((int32_t)cal.dig_P9) * ((int32_t)(((p >> 3) * (p >> 3)) >> 13))) >> 12;
+    j            = (((int32_t)(p >> 2)) * ((int32_t)cal.dig_P8)) >> 13;
+    out.pressure = (int32_t)p + ((i + j + cal.dig_P7) >> 4);
+  }  // of if-then-else division by zero
+  i = (tfine - ((int32_t)76800));
+  i = (((((adcH << 14) - (((int32_t)cal.dig_H4) << 20) - (((int32_t)cal.dig_H5) * i)) +
+         ((int32_t)16384)) >>
+        15) *
+       (((((((i * ((int32_t)cal.dig_H6)) >> 10) *
+            (((i * ((int32_t)cal.dig_H3)) >> 11) + ((int32_t)32768))) >>
+           10) +
+          ((int32_t)2097152)) *
+             ((int32_t)cal.dig_H2) +
+         8192) >>
+        14));
+  i            = (i - (((((i >> 15) * (i >> 15)) >> 7) * ((int32_t)cal.dig_H1)) >> 4));
+  i            = (i < 0) ? 0 : i;
+  i            = (i > 419430400) ? 419430400 : i;
+  out.humidity = (uint32_t)(i >> 12) * 100 / 1024;
+  return (out);
+}  // of function referenceInt32()
+static inline BME280_Reading referenceInt64(const BME280_Calibration &cal, const int32_t adcT,
+                                            const int32_t adcP, const int32_t adcH) {
+  /*!
+   * @brief     64-bit pressure formula of section 4.2.3 of the datasheet, with 64-bit intermediate
+   * values for temperature and humidity
+   * @param[in] cal Calibration values
+   * @param[in] adcT Raw temperature reading
+   * @param[in] adcP Raw pressure reading
+   * @param[in] adcH Raw humidity reading
+   * @return    Compensated readings
+   */
+  BME280_Reading out;
+  int64_t        i, j, p;
+  i = ((((adcT >> 3) - ((int32_t)cal.dig_T1 << 1))) * ((int32_t)cal.dig_T2)) >> 11;
+  j = (((((adcT >> 4) - ((int32_t)cal.dig_T1)) * ((adcT >> 4) - ((int32_t)cal.dig_T1))) >> 12) *
+       ((int32_t)cal.dig_T3)) >>
+      14;
+  int32_t tfine   = i + j;
+  out.temperature = (tfine * 5 + 128) >> 8;
+  i               = ((int64_t)tfine) - 128000;
+  j               = i * i * (int64_t)cal.dig_P6;
+  j               = j + ((i * (int64_t)cal.dig_P5) << 17);
+  j               = j + (((int64_t)cal.dig_P4) << 35);
+  i               = ((i * i * (int64_t)cal.dig_P3) >> 8) + ((i * (int64_t)cal.dig_P2) << 12);
+  i               = (((((int64_t)1) << 47) + i)) * ((int64_t)cal.dig_P1) >> 33;
+  if (i == 0)
+    out.pressure = 0;
+  else {
+    p            = 1048576 - adcP;
+    p            = (((p << 31) - j) * 3125) / i;
+    i            = (((int64_t)cal.dig_P9) * (p >> 13) * (p >> 13)) >> 25;
+    j            = (((int64_t)cal.dig_P8) * p) >> 19;
+    p            = ((p + i + j) >> 8) + (((int64_t)cal.dig_P7) << 4);
+    out.pressure = p >> 8;
+  }  // of if-then-else division by zero
+  i = (tfine - ((int32_t)76800));
+  i = (((((adcH << 14) - (((int32_t)cal.dig_H4) << 20) - (((int32_t)cal.dig_H5) * i)) +
+         ((int32_t)16384)) >>
+        15) *
+       (((((((i * ((int32_t)cal.dig_H6)) >> 10) *
+            (((i * ((int32_t)cal.dig_H3)) >> 11) + ((int32_t)32768))) >>
+           10) +
+          ((int32_t)2097152)) *
+             ((int32_t)cal.dig_H2) +
+         8192) >>
+        14));
+  i            = (i - (((((i >> 15) * (i >> 15)) >> 7) * ((int32_t)cal.dig_H1)) >> 4));
+  i            = (i < 0) ? 0 : i;
+  i            = (i > 419430400) ? 419430400 : i;
+  out.humidity = (uint32_t)(i >> 12) * 100 / 1024;
+  return (out);
+}  // of function referenceInt64()
+static inline BME280_Reading reference(const BME280_Calibration &cal, const int32_t adcT,
+                                       const int32_t adcP, const int32_t adcH) {
+  /*!
+   * @brief     reference formulas of the engine selected by BME280_COMPENSATION
+   * @param[in] cal Calibration values
+   * @param[in] adcT Raw temperature reading
+   * @param[in] adcP Raw pressure reading
+   * @param[in] adcH Raw humidity reading
+   * @return    Compensated readings
+   */
+#if BME280_COMPENSATION == BME280_COMPENSATION_FLOAT
+  return (referenceFloat(cal, adcT, adcP, adcH));
+#elif BME280_COMPENSATION == BME280_COMPENSATION_INT32
+  return (referenceInt32(cal, adcT, adcP, adcH));
+#else
+  return (referenceInt64(cal, adcT, adcP, adcH));
+#endif
+}  // of function reference()
+#endif
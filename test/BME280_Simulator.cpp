@@ -0,0 +1,427 @@
+/*!
+ * @file BME280_Simulator.cpp
+ * @section BME280_Simulatorcpp_intro_section Description
+ *
+ * Register-level model of the BME280 and the Arduino functions of the host build\n\n
+ * The "Wire", "SPI", pin and time functions declared by the stubs are implemented here on top of
+ * the simulated devices\n\n
+ * See main library header file for details
+ */
+#include "BME280_Simulator.h"
+#include <SPI.h>
+#include <Wire.h>
+
+const BME280_Calibration BME280_SIM_CALIBRATION = {
+    27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,  // T1-P9
+    362,   313,   50,    75,    0,      30};  // H2, H4, H5, H1, H3, H6
+
+BME280_Simulator simulator[BME280_SIM_DEVICES];
+uint32_t         simulatedTime  = 0;
+uint32_t         wireBegins     = 0;
+uint32_t         pinWrites      = 0;
+uint32_t         spiByteCalls   = 0;
+uint32_t         spiBufferCalls = 0;
+TwoWire          Wire;
+SPIClass         SPI;
+
+static uint8_t oversampling(const uint8_t setting) {
+  /*!
+   * @brief     returns the number of samples of an oversampling setting
+   * @param[in] setting Register field value
+   * @return    Samples, 0 if the channel is skipped
+   */
+  return (setting == 0 ? 0 : setting >= 5 ? 16 : 1 << (setting - 1));
+}  // of function oversampling()
+static void put20(uint8_t *registers, const uint32_t value) {
+  /*!
+   * @brief     stores a 20-bit reading left-aligned in 3 measurement registers
+   * @param[out] registers First register
+   * @param[in] value Reading
+   */
+  registers[0] = value >> 12;
+  registers[1] = value >> 4;
+  registers[2] = (value & 0x0F) << 4;
+}  // of function put20()
+
+void simulatorPowerOn(const uint8_t devices) {
+  /*!
+   * @brief     powers on the simulated devices with the default calibration and readings
+   * @details   Device 0 answers at I2C address 0x77 and chip select pin 10, device 1 at 0x76 and
+   * pin 9. All faults, counters and the clock are reset
+   * @param[in] devices Number of devices present, the others don't answer
+   */
+  simulatedTime = 0;
+  wireBegins = pinWrites = spiByteCalls = spiBufferCalls = 0;
+  simulator[0].powerOn(0x77, 10);
+  simulator[1].powerOn(0x76, 9);
+  for (uint8_t i = 0; i < BME280_SIM_DEVICES; i++) simulator[i].present = (i < devices);
+}  // of function simulatorPowerOn()
+
+void BME280_Simulator::powerOn(const uint8_t i2cAddress, const uint8_t chipSelectPin) {
+  /*!
+   * @brief     sets the device to its power-on state
+   * @param[in] i2cAddress I2C address
+   * @param[in] chipSelectPin SPI chip select pin
+   */
+  memset(registers, 0, sizeof(registers));
+  registers[BME280_CHIPID_REG] = BME280_CHIPID;
+  address                      = i2cAddress;
+  chipSelect                   = chipSelectPin;
+  present                      = true;
+  stuckBusy                    = false;
+  nak                          = 0;
+  shortRead                    = -1;
+  conversions = reads = writes = statusReads = 0;
+  readStart = readLength = 0;
+  conversion                                 = nullptr;
+  spiSelected = spiAddressed = spiRead = false;
+  spiRegister = spiBits = spiIn = spiOut = 0;
+  calibrate(BME280_SIM_CALIBRATION);
+  measure(BME280_SIM_ADC_T, BME280_SIM_ADC_P, BME280_SIM_ADC_H);
+  reset();
+  _updateUntil = 0;  // The NVM copy is done at power-on
+}  // of method powerOn()
+
+void BME280_Simulator::calibrate(const BME280_Calibration &cal) {
+  /*!
+   * @brief     stores calibration values in the registers, see table 16 of the datasheet
+   * @param[in] cal Calibration values
+   */
+  const uint16_t words[12] = {cal.dig_T1,           (uint16_t)cal.dig_T2, (uint16_t)cal.dig_T3,
+                              cal.dig_P1,           (uint16_t)cal.dig_P2, (uint16_t)cal.dig_P3,
+                              (uint16_t)cal.dig_P4, (uint16_t)cal.dig_P5, (uint16_t)cal.dig_P6,
+                              (uint16_t)cal.dig_P7, (uint16_t)cal.dig_P8, (uint16_t)cal.dig_P9};
+  for (uint8_t i = 0; i < 12; i++) {
+    registers[BME280_T1_REG + 2 * i]     = words[i] & 0xFF;  // Little-endian
+    registers[BME280_T1_REG + 2 * i + 1] = words[i] >> 8;
+  }  // of for-next each word
+  registers[BME280_H1_REG]     = cal.dig_H1;
+  registers[BME280_H2_REG]     = (uint16_t)cal.dig_H2 & 0xFF;
+  registers[BME280_H2_REG + 1] = (uint16_t)cal.dig_H2 >> 8;
+  registers[BME280_H3_REG]     = cal.dig_H3;
+  registers[BME280_H4_REG]     = ((uint16_t)cal.dig_H4 >> 4) & 0xFF;  // H4 bits 11:4
+  registers[BME280_H5_REG] =
+      ((uint16_t)cal.dig_H4 & 0x0F) | (((uint16_t)cal.dig_H5 & 0x0F) << 4);  // H4 3:0, H5 3:0
+  registers[BME280_H5_REG + 1] = ((uint16_t)cal.dig_H5 >> 4) & 0xFF;  // H5 bits 11:4
+  registers[BME280_H6_REG]     = (uint8_t)cal.dig_H6;
+}  // of method calibrate()
+
+void BME280_Simulator::measure(const uint32_t adcT, const uint32_t adcP, const uint16_t adcH) {
+  /*!
+   * @brief     sets the raw readings loaded by the following conversions
+   * @param[in] adcT Raw temperature, 20 bits
+   * @param[in] adcP Raw pressure, 20 bits
+   * @param[in] adcH Raw humidity, 16 bits
+   */
+  _adcT = adcT;
+  _adcP = adcP;
+  _adcH = adcH;
+}  // of method measure()
+
+void BME280_Simulator::reset() {
+  /*!
+   * @brief     resets the device as a soft reset or a brown-out does
+   * @details   The control registers are cleared, the measurement registers hold the skipped
+   * values and the status register shows the NVM copy for 500us
+   */
+  registers[BME280_CONTROLHUMID_REG] = registers[BME280_CONTROL_REG] = 0;
+  registers[BME280_CONFIG_REG]                                        = 0;
+  put20(&registers[BME280_PRESSUREDATA_REG], 0x80000);
+  put20(&registers[BME280_TEMPDATA_REG], 0x80000);
+  registers[BME280_HUMIDDATA_REG]     = 0x80;
+  registers[BME280_HUMIDDATA_REG + 1] = 0x00;
+  _humidity                           = 0;
+  _forced                             = false;
+  _updateUntil                        = simulatedTime + 500;
+}  // of method reset()
+
+uint32_t BME280_Simulator::conversionTime() const {
+  /*!
+   * @brief     returns the duration of a conversion with the current settings
+   * @details   Slightly below the maximum of section 9.1 of the datasheet, which the library waits
+   * for at most
+   * @return    Microseconds
+   */
+  uint8_t  control = registers[BME280_CONTROL_REG];
+  uint32_t t       = oversampling(control >> 5), p = oversampling((control >> 2) & 7);
+  uint32_t time    = 1250 + 2300 * t;
+  if (p) time += 2300 * p + 575;
+  if (_humidity) time += 2300 * oversampling(_humidity) + 575;
+  return (time - 50);
+}  // of method conversionTime()
+
+uint32_t BME280_Simulator::period() const {
+  /*!
+   * @brief     returns the time between normal mode conversions
+   * @return    Conversion time plus the inactive time set in the config register, in microseconds
+   */
+  static const uint32_t INACTIVE[8] = {500, 62500, 125000, 250000, 500000, 1000000, 10000, 20000};
+  return (conversionTime() + INACTIVE[registers[BME280_CONFIG_REG] >> 5]);
+}  // of method period()
+
+void BME280_Simulator::load() {
+  /*!
+   * @brief     completes a conversion, loading the readings of the enabled channels
+   */
+  if (conversion) conversion(*this, conversions);
+  conversions++;
+  uint8_t control = registers[BME280_CONTROL_REG];
+  put20(&registers[BME280_PRESSUREDATA_REG], (control >> 2) & 7 ? _adcP : 0x80000);
+  put20(&registers[BME280_TEMPDATA_REG], control >> 5 ? _adcT : 0x80000);
+  uint16_t humidity                   = _humidity ? _adcH : 0x8000;
+  registers[BME280_HUMIDDATA_REG]     = humidity >> 8;
+  registers[BME280_HUMIDDATA_REG + 1] = humidity & 0xFF;
+}  // of method load()
+
+void BME280_Simulator::update() {
+  /*!
+   * @brief     completes the conversions which have finished by now
+   */
+  if (stuckBusy) return;
+  uint8_t mode = registers[BME280_CONTROL_REG] & 3;
+  if (_forced && (int32_t)(simulatedTime - _busyUntil) >= 0) {
+    _forced = false;
+    load();
+    registers[BME280_CONTROL_REG] &= ~3;  // Back to sleep mode
+  } else if (mode == NormalMode) {
+    uint32_t elapsed = simulatedTime - _normalStart;
+    if (elapsed < conversionTime()) return;  // First conversion still running
+    uint32_t done = (elapsed - conversionTime()) / period() + 1;
+    if (done != _normalDone) {
+      _normalDone = done;
+      load();
+    }  // of if-then new conversion
+  }    // of if-then-else forced or normal mode
+}  // of method update()
+
+uint8_t BME280_Simulator::readRegister(const uint8_t addr) {
+  /*!
+   * @brief     reads a register, the status bits reflect the conversion running at this time
+   * @details   Call update() once at the start of a burst, like the device the registers then
+   * don't change until the burst has been read
+   * @param[in] addr Register address
+   * @return    Register contents
+   */
+  if (addr != BME280_STATUS_REG) return (registers[addr]);
+  statusReads++;
+  uint8_t status = (int32_t)(simulatedTime - _updateUntil) < 0 ? 0x01 : 0x00;
+  if (stuckBusy || _forced) return (status | 0x08);
+  if ((registers[BME280_CONTROL_REG] & 3) == NormalMode) {
+    if ((simulatedTime - _normalStart) % period() < conversionTime()) status |= 0x08;
+  }  // of if-then normal mode
+  return (status);
+}  // of method readRegister()
+
+void BME280_Simulator::writeRegister(const uint8_t addr, const uint8_t value) {
+  /*!
+   * @brief     writes a register, only the reset, control and configuration registers are writable
+   * @param[in] addr Register address
+   * @param[in] value Value written
+   */
+  update();
+  if (addr == BME280_SOFTRESET_REG) {
+    if (value == BME280_SOFTWARE_CODE) reset();
+    return;
+  }  // of if-then reset register
+  if (addr != BME280_CONTROLHUMID_REG && addr != BME280_CONTROL_REG && addr != BME280_CONFIG_REG)
+    return;  // Read-only register
+  registers[addr] = value;
+  if (addr != BME280_CONTROL_REG) return;
+  _humidity = registers[BME280_CONTROLHUMID_REG] & 7;  // ctrl_hum applies from now on
+  if ((value & 3) == ForcedMode || (value & 3) == ForcedMode2) {
+    _forced    = true;
+    _busyUntil = simulatedTime + conversionTime();
+  } else if ((value & 3) == NormalMode) {
+    _normalStart = simulatedTime;
+    _normalDone  = 0;
+  }  // of if-then-else forced or normal mode
+}  // of method writeRegister()
+
+uint8_t BME280_Simulator::spiStart() {
+  /*!
+   * @brief     returns the byte the device shifts out during the next SPI byte
+   * @return    Register contents while reading, 0xFF otherwise
+   */
+  if (!spiAddressed || !spiRead) return (0xFF);
+  return (readRegister(spiRegister++));
+}  // of method spiStart()
+
+void BME280_Simulator::spiEnd(const uint8_t data) {
+  /*!
+   * @brief     processes an SPI byte received by the device
+   * @details   The first byte after chip select holds the register address with bit 7 set for a
+   * read. Writes are pairs of register address and data
+   * @param[in] data Byte received
+   */
+  if (!spiAddressed) {
+    spiAddressed = true;
+    spiRead      = (data & 0x80) != 0;
+    spiRegister  = data | 0x80;  // All registers are at 0x80 and above
+    update();                    // Registers are frozen during a burst
+    if (spiRead) reads++;
+  } else if (!spiRead) {
+    writeRegister(spiRegister, data);
+    writes++;
+    spiAddressed = false;  // A register address follows
+  }                        // of if-then-else address byte
+}  // of method spiEnd()
+
+/*************************************************************************************************
+** Arduino core functions                                                                       **
+*************************************************************************************************/
+static uint8_t pinLevel[64];  ///< Level last written to each pin
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t pin, uint8_t value) {
+  /*!
+   * @brief     sets a pin, chip select and clock edges drive the SPI state of the devices
+   * @param[in] pin Pin number
+   * @param[in] value HIGH or LOW
+   */
+  pinWrites++;
+  simulatedTime += 4;  // About the time digitalWrite() takes on an AVR
+  uint8_t previous = pinLevel[pin];
+  pinLevel[pin]    = value ? HIGH : LOW;
+  for (uint8_t i = 0; i < BME280_SIM_DEVICES; i++) {
+    BME280_Simulator &device = simulator[i];
+    if (!device.present) continue;
+    if (pin == device.chipSelect && previous != pinLevel[pin]) {
+      device.spiSelected  = (pinLevel[pin] == LOW);
+      device.spiAddressed = false;
+      device.spiBits      = 0;
+      device.spiOut       = 0xFF;
+    } else if (pin == BME280_SIM_SCK && device.spiSelected && previous != pinLevel[pin]) {
+      if (pinLevel[pin] == LOW) {                        // Falling edge, next bit is shifted out
+        if (device.spiBits == 0) device.spiOut = device.spiStart();
+      } else {                                           // Rising edge, MOSI is latched
+        device.spiIn = (device.spiIn << 1) | pinLevel[BME280_SIM_MOSI];
+        if (++device.spiBits == 8) {
+          device.spiBits = 0;
+          device.spiEnd(device.spiIn);
+        }  // of if-then byte complete
+      }    // of if-then-else clock edge
+    }      // of if-then-else chip select or clock
+  }        // of for-next each device
+}  // of function digitalWrite()
+int digitalRead(uint8_t pin) {
+  /*!
+   * @brief     reads a pin, MISO is driven by the selected device
+   * @param[in] pin Pin number
+   * @return    HIGH or LOW
+   */
+  simulatedTime += 4;
+  if (pin != BME280_SIM_MISO) return (pinLevel[pin]);
+  for (uint8_t i = 0; i < BME280_SIM_DEVICES; i++) {
+    BME280_Simulator &device = simulator[i];
+    if (!device.present || !device.spiSelected) continue;
+    uint8_t bit = device.spiBits ? device.spiBits - 1 : 7;  // Bit shown since the last edge
+    if (pinLevel[BME280_SIM_SCK] == LOW) bit = device.spiBits;
+    return ((device.spiOut >> (7 - bit)) & 1);
+  }  // of for-next each device
+  return (HIGH);
+}  // of function digitalRead()
+unsigned long micros() { return (simulatedTime++); }
+unsigned long millis() { return (simulatedTime / 1000); }
+void          delay(unsigned long ms) { simulatedTime += ms * 1000; }
+void          delayMicroseconds(unsigned int us) { simulatedTime += us; }
+
+/*************************************************************************************************
+** Wire library, at 100kHz every byte including the address byte takes 90us                     **
+*************************************************************************************************/
+static uint8_t wireAddress, wireRegister, wireBuffer[32], wireLength, wirePosition;
+static BME280_Simulator *wireDevice(const uint8_t address) {
+  /*!
+   * @brief     returns the device which acknowledges an I2C address
+   * @param[in] address I2C address
+   * @return    Device, nullptr if none answers or the transfer is refused
+   */
+  for (uint8_t i = 0; i < BME280_SIM_DEVICES; i++) {
+    BME280_Simulator &device = simulator[i];
+    if (!device.present || device.address != address) continue;
+    if (device.nak == 0) return (&device);
+    if (device.nak != BME280_SIM_NAK_ALL) device.nak--;
+    return (nullptr);
+  }  // of for-next each device
+  return (nullptr);
+}  // of function wireDevice()
+void   TwoWire::begin() { wireBegins++; }
+void   TwoWire::setClock(uint32_t) {}
+void   TwoWire::beginTransmission(uint8_t address) {
+  wireAddress = address;
+  wireLength  = 0;
+}  // of method beginTransmission()
+size_t TwoWire::write(uint8_t data) {
+  if (wireLength == sizeof(wireBuffer)) return (0);
+  wireBuffer[wireLength++] = data;
+  return (1);
+}  // of method write()
+uint8_t TwoWire::endTransmission(bool) {
+  /*!
+   * @brief     sends the transmission, the first byte sets the register pointer and register
+   * address and data pairs are written
+   * @return    0 for success, 2 if the address wasn't acknowledged
+   */
+  simulatedTime += 90 * (wireLength + 1);
+  BME280_Simulator *device = wireDevice(wireAddress);
+  if (device == nullptr) return (2);
+  if (wireLength) wireRegister = wireBuffer[0];
+  for (uint8_t i = 0; i + 1 < wireLength; i += 2)
+    device->writeRegister(wireBuffer[i], wireBuffer[i + 1]);
+  if (wireLength > 1) device->writes++;
+  return (0);
+}  // of method endTransmission()
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity) {
+  /*!
+   * @brief     reads bytes from the register pointer on, the pointer is incremented
+   * @return    Number of bytes received
+   */
+  simulatedTime += 90 * (quantity + 1);
+  wireLength = wirePosition = 0;
+  BME280_Simulator *device  = wireDevice(address);
+  if (device == nullptr) return (0);
+  if (device->shortRead >= 0 && device->shortRead < quantity) {
+    quantity          = device->shortRead;
+    device->shortRead = -1;
+  }  // of if-then read cut short
+  device->reads++;
+  device->update();  // Registers are frozen during a burst
+  device->readStart = wireRegister;
+  for (wireLength = 0; wireLength < quantity && wireLength < sizeof(wireBuffer); wireLength++)
+    wireBuffer[wireLength] = device->readRegister(wireRegister++);
+  device->readLength = wireLength;
+  return (wireLength);
+}  // of method requestFrom()
+int TwoWire::available() { return (wireLength - wirePosition); }
+int TwoWire::read() { return (wirePosition < wireLength ? wireBuffer[wirePosition++] : -1); }
+
+/*************************************************************************************************
+** SPI library                                                                                  **
+*************************************************************************************************/
+void    SPIClass::begin() {}
+void    SPIClass::beginTransaction(SPISettings) {}
+void    SPIClass::endTransaction() {}
+static uint8_t spiExchange(const uint8_t data) {
+  /*!
+   * @brief     exchanges a byte with the selected device
+   * @param[in] data Byte sent
+   * @return    Byte received
+   */
+  simulatedTime += 2;
+  for (uint8_t i = 0; i < BME280_SIM_DEVICES; i++) {
+    BME280_Simulator &device = simulator[i];
+    if (!device.present || !device.spiSelected) continue;
+    uint8_t reply = device.spiStart();
+    device.spiEnd(data);
+    return (reply);
+  }  // of for-next each device
+  return (0xFF);
+}  // of function spiExchange()
+uint8_t SPIClass::transfer(uint8_t data) {
+  spiByteCalls++;
+  return (spiExchange(data));
+}  // of method transfer()
+void SPIClass::transfer(void *buffer, size_t count) {
+  uint8_t *data = (uint8_t *)buffer;
+  spiBufferCalls++;
+  for (size_t i = 0; i < count; i++) data[i] = spiExchange(data[i]);
+}  // of method transfer()
@@ -0,0 +1,97 @@
+/*!
+ @file BME280_Simulator.h
+
+ @section BME280_Simulator_intro_section Description
+
+ Register-level model of the BME280 used by the host build of the library tests\n\n
+
+ The model answers the I2C transfers of the "Wire" stub, the hardware SPI transfers of the "SPI"
+ stub and software SPI done with digitalWrite() and digitalRead() from a register file. It holds
+ the chip id and calibration registers, runs forced and normal mode conversions with the status
+ bits set for the datasheet's maximum conversion time, loads the skipped value for channels which
+ are switched off, latches ctrl_hum on the next ctrl_meas write and goes back to the power-on
+ register values on a soft reset. Faults such as missing acknowledges, short reads and a measuring
+ bit which never clears can be injected.\n\n
+
+ Time is simulated: bus transfers, pin changes and delay() advance the clock which micros() and
+ millis() return, so the tests run at full speed and give the same results on every run.\n\n
+
+ See main library header file for details
+*/
+#ifndef BME280_Simulator_h
+/*! @brief Define guard code to prevent multiple inclusions */
+#define BME280_Simulator_h
+#include "BME280_Core.h"  // Register map and calibration structure
+
+const uint8_t  BME280_SIM_DEVICES = 2;           ///< Number of simulated devices on the buses
+const uint8_t  BME280_SIM_MOSI    = 11;          ///< Software SPI master-out slave-in pin
+const uint8_t  BME280_SIM_MISO    = 12;          ///< Software SPI master-in slave-out pin
+const uint8_t  BME280_SIM_SCK     = 13;          ///< Software SPI clock pin
+const uint32_t BME280_SIM_ADC_T   = 519888;      ///< Raw temperature of the datasheet example
+const uint32_t BME280_SIM_ADC_P   = 415148;      ///< Raw pressure of the datasheet example
+const uint16_t BME280_SIM_ADC_H   = 30000;       ///< Raw humidity giving 54.99%
+const uint16_t BME280_SIM_NAK_ALL = UINT16_MAX;  ///< Value of nak to refuse all transfers
+/*! Calibration of the datasheet example, section 8.1, with the humidity values of a real device */
+extern const BME280_Calibration BME280_SIM_CALIBRATION;
+
+class BME280_Simulator {
+  /*!
+    @class   BME280_Simulator
+    @brief   One simulated BME280, see simulatorPowerOn() for the default setup
+  */
+ public:
+  void     powerOn(const uint8_t i2cAddress, const uint8_t chipSelectPin);
+  void     calibrate(const BME280_Calibration &cal);
+  void     measure(const uint32_t adcT, const uint32_t adcP, const uint16_t adcH);
+  void     reset();
+  void     update();
+  uint32_t conversionTime() const;
+  uint32_t period() const;
+  uint8_t  readRegister(const uint8_t addr);
+  void     writeRegister(const uint8_t addr, const uint8_t value);
+  uint8_t  spiStart();
+  void     spiEnd(const uint8_t data);
+  uint8_t  registers[256];  ///< Register file, written values are applied by writeRegister()
+  uint8_t  address;         ///< I2C address
+  uint8_t  chipSelect;      ///< SPI chip select pin
+  bool     present;         ///< Device answers on the buses
+  bool     stuckBusy;       ///< Measuring bit never clears and no conversion completes
+  uint16_t nak;             ///< Number of following I2C transfers not acknowledged
+  int16_t  shortRead;       ///< Bytes returned by the next longer I2C read if not negative
+  uint32_t conversions;     ///< Completed conversions since power-on
+  uint32_t reads;           ///< Register reads, one per I2C request or SPI read
+  uint32_t writes;          ///< Register writes, one per I2C transmission or SPI write
+  uint32_t statusReads;     ///< Reads of the status register
+  uint8_t  readStart;       ///< First register of the last I2C read
+  uint8_t  readLength;      ///< Registers returned by the last I2C read
+  /*! Called before each conversion loads its result, e.g. to set new readings with measure() */
+  void (*conversion)(BME280_Simulator &device, const uint32_t number);
+  bool    spiSelected;   ///< Chip select is low
+  bool    spiAddressed;  ///< Register address byte of this selection received
+  bool    spiRead;       ///< Selection is a read
+  uint8_t spiRegister;   ///< Register of the next SPI data byte
+  uint8_t spiBits;       ///< Bits of the current byte clocked by software SPI
+  uint8_t spiIn;         ///< Bits received by software SPI
+  uint8_t spiOut;        ///< Byte sent by software SPI
+
+ private:
+  void     load();
+  uint32_t _adcT;         ///< Raw temperature of the next conversion
+  uint32_t _adcP;         ///< Raw pressure of the next conversion
+  uint16_t _adcH;         ///< Raw humidity of the next conversion
+  uint8_t  _humidity;     ///< Humidity oversampling latched by the last ctrl_meas write
+  bool     _forced;       ///< Forced conversion running
+  uint32_t _busyUntil;    ///< End of the forced conversion
+  uint32_t _updateUntil;  ///< End of the NVM copy after a reset
+  uint32_t _normalStart;  ///< Start of the first normal mode conversion
+  uint32_t _normalDone;   ///< Normal mode conversions loaded
+};                        // of class BME280_Simulator
+
+extern BME280_Simulator simulator[BME280_SIM_DEVICES];  ///< Device 0 at 0x77, device 1 at 0x76
+extern uint32_t         simulatedTime;                   ///< Microseconds since the start
+extern uint32_t         wireBegins;                      ///< Calls of Wire.begin()
+extern uint32_t         pinWrites;                       ///< Calls of digitalWrite()
+extern uint32_t         spiByteCalls;                    ///< Calls of SPI.transfer(byte)
+extern uint32_t         spiBufferCalls;                  ///< Calls of SPI.transfer(buffer, count)
+void                    simulatorPowerOn(const uint8_t devices = 1);
+#endif
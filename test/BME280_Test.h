@@ -0,0 +1,75 @@
+/*!
+ @file BME280_Test.h
+
+ @section BME280_Test_intro_section Description
+
+ Checks and helpers shared by the host tests of the BME280 library\n\n
+
+ Each test is a program which returns 0 when all checks passed. A failed check prints the file,
+ line and expression and the test carries on, so one run shows all failures.\n\n
+
+ See main library header file for details
+*/
+#ifndef BME280_Test_h
+/*! @brief Define guard code to prevent multiple inclusions */
+#define BME280_Test_h
+#include <stdio.h>  // printf()
+
+#include "BME280_Core.h"  // Raw sample layout
+
+/*! @brief Checks a condition */
+#define CHECK(condition) testCheck((condition), #condition, __FILE__, __LINE__)
+/*! @brief Checks that two integer values are equal and shows both if they aren't */
+#define CHECK_EQUAL(expected, actual) \
+  testEqual((long long)(expected), (long long)(actual), #actual, __FILE__, __LINE__)
+
+static unsigned testFailures = 0;  ///< Number of failed checks
+
+static inline bool testCheck(const bool passed, const char *text, const char *file,
+                             const int line) {
+  /*!
+   * @brief     counts and reports a failed check
+   * @return    the result of the check
+   */
+  if (!passed) {
+    printf("%s:%d: check failed: %s\n", file, line, text);
+    testFailures++;
+  }  // of if-then failed
+  return (passed);
+}  // of function testCheck()
+static inline bool testEqual(const long long expected, const long long actual, const char *text,
+                             const char *file, const int line) {
+  /*!
+   * @brief     counts and reports a value which differs from the expected one
+   * @return    "true" if the values are equal
+   */
+  if (expected != actual) {
+    printf("%s:%d: %s is %lld, expected %lld\n", file, line, text, actual, expected);
+    testFailures++;
+  }  // of if-then failed
+  return (expected == actual);
+}  // of function testEqual()
+static inline int testResult(const char *name) {
+  /*!
+   * @brief     prints the summary of a test program
+   * @param[in] name Test name
+   * @return    Exit code of the program, 0 if all checks passed
+   */
+  printf("%s: %s, %u failed checks\n", name, testFailures ? "FAILED" : "passed", testFailures);
+  return (testFailures ? 1 : 0);
+}  // of function testResult()
+static inline BME280_RawSample rawSample(const uint32_t adcT, const uint32_t adcP,
+                                         const uint32_t adcH) {
+  /*!
+   * @brief     returns the measurement registers holding the given raw readings
+   * @param[in] adcT Raw temperature, 20 bits
+   * @param[in] adcP Raw pressure, 20 bits
+   * @param[in] adcH Raw humidity, 16 bits
+   * @return    Registers 0xF7-0xFE
+   */
+  BME280_RawSample raw = {{(uint8_t)(adcP >> 12), (uint8_t)(adcP >> 4), (uint8_t)(adcP << 4),
+                           (uint8_t)(adcT >> 12), (uint8_t)(adcT >> 4), (uint8_t)(adcT << 4),
+                           (uint8_t)(adcH >> 8), (uint8_t)adcH}};
+  return (raw);
+}  // of function rawSample()
+#endif
@@ -0,0 +1,111 @@
+/*!
+ @file bench_codec.cpp
+
+ @section bench_codec_intro_section Description
+
+ Benchmark of the sample format of BME280_Codec.h on the host: a day of weather readings taken
+ once a second, with a daily temperature and humidity cycle, a slow pressure drift and the noise
+ of the sensor, is encoded with several keyframe intervals. For each one the bytes per reading
+ are shown next to the 8 bytes of the raw measurement registers and the 12 bytes of a
+ BME280_Reading, together with the host time to encode one reading. The stream is decoded again
+ to check that the readings are unchanged\n\n
+
+ See main library header file for details
+*/
+#include <math.h>   // sin() for the daily cycle
+#include <stdio.h>  // printf()
+
+#include <chrono>  // Host time
+
+#include "BME280_Codec.h"
+#include "BME280_Test.h"
+
+const uint32_t SAMPLES    = 86400;  ///< Readings in the stream, one a second for a day
+const uint16_t ITERATIONS = 20;     ///< Times the stream is encoded per result
+const uint8_t  BUFFERS    = 32;     ///< Most buffers of up to 65535 bytes in the stream
+
+static BME280_Reading readings[SAMPLES];       ///< Readings to encode
+static uint8_t        stream[SAMPLES * 6];     ///< Encoded stream
+static uint16_t       bufferLengths[BUFFERS];  ///< Bytes in each buffer of the stream
+static uint8_t        bufferCount = 0;         ///< Buffers in the stream
+static uint32_t       noise       = 1;         ///< State of the noise generator
+
+static int32_t jitter(const int32_t range) {
+  /*!
+   * @brief     returns noise from a linear congruential generator, the same on every host
+   * @param[in] range Largest deviation
+   * @return    Value from -range to +range
+   */
+  noise = noise * 1103515245 + 12345;
+  return ((int32_t)((noise >> 16) % (2 * range + 1)) - range);
+}  // of function jitter()
+static void makeReadings() {
+  /*!
+   * @brief     fills the readings with a day of weather: 21 +/- 4 degrees, 45 -/+ 10 percent
+   * humidity and a pressure falling by 800Pa, with noise of 0.03 degrees, 0.1 percent and 3Pa as
+   * the sensor gives with the weather monitoring settings
+   */
+  for (uint32_t i = 0; i < SAMPLES; i++) {
+    double day              = sin(i * 2.0 * M_PI / SAMPLES);
+    readings[i].temperature = 2100 + (int32_t)(400.0 * day) + jitter(3);
+    readings[i].humidity    = 4500 - (int32_t)(1000.0 * day) + jitter(10);
+    readings[i].pressure    = 101325 - (int32_t)(i / 108) + jitter(3);
+  }  // of for-next each reading
+}  // of function makeReadings()
+static double encode(const uint16_t keyframeInterval) {
+  /*!
+   * @brief     encodes the readings into buffers of the stream and returns the time per reading
+   * @param[in] keyframeInterval Readings between keyframes, 0 for only the first one
+   * @return    Nanoseconds per reading
+   */
+  typedef std::chrono::steady_clock clock;
+  BME280_Encoder                    encoder;
+  clock::time_point                 begin = clock::now();
+  for (uint16_t i = 0; i < ITERATIONS; i++) {
+    encoder.reset();
+    bufferCount = 0;
+    for (uint32_t s = 0, start = 0; s < SAMPLES; start += bufferLengths[bufferCount++]) {
+      encoder.begin(stream + start, UINT16_MAX, keyframeInterval);
+      while (s < SAMPLES && encoder.add(readings[s])) s++;
+      bufferLengths[bufferCount] = encoder.length();
+    }  // of for-next each buffer
+  }    // of for-next each iteration
+  return (std::chrono::duration<double, std::nano>(clock::now() - begin).count() / SAMPLES /
+          ITERATIONS);
+}  // of function encode()
+static uint32_t decode() {
+  /*!
+   * @brief     decodes the buffers of the stream and checks the readings against those encoded
+   * @return    Bytes in the stream
+   */
+  BME280_Decoder decoder;
+  BME280_Reading reading;
+  uint32_t       decoded = 0, start = 0;
+  for (uint8_t b = 0; b < bufferCount; start += bufferLengths[b++]) {
+    decoder.begin(stream + start, bufferLengths[b]);
+    while (decoded < SAMPLES && decoder.next(reading)) {
+      const BME280_Reading &expected = readings[decoded++];
+      if (!CHECK_EQUAL(expected.temperature, reading.temperature) ||
+          !CHECK_EQUAL(expected.humidity, reading.humidity) ||
+          !CHECK_EQUAL(expected.pressure, reading.pressure))
+        return (start);
+    }  // of while-loop each reading
+  }    // of for-next each buffer
+  CHECK_EQUAL(SAMPLES, decoded);
+  CHECK_EQUAL(0, decoder.gaps());
+  return (start);
+}  // of function decode()
+
+int main() {
+  const uint16_t INTERVALS[] = {0, 60, 600};  // Keyframes once, every minute and every 10 minutes
+  makeReadings();
+  printf("keyframes  bytes/reading  of raw frame  of reading  encode ns/reading\n");
+  for (uint8_t k = 0; k < sizeof(INTERVALS) / sizeof(INTERVALS[0]); k++) {
+    double time       = encode(INTERVALS[k]);
+    double perReading = (double)decode() / SAMPLES;
+    printf("%9u %14.2f %12.1f%% %10.1f%% %18.1f\n", INTERVALS[k], perReading,
+           100.0 * perReading / BME280_RAW_DATA_LENGTH,
+           100.0 * perReading / sizeof(BME280_Reading), time);
+  }  // of for-next each keyframe interval
+  return (testResult("codec benchmark"));
+}  // of function main()
@@ -0,0 +1,79 @@
+/*!
+ @file bench_compensation.cpp
+
+ @section bench_compensation_intro_section Description
+
+ Microbenchmark of the compensation engine the program was built with: the time to convert one
+ raw sample on the host, with all channels and with the temperature only, next to the baseline of
+ the reference formulas of BME280_Reference.h which compute every calibration term for each
+ sample, as the library did before the terms were precomputed. The relative speed of
+ the engines on the host is only a rough guide for 8-bit processors, where 64-bit and floating
+ point arithmetic are done in software\n\n
+
+ See main library header file for details
+*/
+#include <stdio.h>  // printf()
+
+#include <chrono>  // Host time
+
+#include "BME280_Reference.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+
+const uint16_t SAMPLES    = 1024;  ///< Samples converted per batch
+const uint16_t ITERATIONS = 500;   ///< Batches converted per result
+
+static double convert(const BME280_Core &core, const BME280_RawSample raw[],
+                      BME280_Reading out[], const uint8_t channels) {
+  /*!
+   * @brief     returns the time to convert one sample in nanoseconds
+   * @param[in] core Calibrated core
+   * @param[in] raw Raw samples
+   * @param[out] out Converted samples
+   * @param[in] channels Channels to convert
+   * @return    Nanoseconds per sample
+   */
+  typedef std::chrono::steady_clock clock;
+  clock::time_point                 begin = clock::now();
+  for (uint16_t i = 0; i < ITERATIONS; i++) core.compensate(raw, out, SAMPLES, channels);
+  return (std::chrono::duration<double, std::nano>(clock::now() - begin).count() / SAMPLES /
+          ITERATIONS);
+}  // of function convert()
+static double baseline(const BME280_Calibration &cal, const BME280_RawSample raw[],
+                       BME280_Reading out[]) {
+  /*!
+   * @brief     returns the time to convert one sample with the reference formulas in nanoseconds
+   * @param[in] cal Calibration values
+   * @param[in] raw Raw samples
+   * @param[out] out Converted samples
+   * @return    Nanoseconds per sample
+   */
+  typedef std::chrono::steady_clock clock;
+  clock::time_point                 begin = clock::now();
+  for (uint16_t i = 0; i < ITERATIONS; i++)
+    for (uint16_t s = 0; s < SAMPLES; s++) {
+      const uint8_t *data = raw[s].data;  // Big-endian 20-bit pressure and temperature, 16-bit H
+      out[s] = reference(cal, (int32_t)data[3] << 12 | (int32_t)data[4] << 4 | data[5] >> 4,
+                         (int32_t)data[0] << 12 | (int32_t)data[1] << 4 | data[2] >> 4,
+                         (int32_t)data[6] << 8 | data[7]);
+    }  // of for-next each sample
+  return (std::chrono::duration<double, std::nano>(clock::now() - begin).count() / SAMPLES /
+          ITERATIONS);
+}  // of function baseline()
+
+int main() {
+  static BME280_RawSample raw[SAMPLES];
+  static BME280_Reading   out[SAMPLES];
+  BME280_Core             core;
+  core.calibration(BME280_SIM_CALIBRATION);
+  for (uint16_t i = 0; i < SAMPLES; i++)
+    raw[i] = rawSample(380000 + i * 271, 200000 + i * 427, 10000 + i * 48);
+  const char *engine = BME280_COMPENSATION == BME280_COMPENSATION_FLOAT   ? "float"
+                       : BME280_COMPENSATION == BME280_COMPENSATION_INT32 ? "32-bit"
+                                                                          : "64-bit";
+  printf("%-6s engine: %6.1f ns per sample, %6.1f ns temperature only\n", engine,
+         convert(core, raw, out, AllChannels), convert(core, raw, out, TemperatureChannel));
+  printf("%-6s formulas without precomputed terms: %6.1f ns per sample\n", engine,
+         baseline(BME280_SIM_CALIBRATION, raw, out));
+  return (0);
+}  // of function main()
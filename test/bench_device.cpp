@@ -0,0 +1,68 @@
+/*!
+ @file bench_device.cpp
+
+ @section bench_device_intro_section Description
+
+ Microbenchmark of the device path on the host: begin(), which reads the chip id, both
+ calibration blocks and the settings, and getSensorData(), which reads and compensates a
+ measurement. For each bus the host time per call, the simulated bus time and the number of
+ register reads and writes are shown\n\n
+
+ See main library header file for details
+*/
+#include <stdio.h>  // printf()
+
+#include <chrono>  // Host time
+
+#include "BME280.h"
+#include "BME280_Simulator.h"
+
+const uint32_t ITERATIONS = 20000;  ///< Calls measured per result
+
+template <class Device>
+static void benchmark(const char *bus, Device &sensor, bool (*start)(Device &)) {
+  /*!
+   * @brief     measures begin() and getSensorData() of a device
+   * @param[in] bus Name of the bus
+   * @param[in] sensor Device
+   * @param[in] start Function calling begin() with the bus parameters
+   */
+  typedef std::chrono::steady_clock clock;
+  simulatorPowerOn();
+  start(sensor);
+  sensor.apply(BME280_WEATHER_MONITORING);
+  simulator[0].reads = simulator[0].writes = 0;
+  uint32_t simulated                       = simulatedTime;
+  clock::time_point begin                  = clock::now();
+  for (uint32_t i = 0; i < ITERATIONS; i++) start(sensor);
+  double   nanoseconds = std::chrono::duration<double, std::nano>(clock::now() - begin).count();
+  printf("%-13s begin()         %7.0f ns, %6.0f us bus time, %4.1f reads, %4.1f writes\n", bus,
+         nanoseconds / ITERATIONS, (double)(simulatedTime - simulated) / ITERATIONS,
+         (double)simulator[0].reads / ITERATIONS, (double)simulator[0].writes / ITERATIONS);
+  int32_t temperature, humidity, pressure;
+  simulator[0].reads = simulator[0].writes = 0;
+  simulated                                = simulatedTime;
+  begin                                    = clock::now();
+  for (uint32_t i = 0; i < ITERATIONS; i++) sensor.getSensorData(temperature, humidity, pressure);
+  nanoseconds = std::chrono::duration<double, std::nano>(clock::now() - begin).count();
+  printf("%-13s getSensorData() %7.0f ns, %6.0f us incl. conversion, %4.1f reads, %4.1f writes\n",
+         bus, nanoseconds / ITERATIONS, (double)(simulatedTime - simulated) / ITERATIONS,
+         (double)simulator[0].reads / ITERATIONS, (double)simulator[0].writes / ITERATIONS);
+}  // of function benchmark()
+
+int main() {
+  BME280_Device<BME280_I2CBus> i2c;
+  benchmark<BME280_Device<BME280_I2CBus>>("I2C", i2c, [](BME280_Device<BME280_I2CBus> &sensor) {
+    return (sensor.begin(I2C_STANDARD_MODE, 0x77));
+  });
+  BME280_Device<BME280_HardwareSPIBus> hardwareSPI;
+  benchmark<BME280_Device<BME280_HardwareSPIBus>>(
+      "hardware SPI", hardwareSPI,
+      [](BME280_Device<BME280_HardwareSPIBus> &sensor) { return (sensor.begin(10)); });
+  BME280_Device<BME280_SoftwareSPIBus> softwareSPI;
+  benchmark<BME280_Device<BME280_SoftwareSPIBus>>(
+      "software SPI", softwareSPI, [](BME280_Device<BME280_SoftwareSPIBus> &sensor) {
+        return (sensor.begin(10, BME280_SIM_MOSI, BME280_SIM_MISO, BME280_SIM_SCK));
+      });
+  return (0);
+}  // of function main()
@@ -0,0 +1,98 @@
+/*!
+ @file bench_metrics.cpp
+
+ @section bench_metrics_intro_section Description
+
+ Microbenchmark of the derived values of BME280_Metrics.h on the host: the time per call of each
+ integer function next to that of the floating point formula it replaces. On a computer with a
+ floating point unit the formulas are often faster, the integer functions are meant for 8-bit
+ processors where pow(), log() and exp() are done in software and take several kilobytes\n\n
+
+ See main library header file for details
+*/
+#include <math.h>   // Floating point formulas
+#include <stdio.h>  // printf()
+
+#include <chrono>  // Host time
+
+#include "BME280_Metrics.h"
+
+const uint16_t INPUTS     = 1000;  ///< Different inputs per batch
+const uint16_t ITERATIONS = 200;   ///< Batches per result
+
+static volatile int32_t sink;  ///< Keeps the compiler from dropping the calls
+
+template <class Function>
+static double measure(Function function) {
+  /*!
+   * @brief     returns the time per call in nanoseconds
+   * @param[in] function Called with the input number, from 0 to INPUTS - 1
+   * @return    Nanoseconds per call
+   */
+  typedef std::chrono::steady_clock clock;
+  clock::time_point                 begin = clock::now();
+  for (uint16_t i = 0; i < ITERATIONS; i++)
+    for (uint16_t input = 0; input < INPUTS; input++) sink = function(input);
+  return (std::chrono::duration<double, std::nano>(clock::now() - begin).count() / INPUTS /
+          ITERATIONS);
+}  // of function measure()
+static double magnus(const double temperature) {
+  /*!
+   * @brief     returns the exponent of the Magnus formula
+   * @param[in] temperature Temperature in degrees
+   * @return    b * T / (c + T)
+   */
+  return (17.62 * temperature / (243.12 + temperature));
+}  // of function magnus()
+static void show(const char *name, const double integer, const double floating) {
+  /*!
+   * @brief     prints the times of one derived value
+   * @param[in] name Name of the function
+   * @param[in] integer Nanoseconds per call of the integer function
+   * @param[in] floating Nanoseconds per call of the floating point formula
+   */
+  printf("%-19s %6.1f ns integer, %6.1f ns floating point\n", name, integer, floating);
+}  // of function show()
+
+int main() {
+  // Pressures from 30000Pa to 110000Pa, altitudes from -500m to 9500m, temperatures from -40 to
+  // 85 degrees and humidities from 0% to 100%
+  show(
+      "altitude()", measure([](uint16_t i) { return BME280_Metrics::altitude(30000 + i * 80); }),
+      measure([](uint16_t i) {
+        return (int32_t)(4433000.0 * (1.0 - pow((30000 + i * 80) / 101325.0, 0.190295)));
+      }));
+  show("seaLevelPressure()",
+       measure([](uint16_t i) {
+         return BME280_Metrics::seaLevelPressure(90000 + i * 10, -50000 + i * 1000);
+       }),
+       measure([](uint16_t i) {
+         return (int32_t)((90000 + i * 10) /
+                          pow(1.0 - (-50000 + i * 1000) / 4433000.0, 1.0 / 0.190295));
+       }));
+  show("dewPoint()",
+       measure([](uint16_t i) { return BME280_Metrics::dewPoint(-4000 + i * 12, i * 10); }),
+       measure([](uint16_t i) {
+         double gamma = log((i * 10 + 1) / 10000.0) + magnus((-4000 + i * 12) / 100.0);
+         return (int32_t)(24312.0 * gamma / (17.62 - gamma));
+       }));
+  show("absoluteHumidity()",
+       measure([](uint16_t i) { return BME280_Metrics::absoluteHumidity(-4000 + i * 12, i * 10); }),
+       measure([](uint16_t i) {
+         double temperature = (-4000 + i * 12) / 100.0;
+         return (int32_t)(611.2 * exp(magnus(temperature)) * i / 1000.0 /
+                          (461.5 * (temperature + 273.15)) * 1e6);
+       }));
+  show("heatIndex()",
+       measure([](uint16_t i) { return BME280_Metrics::heatIndex(2000 + i * 3, i * 10); }),
+       measure([](uint16_t i) {
+         double t = (2000 + i * 3) * 0.018 + 32.0, r = i / 10.0;
+         double index = -42.379 + 2.04901523 * t + 10.14333127 * r - 0.22475541 * t * r -
+                        0.00683783 * t * t - 0.05481717 * r * r + 0.00122874 * t * t * r +
+                        0.00085282 * t * r * r - 0.00000199 * t * t * r * r;
+         if (r < 13.0 && t >= 80.0 && t <= 112.0)
+           index -= (13.0 - r) / 4.0 * sqrt((17.0 - fabs(t - 95.0)) / 17.0);
+         return (int32_t)((index - 32.0) * 100.0 / 1.8);
+       }));
+  return (0);
+}  // of function main()
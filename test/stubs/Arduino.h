@@ -0,0 +1,86 @@
+/*!
+ @file Arduino.h
+
+ @section Arduino_intro_section Description
+
+ Minimal stand-in for the Arduino core used by the host build of the BME280 library tests\n\n
+
+ Only the functions and types used by the library are declared. The pin and time functions are
+ implemented by the simulated BME280 in BME280_Simulator.cpp, so all time is simulated time.\n\n
+
+ See main library header file for details
+*/
+#ifndef Arduino_h
+/*! @brief Define guard code to prevent multiple inclusions */
+#define Arduino_h
+#include <math.h>    // Floating point functions
+#include <stddef.h>  // size_t
+#include <stdint.h>  // Standard integer types
+#include <string.h>  // memcpy(), memcmp() and memset()
+
+#define HIGH 0x1      ///< Pin level high
+#define LOW 0x0       ///< Pin level low
+#define INPUT 0x0     ///< Pin mode input
+#define OUTPUT 0x1    ///< Pin mode output
+#define LSBFIRST 0    ///< Bit order least significant bit first
+#define MSBFIRST 1    ///< Bit order most significant bit first
+#define DEC 10        ///< Print in decimal
+#define HEX 16        ///< Print in hexadecimal
+#define F(string) string  ///< Strings stay in RAM on the host
+
+typedef bool    boolean;  ///< Arduino boolean type
+typedef uint8_t byte;     ///< Arduino byte type
+
+void          pinMode(uint8_t pin, uint8_t mode);
+void          digitalWrite(uint8_t pin, uint8_t value);
+int           digitalRead(uint8_t pin);
+unsigned long micros();
+unsigned long millis();
+void          delay(unsigned long ms);
+void          delayMicroseconds(unsigned int us);
+inline void   yield() {}
+inline void   interrupts() {}
+inline void   noInterrupts() {}
+
+class Print {
+  /*!
+    @class   Print
+    @brief   Character output, derived classes only implement write()
+  */
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  size_t         print(const char c) { return write((uint8_t)c); }
+  size_t         print(const char *text) {
+    size_t n = 0;
+    while (*text) n += write((uint8_t)*text++);
+    return n;
+  }  // of method print()
+  size_t print(unsigned long value, const int base = DEC) {
+    char   digits[33];
+    size_t count = 0;
+    do {
+      uint8_t digit     = value % base;
+      digits[count++]   = digit < 10 ? '0' + digit : 'A' + digit - 10;
+      value            /= base;
+    } while (value);
+    size_t n = 0;
+    while (count) n += write((uint8_t)digits[--count]);
+    return n;
+  }  // of method print()
+  size_t print(long value, const int base = DEC) {
+    if (value >= 0) return print((unsigned long)value, base);
+    return print('-') + print((unsigned long)-value, base);
+  }  // of method print()
+  size_t print(unsigned int value, const int base = DEC) {
+    return print((unsigned long)value, base);
+  }
+  size_t print(int value, const int base = DEC) { return print((long)value, base); }
+  size_t print(uint8_t value, const int base = DEC) { return print((unsigned long)value, base); }
+  size_t println() { return print('\r') + print('\n'); }
+  template <typename T>
+  size_t println(const T value) {
+    return print(value) + println();
+  }  // of method println()
+};   // of class Print
+#endif
@@ -0,0 +1,44 @@
+/*!
+ @file SPI.h
+
+ @section SPI_intro_section Description
+
+ Minimal stand-in for the Arduino "SPI" library used by the host build of the BME280 library
+ tests. The transfers are answered by the simulated BME280 in BME280_Simulator.cpp\n\n
+
+ See main library header file for details
+*/
+#ifndef _SPI_H_INCLUDED
+/*! @brief Define guard code to prevent multiple inclusions */
+#define _SPI_H_INCLUDED
+#include "Arduino.h"
+
+#define SPI_MODE0 0x00  ///< Clock idle low, data sampled on the rising edge
+
+class SPISettings {
+  /*!
+    @class   SPISettings
+    @brief   Clock, bit order and mode of an SPI transaction
+  */
+ public:
+  SPISettings(uint32_t clock = 4000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0)
+      : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+  uint32_t clock;     ///< Clock rate in Hz
+  uint8_t  bitOrder;  ///< MSBFIRST or LSBFIRST
+  uint8_t  dataMode;  ///< SPI mode
+};                    // of class SPISettings
+
+class SPIClass {
+  /*!
+    @class   SPIClass
+    @brief   Hardware SPI interface of the Arduino "SPI" library
+  */
+ public:
+  void    begin();
+  void    beginTransaction(SPISettings settings);
+  void    endTransaction();
+  uint8_t transfer(uint8_t data);
+  void    transfer(void *buffer, size_t count);
+};  // of class SPIClass
+extern SPIClass SPI;  ///< The hardware SPI interface
+#endif
@@ -0,0 +1,32 @@
+/*!
+ @file Wire.h
+
+ @section Wire_intro_section Description
+
+ Minimal stand-in for the Arduino "Wire" library used by the host build of the BME280 library
+ tests. The transfers are answered by the simulated BME280 in BME280_Simulator.cpp\n\n
+
+ See main library header file for details
+*/
+#ifndef TwoWire_h
+/*! @brief Define guard code to prevent multiple inclusions */
+#define TwoWire_h
+#include "Arduino.h"
+
+class TwoWire {
+  /*!
+    @class   TwoWire
+    @brief   I2C master interface of the Arduino "Wire" library
+  */
+ public:
+  void    begin();
+  void    setClock(uint32_t clock);
+  void    beginTransmission(uint8_t address);
+  size_t  write(uint8_t data);
+  uint8_t endTransmission(bool stop = true);
+  uint8_t requestFrom(uint8_t address, uint8_t quantity);
+  int     available();
+  int     read();
+};  // of class TwoWire
+extern TwoWire Wire;  ///< The I2C interface
+#endif
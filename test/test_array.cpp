@@ -0,0 +1,95 @@
+/*!
+ @file test_array.cpp
+
+ @section test_array_intro_section Description
+
+ Host test of BME280_Array: the I2C scan starts the bus once, finds both simulated devices and
+ doesn't add a managed device again, and all devices are measured in one conversion window. A
+ recorded array session is replayed with the clock of the computer stopped, so the array only
+ uses the clock of its devices' bus policies\n\n
+
+ See main library header file for details
+*/
+#include "BME280.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+#include "BME280_Trace.h"
+
+const uint8_t  CYCLES = 3;     ///< Array measurements in the recorded session
+const uint16_t SIZE   = 2048;  ///< Bytes of each trace buffer
+
+static uint8_t  traces[2][SIZE];  ///< Recorded traffic of each device
+static uint16_t lengths[2];       ///< Bytes in each trace
+
+int main() {
+  simulatorPowerOn(2);
+  simulator[1].measure(BME280_SIM_ADC_T + 16000, BME280_SIM_ADC_P, BME280_SIM_ADC_H);
+  int32_t temperature[4], humidity[4], pressure[4];
+
+  // The scan finds both devices, a second scan adds nothing
+  BME280_Array<4> sensors;
+  CHECK_EQUAL(2, sensors.scanI2C());
+  CHECK_EQUAL(1, wireBegins);
+  CHECK_EQUAL(0x76, sensors[0].bus().address());
+  CHECK_EQUAL(0x77, sensors[1].bus().address());
+  uint32_t reads = simulator[0].reads + simulator[1].reads;
+  CHECK_EQUAL(2, sensors.scanI2C());
+  CHECK_EQUAL(2, wireBegins);
+  CHECK_EQUAL(reads, simulator[0].reads + simulator[1].reads);  // Managed addresses not probed
+
+  // An SPI device added to the same array, all are measured in the same conversion window
+  CHECK(sensors.add(simulator[0].chipSelect));
+  CHECK_EQUAL(3, sensors.count());
+  CHECK(sensors.apply(BME280_WEATHER_MONITORING));
+  uint32_t start = simulatedTime;
+  CHECK_EQUAL(3, sensors.getSensorData(temperature, humidity, pressure));
+  CHECK(simulatedTime - start < 2 * sensors[0].conversionTime(MaximumMeasure));
+  CHECK(temperature[0] > temperature[1] + 100);  // Device 1 is warmer
+  CHECK_EQUAL(2508, temperature[1]);
+  CHECK_EQUAL(2508, temperature[2]);
+
+  // A device which stops answering doesn't hold up the others
+  simulator[1].nak = BME280_SIM_NAK_ALL;
+  CHECK_EQUAL(2, sensors.getSensorData(temperature, humidity, pressure));
+  simulator[1].nak = 0;
+
+  // A scan stops when the array is full
+  simulatorPowerOn(2);
+  BME280_Array<1> one;
+  CHECK_EQUAL(1, one.scanI2C());
+  CHECK_EQUAL(1, one.scanI2C());
+  CHECK(!one.add(I2C_STANDARD_MODE, 0x77));
+
+  // Record an array session, then replay it without the devices and with the clock stopped
+  int32_t recorded[CYCLES][2], replayed[CYCLES][2];
+  simulatorPowerOn(2);
+  simulator[1].measure(BME280_SIM_ADC_T + 16000, BME280_SIM_ADC_P, BME280_SIM_ADC_H);
+  BME280_Array<2, BME280_Device<BME280_TraceBus<BME280_I2CBus, SIZE>>> recorder;
+  CHECK(recorder.add(I2C_STANDARD_MODE, (uint8_t)0x77));
+  CHECK(recorder.add(I2C_BUS_STARTED, (uint8_t)0x76));
+  CHECK(recorder.apply(BME280_WEATHER_MONITORING));
+  for (uint8_t c = 0; c < CYCLES; c++)
+    CHECK_EQUAL(2, recorder.getSensorData(recorded[c], humidity, pressure));
+  for (uint8_t i = 0; i < 2; i++) {
+    CHECK_EQUAL(0, recorder[i].bus().dropped());
+    lengths[i] = recorder[i].bus().copyTrace(traces[i], SIZE);
+  }  // of for-next each device
+  simulator[0].present = simulator[1].present = false;
+  uint32_t                                         stopped = simulatedTime;
+  BME280_Array<2, BME280_Device<BME280_ReplayBus>> replay;
+  CHECK(replay.add(traces[0], lengths[0]));
+  CHECK(replay.add(traces[1], lengths[1]));
+  CHECK(replay.apply(BME280_WEATHER_MONITORING));
+  for (uint8_t c = 0; c < CYCLES; c++) {
+    CHECK_EQUAL(2, replay.getSensorData(replayed[c], humidity, pressure));
+    CHECK_EQUAL(recorded[c][0], replayed[c][0]);
+    CHECK_EQUAL(recorded[c][1], replayed[c][1]);
+  }  // of for-next each cycle
+  CHECK_EQUAL(stopped, simulatedTime);  // Neither micros() nor delay() of the computer was used
+  for (uint8_t i = 0; i < 2; i++) {
+    CHECK(replay[i].bus().finished());
+    CHECK_EQUAL(0, replay[i].bus().mismatches());
+  }  // of for-next each device
+  CHECK(recorded[0][0] != recorded[0][1]);
+  return (testResult("array"));
+}  // of function main()
@@ -0,0 +1,79 @@
+/*!
+ @file test_calibration.cpp
+
+ @section test_calibration_intro_section Description
+
+ Host test of the calibration load: both trimming blocks are read in one burst each and every
+ value, including the 12-bit humidity values split over shared nibbles, is decoded as laid out in
+ section 4.2.2 of the datasheet. The decoded values give the datasheet's example readings\n\n
+
+ See main library header file for details
+*/
+#include "BME280.h"
+#include "BME280_Reference.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+
+static void checkCalibration(const BME280_Calibration &expected, const BME280_Calibration &actual) {
+  /*!
+   * @brief     checks that all calibration values are equal
+   * @param[in] expected Calibration written to the device registers
+   * @param[in] actual Calibration decoded by the library
+   */
+  CHECK_EQUAL(expected.dig_T1, actual.dig_T1);
+  CHECK_EQUAL(expected.dig_T2, actual.dig_T2);
+  CHECK_EQUAL(expected.dig_T3, actual.dig_T3);
+  CHECK_EQUAL(expected.dig_P1, actual.dig_P1);
+  CHECK_EQUAL(expected.dig_P2, actual.dig_P2);
+  CHECK_EQUAL(expected.dig_P3, actual.dig_P3);
+  CHECK_EQUAL(expected.dig_P4, actual.dig_P4);
+  CHECK_EQUAL(expected.dig_P5, actual.dig_P5);
+  CHECK_EQUAL(expected.dig_P6, actual.dig_P6);
+  CHECK_EQUAL(expected.dig_P7, actual.dig_P7);
+  CHECK_EQUAL(expected.dig_P8, actual.dig_P8);
+  CHECK_EQUAL(expected.dig_P9, actual.dig_P9);
+  CHECK_EQUAL(expected.dig_H1, actual.dig_H1);
+  CHECK_EQUAL(expected.dig_H2, actual.dig_H2);
+  CHECK_EQUAL(expected.dig_H3, actual.dig_H3);
+  CHECK_EQUAL(expected.dig_H4, actual.dig_H4);
+  CHECK_EQUAL(expected.dig_H5, actual.dig_H5);
+  CHECK_EQUAL(expected.dig_H6, actual.dig_H6);
+}  // of function checkCalibration()
+
+int main() {
+  BME280_Device<BME280_HardwareSPIBus> sensor;
+  int32_t                              temperature, humidity, pressure;
+
+  // The datasheet example, read with the chip id, two calibration bursts and one settings burst
+  simulatorPowerOn();
+  CHECK(sensor.begin(simulator[0].chipSelect));
+  CHECK_EQUAL(4, simulator[0].reads);
+  checkCalibration(BME280_SIM_CALIBRATION, sensor.calibration());
+  CHECK(sensor.apply(BME280_WEATHER_MONITORING));
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(2508, temperature);  // 25.08 degrees, section 8.1 of the datasheet
+#if BME280_COMPENSATION == BME280_COMPENSATION_INT64
+  CHECK_EQUAL(100653, pressure);  // 1006.53 hPa, section 8.2 of the datasheet
+#endif
+
+  // Extreme values of every field, with the sign bits of the split 12-bit values set
+  BME280_Calibration limits = {65535, -32768, 32767, 65535, -32768, 32767, -32768, 32767, -32768,
+                               32767, -32768, 32767, -32768, -2048, 2047, 255, 255, -128};
+  BME280_Calibration other = {28000, 26000, 50, 36000, -10600, 3000, 7000, -60, -7,
+                              9900, -10230, 4285, 380, 280, 0, 75, 0, 30};
+  const BME280_Calibration *calibrations[] = {&limits, &other};
+  for (uint8_t i = 0; i < 2; i++) {
+    simulatorPowerOn();
+    simulator[0].calibrate(*calibrations[i]);
+    CHECK(sensor.begin(simulator[0].chipSelect));
+    checkCalibration(*calibrations[i], sensor.calibration());
+    CHECK(sensor.apply(BME280_WEATHER_MONITORING));
+    CHECK(sensor.getSensorData(temperature, humidity, pressure));
+    BME280_Reading expected =
+        reference(*calibrations[i], BME280_SIM_ADC_T, BME280_SIM_ADC_P, BME280_SIM_ADC_H);
+    CHECK_EQUAL(expected.temperature, temperature);
+    CHECK_EQUAL(expected.pressure, pressure);
+    CHECK_EQUAL(expected.humidity, humidity);
+  }  // of for-next each calibration
+  return (testResult("calibration"));
+}  // of function main()
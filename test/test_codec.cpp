@@ -0,0 +1,235 @@
+/*!
+ @file test_codec.cpp
+
+ @section test_codec_intro_section Description
+
+ Host test of the sample format of BME280_Codec.h: readings written in packets are read back
+ exactly, also across the wrap of the sequence byte and with jumps over the whole value range. A
+ damaged header is rejected, a record cut short is not returned, and after a lost packet or record
+ no reading is returned with wrong values, decoding starts again at the next keyframe\n\n
+
+ See main library header file for details
+*/
+#include <string.h>  // memcpy()
+
+#include "BME280_Codec.h"
+#include "BME280_Test.h"
+
+const uint16_t SAMPLES     = 700;  ///< Readings in a stream, the sequence byte wraps twice
+const uint16_t PACKETS     = 500;  ///< Most packets in a stream
+const uint8_t  PACKET_SIZE = 32;   ///< Bytes per packet
+
+static BME280_Reading readings[SAMPLES];              ///< Readings written
+static uint8_t        packets[PACKETS][PACKET_SIZE];  ///< Packets written
+static uint16_t       lengths[PACKETS];               ///< Bytes in each packet
+static uint16_t       packetCount = 0;                ///< Packets written
+static bool           seen[SAMPLES];                  ///< Samples returned by the decoder
+
+static void makeReadings(const bool jumps) {
+  /*!
+   * @brief     fills the readings with slowly changing values, or with jumps across the range
+   * @param[in] jumps "true" for readings which change between extreme values
+   */
+  for (uint16_t i = 0; i < SAMPLES; i++) {
+    readings[i].temperature = 2500 + (int32_t)(i % 7) - 3 + i / 8;
+    readings[i].humidity    = 45000 - (int32_t)(i % 5) * 3;
+    readings[i].pressure    = 10132500 + (int32_t)(i % 11) * 25 - (int32_t)i;
+    if (jumps && i % 3 == 1) {
+      readings[i].temperature = (i % 2) ? INT32_MIN : INT32_MAX;
+      readings[i].humidity    = (i % 2) ? INT32_MAX : INT32_MIN;
+      readings[i].pressure    = -(int32_t)i * 100000;
+    }  // of if-then jump
+  }    // of for-next each reading
+}  // of function makeReadings()
+static void encode(const uint16_t keyframeInterval, const bool keyPackets) {
+  /*!
+   * @brief     writes all readings into packets
+   * @param[in] keyframeInterval Readings between keyframes, 0 for only the first one
+   * @param[in] keyPackets "true" to start each packet with a keyframe
+   */
+  BME280_Encoder encoder;
+  packetCount = 0;
+  encoder.begin(packets[0], PACKET_SIZE, keyframeInterval);
+  for (uint16_t i = 0; i < SAMPLES; i++) {
+    if (!encoder.add(readings[i])) {
+      lengths[packetCount++] = encoder.length();
+      encoder.begin(packets[packetCount], PACKET_SIZE, keyframeInterval);
+      if (keyPackets) encoder.keyframe();
+      CHECK(encoder.add(readings[i]));
+    }  // of if-then packet is full
+  }    // of for-next each reading
+  lengths[packetCount++] = encoder.length();
+  CHECK_EQUAL(SAMPLES, encoder.samples());
+}  // of function encode()
+static uint16_t decode(BME280_Decoder &decoder, const uint8_t *data, const uint16_t length) {
+  /*!
+   * @brief     reads all readings of a packet and checks each one against the reading written
+   * @param[in] decoder Decoder of the stream
+   * @param[in] data Packet
+   * @param[in] length Bytes in the packet
+   * @return    Number of readings returned
+   */
+  BME280_Reading reading;
+  uint16_t       count = 0;
+  decoder.begin(data, length);
+  while (decoder.next(reading)) {
+    uint32_t sample = decoder.sample();
+    if (!CHECK(sample < SAMPLES)) break;
+    CHECK(!seen[sample]);
+    seen[sample] = true;
+    CHECK_EQUAL(readings[sample].temperature, reading.temperature);
+    CHECK_EQUAL(readings[sample].humidity, reading.humidity);
+    CHECK_EQUAL(readings[sample].pressure, reading.pressure);
+    count++;
+  }  // of while-loop each reading
+  CHECK_EQUAL(length, decoder.position());  // Packets only hold complete records
+  return (count);
+}  // of function decode()
+static uint16_t decodeAll(BME280_Decoder &decoder, const uint16_t lost) {
+  /*!
+   * @brief     reads all packets of a stream except one
+   * @param[in] decoder Decoder of the stream
+   * @param[in] lost Packet to leave out, PACKETS for none
+   * @return    Number of readings returned
+   */
+  uint16_t count = 0;
+  decoder.reset();
+  memset(seen, 0, sizeof(seen));
+  for (uint16_t p = 0; p < packetCount; p++)
+    if (p != lost) count += decode(decoder, packets[p], lengths[p]);
+  return (count);
+}  // of function decodeAll()
+static uint16_t firstSample(const uint16_t packet) {
+  /*!
+   * @brief     returns the sample number of the first reading of a packet
+   * @param[in] packet Packet number
+   * @return    Sample number
+   */
+  BME280_Decoder decoder;
+  BME280_Reading reading;
+  uint16_t       count = 0;
+  for (uint16_t p = 0; p < packet; p++) {
+    decoder.begin(packets[p], lengths[p]);
+    while (decoder.next(reading)) count++;
+  }  // of for-next each earlier packet
+  return (count);
+}  // of function firstSample()
+
+int main() {
+  BME280_Decoder decoder;
+
+  // The header holds the settings and calibration values and is protected by its CRC
+  BME280_Config      config = {Oversample2, Oversample16, Oversample1, IIR16, inactive125ms,
+                               NormalMode};
+  BME280_Calibration cal    = {28485, 26735, 50,  36738, -10635, 3024, 6980, -4, -7, 9900,
+                               -10230, 4285, 362, 313, 50, 75, 0, -30};
+  BME280_Config      configRead;
+  BME280_Calibration calRead;
+  uint8_t            header[BME280_CODEC_HEADER_LENGTH + 1];
+  BME280_Encoder     encoder;
+  encoder.begin(header, BME280_CODEC_HEADER_LENGTH - 1);
+  CHECK(!encoder.header(config, cal));
+  encoder.begin(header, sizeof(header));
+  CHECK(encoder.header(config, cal));
+  CHECK_EQUAL(BME280_CODEC_HEADER_LENGTH, encoder.length());
+  decoder.begin(header, BME280_CODEC_HEADER_LENGTH);
+  CHECK(decoder.header(configRead, calRead));
+  CHECK_EQUAL(BME280_CODEC_HEADER_LENGTH, decoder.position());
+  CHECK_EQUAL(config.iirFilter, configRead.iirFilter);
+  CHECK_EQUAL(config.mode, configRead.mode);
+  CHECK_EQUAL(cal.dig_T1, calRead.dig_T1);
+  CHECK_EQUAL(cal.dig_P2, calRead.dig_P2);
+  CHECK_EQUAL(cal.dig_H5, calRead.dig_H5);
+  CHECK_EQUAL(cal.dig_H6, calRead.dig_H6);
+  for (uint8_t i = 0; i < BME280_CODEC_HEADER_LENGTH; i++) {
+    header[i] ^= 0x04;
+    decoder.begin(header, BME280_CODEC_HEADER_LENGTH);
+    CHECK(!decoder.header(configRead, calRead));
+    CHECK_EQUAL(0, decoder.position());
+    header[i] ^= 0x04;
+  }  // of for-next each damaged byte
+  decoder.begin(header, BME280_CODEC_HEADER_LENGTH - 1);
+  CHECK(!decoder.header(configRead, calRead));
+
+  // Round trip, only the first reading is a keyframe
+  makeReadings(false);
+  encode(0, false);
+  CHECK(packetCount < PACKETS);
+  CHECK(packetCount * PACKET_SIZE < SAMPLES * 5);  // At most 5 bytes for slowly changing readings
+  CHECK_EQUAL(SAMPLES, decodeAll(decoder, PACKETS));
+  CHECK_EQUAL(0, decoder.gaps());
+
+  // Round trip of readings jumping across the whole range
+  makeReadings(true);
+  encode(0, false);
+  CHECK(packetCount < PACKETS);
+  CHECK_EQUAL(SAMPLES, decodeAll(decoder, PACKETS));
+  CHECK_EQUAL(0, decoder.gaps());
+
+  // A lost packet, the following differences are skipped until the next keyframe
+  makeReadings(false);
+  encode(50, false);
+  for (uint16_t lost = 1; lost < packetCount - 1; lost += 7) {
+    uint16_t first = firstSample(lost), next = firstSample(lost + 1);
+    uint16_t key   = (next + 49) / 50 * 50;  // First keyframe after the lost packet
+    if (key >= SAMPLES) key = SAMPLES;
+    CHECK_EQUAL(SAMPLES - (key - first), decodeAll(decoder, lost));
+    CHECK_EQUAL(1, decoder.gaps());
+    for (uint16_t i = first; i < key; i++) CHECK(!seen[i]);
+  }  // of for-next each lost packet
+
+  // A lost packet when each packet starts with a keyframe, nothing but the lost packet is missing
+  encode(0, true);
+  uint16_t first = firstSample(5), next = firstSample(6);
+  CHECK_EQUAL(SAMPLES - (next - first), decodeAll(decoder, 5));
+  CHECK_EQUAL(1, decoder.gaps());
+
+  // A single record lost from within a packet
+  encode(0, false);
+  BME280_Reading reading;
+  uint8_t        damaged[PACKET_SIZE];
+  uint16_t       starts[PACKET_SIZE];  // Position of each record in packet 3
+  uint8_t        records = 0;
+  decoder.reset();
+  for (uint8_t p = 0; p < 3; p++) {
+    decoder.begin(packets[p], lengths[p]);
+    while (decoder.next(reading)) continue;
+  }  // of for-next each earlier packet
+  decoder.begin(packets[3], lengths[3]);
+  do starts[records++] = decoder.position();
+  while (decoder.next(reading));
+  CHECK(records > 3);
+  uint16_t cut = starts[2], cutLength = starts[3] - starts[2];
+  memcpy(damaged, packets[3], cut);
+  memcpy(damaged + cut, packets[3] + cut + cutLength, lengths[3] - cut - cutLength);
+  memcpy(packets[3], damaged, lengths[3] - cutLength);
+  lengths[3] -= cutLength;
+  first = firstSample(3);
+  CHECK_EQUAL(first + 2, decodeAll(decoder, PACKETS));  // Nothing after the lost record
+  CHECK_EQUAL(1, decoder.gaps());
+
+  // A record cut short is not returned and is read once the rest of it is available
+  encode(0, false);
+  decoder.reset();
+  decoder.begin(packets[0], lengths[0]);
+  CHECK(decoder.next(reading));
+  CHECK(decoder.next(reading));
+  uint16_t position = decoder.position();
+  CHECK(decoder.next(reading));
+  uint16_t end = decoder.position();
+  for (uint16_t length = position; length < end; length++) {
+    decoder.reset();
+    decoder.begin(packets[0], length);
+    CHECK(decoder.next(reading) && decoder.next(reading));
+    CHECK(!decoder.next(reading));
+    CHECK_EQUAL(position, decoder.position());
+  }  // of for-next each length cutting the third record
+  decoder.begin(packets[0], end);  // The values of the first two readings carry over
+  CHECK(decoder.next(reading));
+  decoder.reset();
+  decoder.begin(packets[0], end);
+  CHECK(decoder.next(reading) && decoder.next(reading) && decoder.next(reading));
+  CHECK_EQUAL(2, decoder.sample());
+  CHECK_EQUAL(readings[2].pressure, reading.pressure);
+  return (testResult("codec"));
+}  // of function main()
@@ -0,0 +1,59 @@
+/*!
+ @file test_coefficients.cpp
+
+ @section test_coefficients_intro_section Description
+
+ Host test of the precomputed compensation coefficients: with the calibration values of several
+ devices, including negative trimming values and the extremes of the 12-bit humidity values, the
+ library's engine gives exactly the readings of the reference formulas which compute every term
+ for each reading. Each device only holds the coefficients of the selected engine\n\n
+
+ See main library header file for details
+*/
+#include "BME280_Reference.h"
+#include "BME280_Test.h"
+
+/*! Calibration values of other devices and of limits of the trimming values, in the order of
+ * BME280_Calibration: T1-T3, P1-P9, H2, H4, H5, H1, H3, H6 */
+static const BME280_Calibration CALIBRATIONS[] = {
+    {28485, 26735, 50, 36738, -10635, 3024, 6980, -4, -7, 9900, -10230, 4285, 362, 313, 50, 75, 0,
+     30},
+    {27834, 26703, 50, 37603, -10600, 3024, 8421, -129, -7, 12300, -7600, 4285, 356, 326, 0, 75,
+     0, 30},
+    {27504, 26435, -1000, 36477, -10685, 3024, -2855, 140, -7, 15500, -14600, 6000, 420, -2048,
+     2047, 100, 255, -128},
+    {30000, 28000, -3000, 40000, -12000, 5000, 10000, -1000, -100, 20000, -20000, 8000, 300, 2047,
+     -2048, 0, 0, 127},
+};
+
+int main() {
+#if BME280_COMPENSATION == BME280_COMPENSATION_FLOAT
+  CHECK_EQUAL(19 * sizeof(double), sizeof(BME280_Coefficients));
+#elif BME280_COMPENSATION == BME280_COMPENSATION_INT32
+  CHECK_EQUAL(4 * sizeof(int32_t), sizeof(BME280_Coefficients));
+#else
+  CHECK_EQUAL(2 * sizeof(int64_t) + 4 * sizeof(int32_t), sizeof(BME280_Coefficients));
+#endif
+  BME280_Core core;
+  uint32_t    compared = 0;
+  for (uint8_t c = 0; c < sizeof(CALIBRATIONS) / sizeof(CALIBRATIONS[0]); c++) {
+    core.calibration(CALIBRATIONS[c]);
+    for (int32_t adcT = 380000; adcT <= 660000; adcT += 14000)
+      for (int32_t adcP = 200000; adcP <= 640000; adcP += 22000)
+        for (int32_t adcH = 0; adcH <= 65000; adcH += 5000) {
+          BME280_RawSample raw      = rawSample(adcT, adcP, adcH);
+          BME280_Reading   expected = reference(CALIBRATIONS[c], adcT, adcP, adcH), actual;
+          core.compensate(&raw, &actual, 1);
+          compared++;
+          if (!CHECK_EQUAL(expected.temperature, actual.temperature) ||
+              !CHECK_EQUAL(expected.pressure, actual.pressure) ||
+              !CHECK_EQUAL(expected.humidity, actual.humidity)) {
+            printf("  calibration %u at adcT=%d adcP=%d adcH=%d\n", (unsigned)c, (int)adcT,
+                   (int)adcP, (int)adcH);
+            return (testResult("coefficients"));
+          }  // of if-then mismatch
+        }    // of for-next each humidity
+  }          // of for-next each calibration
+  printf("%u raw readings compared\n", (unsigned)compared);
+  return (testResult("coefficients"));
+}  // of function main()
@@ -0,0 +1,73 @@
+/*!
+ @file test_compensation.cpp
+
+ @section test_compensation_intro_section Description
+
+ Host test of the compensation: the datasheet example read over all three buses, and the
+ library's engine compared with the reference formulas over the sensor's range of raw readings\n\n
+
+ See main library header file for details
+*/
+#include "BME280.h"
+#include "BME280_Reference.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+
+static void checkExample(BME280_Class &sensor) {
+  /*!
+   * @brief     checks the readings of the datasheet example
+   * @param[in] sensor Started device
+   */
+  BME280_Reading expected =
+      reference(BME280_SIM_CALIBRATION, BME280_SIM_ADC_T, BME280_SIM_ADC_P, BME280_SIM_ADC_H);
+  int32_t temperature = 0, humidity = 0, pressure = 0;
+  CHECK(sensor.apply(BME280_WEATHER_MONITORING));
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(2508, temperature);  // 25.08 degrees, section 8.1 of the datasheet
+  CHECK_EQUAL(expected.humidity, humidity);
+  CHECK_EQUAL(expected.pressure, pressure);
+#if BME280_COMPENSATION == BME280_COMPENSATION_INT64
+  CHECK_EQUAL(100653, pressure);  // 1006.53 hPa with the 64-bit formula, section 8.2
+  CHECK_EQUAL(5499, humidity);
+#endif
+}  // of function checkExample()
+
+int main() {
+  simulatorPowerOn();
+  BME280_Class i2c;
+  CHECK(i2c.begin());
+  checkExample(i2c);
+
+  simulatorPowerOn();
+  BME280_Class hardwareSPI;
+  CHECK(hardwareSPI.begin(simulator[0].chipSelect));
+  checkExample(hardwareSPI);
+
+  simulatorPowerOn();
+  BME280_Class softwareSPI;
+  CHECK(softwareSPI.begin(simulator[0].chipSelect, BME280_SIM_MOSI, BME280_SIM_MISO,
+                          BME280_SIM_SCK));
+  checkExample(softwareSPI);
+
+  // Every combination of raw readings over the range the sensor delivers between -40 and 85
+  // degrees, 300 and 1100 hPa and 0 and 100%
+  BME280_Core core;
+  core.calibration(BME280_SIM_CALIBRATION);
+  uint32_t compared = 0;
+  for (int32_t adcT = 380000; adcT <= 660000; adcT += 7000)
+    for (int32_t adcP = 200000; adcP <= 640000; adcP += 11000)
+      for (int32_t adcH = 10000; adcH <= 60000; adcH += 2500) {
+        BME280_RawSample raw      = rawSample(adcT, adcP, adcH);
+        BME280_Reading   expected = reference(BME280_SIM_CALIBRATION, adcT, adcP, adcH), actual;
+        core.compensate(&raw, &actual, 1);
+        compared++;
+        if (!CHECK_EQUAL(expected.temperature, actual.temperature) ||
+            !CHECK_EQUAL(expected.pressure, actual.pressure) ||
+            !CHECK_EQUAL(expected.humidity, actual.humidity)) {
+          printf("  at adcT=%d adcP=%d adcH=%d\n", (int)adcT, (int)adcP, (int)adcH);
+          return (testResult("compensation"));
+        }  // of if-then mismatch
+      }    // of for-next each humidity
+  printf("%u raw readings compared\n", (unsigned)compared);
+  return (testResult("compensation"));
+}  // of function main()
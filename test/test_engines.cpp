@@ -0,0 +1,49 @@
+/*!
+ @file test_engines.cpp
+
+ @section test_engines_intro_section Description
+
+ Host test of the accuracy of the compensation engine the test was built with, compared with the
+ 64-bit integer formulas of the datasheet over the sensor's range of raw readings. The 64-bit
+ engine has to match exactly, the 32-bit and floating point engines within the resolution the
+ datasheet gives for them\n\n
+
+ See main library header file for details
+*/
+#include <stdlib.h>  // labs()
+
+#include "BME280_Reference.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+
+int main() {
+#if BME280_COMPENSATION == BME280_COMPENSATION_FLOAT
+  const int32_t LIMIT_T = 1, LIMIT_P = 2, LIMIT_H = 2;  // The integer formulas truncate
+#elif BME280_COMPENSATION == BME280_COMPENSATION_INT32
+  const int32_t LIMIT_T = 0, LIMIT_P = 8, LIMIT_H = 0;  // 1 Pa resolution of the 32-bit formula
+#else
+  const int32_t LIMIT_T = 0, LIMIT_P = 0, LIMIT_H = 0;  // Same formulas
+#endif
+  BME280_Core core;
+  int32_t     errorT = 0, errorP = 0, errorH = 0;
+  core.calibration(BME280_SIM_CALIBRATION);
+  for (int32_t adcT = 380000; adcT <= 660000; adcT += 3500)
+    for (int32_t adcP = 200000; adcP <= 640000; adcP += 5500)
+      for (int32_t adcH = 10000; adcH <= 60000; adcH += 2500) {
+        BME280_RawSample raw = rawSample(adcT, adcP, adcH);
+        BME280_Reading   exact = referenceInt64(BME280_SIM_CALIBRATION, adcT, adcP, adcH), actual;
+        core.compensate(&raw, &actual, 1);
+        if (labs(actual.temperature - exact.temperature) > errorT)
+          errorT = labs(actual.temperature - exact.temperature);
+        if (labs(actual.pressure - exact.pressure) > errorP)
+          errorP = labs(actual.pressure - exact.pressure);
+        if (labs(actual.humidity - exact.humidity) > errorH)
+          errorH = labs(actual.humidity - exact.humidity);
+      }  // of for-next each humidity
+  printf("largest difference to the 64-bit formulas: %d centi-degrees, %d Pa, %d centi-percent\n",
+         (int)errorT, (int)errorP, (int)errorH);
+  CHECK(errorT <= LIMIT_T);
+  CHECK(errorP <= LIMIT_P);
+  CHECK(errorH <= LIMIT_H);
+  return (testResult("engines"));
+}  // of function main()
@@ -0,0 +1,66 @@
+/*!
+ @file test_errors.cpp
+
+ @section test_errors_intro_section Description
+
+ Host test of the error paths: a missing device, a wrong chip id, a bus which stops answering and
+ a measurement which never completes\n\n
+
+ See main library header file for details
+*/
+#include "BME280.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+
+int main() {
+  BME280_Device<BME280_I2CBus> sensor;
+  int32_t                      temperature, humidity, pressure;
+
+  // No device on the bus
+  simulatorPowerOn(0);
+  CHECK(!sensor.begin());
+  CHECK_EQUAL(0, sensor.bus().address());
+  CHECK(!sensor.begin(I2C_STANDARD_MODE, 0x77));
+
+  // A device with another chip id
+  simulatorPowerOn();
+  simulator[0].registers[BME280_CHIPID_REG] = 0x58;  // BMP280
+  CHECK(!sensor.begin(I2C_STANDARD_MODE, 0x77));
+  CHECK_EQUAL(NoError, sensor.lastError());  // The I2C probe already rejects it
+
+  simulatorPowerOn();
+  BME280_Device<BME280_HardwareSPIBus> spi;
+  simulator[0].registers[BME280_CHIPID_REG] = 0x58;
+  CHECK(!spi.begin(simulator[0].chipSelect));
+  CHECK_EQUAL(ChipIdError, spi.lastError());
+
+  // The device stops answering, the previous readings are kept
+  simulatorPowerOn();
+  CHECK(sensor.begin());
+  CHECK_EQUAL(NoError, sensor.lastError());
+  CHECK(sensor.apply(BME280_WEATHER_MONITORING));
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  simulator[0].nak = BME280_SIM_NAK_ALL;
+  temperature      = 0;
+  CHECK(!sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(BusError, sensor.lastError());
+  CHECK_EQUAL(NoError, sensor.lastError());  // Cleared when read
+  CHECK_EQUAL(2508, temperature);
+  simulator[0].nak = 0;
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(NoError, sensor.lastError());
+
+  // The measuring bit never clears, the wait is limited to the maximum conversion time
+  simulatorPowerOn();
+  CHECK(sensor.begin());
+  CHECK(sensor.apply(BME280_WEATHER_MONITORING));
+  simulator[0].stuckBusy = true;
+  uint32_t start         = simulatedTime;
+  CHECK(!sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(TimeoutError, sensor.lastError());
+  CHECK(simulatedTime - start < 4 * (sensor.conversionTime(MaximumMeasure) + 2000));
+  simulator[0].stuckBusy = false;
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(2508, temperature);
+  return (testResult("errors"));
+}  // of function main()
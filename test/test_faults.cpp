@@ -0,0 +1,125 @@
+/*!
+ @file test_faults.cpp
+
+ @section test_faults_intro_section Description
+
+ Host test of the recovery from injected faults: missing acknowledges, reads cut short, a
+ measuring bit which never clears, calibration registers which differ after a reset and a reset
+ of the device in the middle of a conversion. Each fault is reported by lastError(), the previous
+ readings and calibration values are kept and the device works again once the fault is gone\n\n
+
+ See main library header file for details
+*/
+#include "BME280.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+
+static void checkCalibration(const BME280_Calibration &actual) {
+  /*!
+   * @brief     checks that the calibration values are those of the simulated device at power-on
+   * @param[in] actual Calibration values of the library
+   */
+  CHECK_EQUAL(BME280_SIM_CALIBRATION.dig_T1, actual.dig_T1);
+  CHECK_EQUAL(BME280_SIM_CALIBRATION.dig_P1, actual.dig_P1);
+  CHECK_EQUAL(BME280_SIM_CALIBRATION.dig_P9, actual.dig_P9);
+  CHECK_EQUAL(BME280_SIM_CALIBRATION.dig_H4, actual.dig_H4);
+  CHECK_EQUAL(BME280_SIM_CALIBRATION.dig_H6, actual.dig_H6);
+}  // of function checkCalibration()
+static void start(BME280_Class &sensor) {
+  /*!
+   * @brief     powers on the simulated device and starts it with weather monitoring settings
+   * @param[in] sensor Device to start
+   */
+  simulatorPowerOn();
+  CHECK(sensor.begin());
+  CHECK(sensor.apply(BME280_WEATHER_MONITORING));
+}  // of function start()
+
+int main() {
+  BME280_Class sensor;
+  int32_t      temperature, humidity, pressure;
+
+  // A single missing acknowledge, the measurement is repeated after a recovery
+  start(sensor);
+  simulator[0].nak = 1;
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(BusError, sensor.lastError());
+  CHECK_EQUAL(2508, temperature);
+  CHECK_EQUAL(Oversample1, sensor.getOversampling(TemperatureSensor, true));
+
+  // The measurement read is cut short
+  start(sensor);
+  simulator[0].shortRead = 5;
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(ShortReadError, sensor.lastError());
+  CHECK_EQUAL(2508, temperature);
+
+  // The calibration read is cut short during begin() and reset()
+  simulatorPowerOn();
+  simulator[0].shortRead = 10;
+  CHECK(!sensor.begin());
+  CHECK_EQUAL(ShortReadError, sensor.lastError());
+  start(sensor);
+  simulator[0].shortRead = 10;
+  CHECK(!sensor.reset());
+  CHECK_EQUAL(ShortReadError, sensor.lastError());
+  checkCalibration(sensor.calibration());
+  CHECK(sensor.reset());
+  CHECK_EQUAL(NoError, sensor.lastError());
+
+  // The measuring bit never clears, the previous readings are kept until the device recovers
+  start(sensor);
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  simulator[0].stuckBusy = true;
+  CHECK(!sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(TimeoutError, sensor.lastError());
+  CHECK_EQUAL(2508, temperature);
+  simulator[0].stuckBusy = false;
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(2508, temperature);
+
+  // The calibration registers differ after a reset, the values read by begin() are kept
+  start(sensor);
+  simulator[0].registers[BME280_T1_REG] ^= 0x40;
+  simulator[0].registers[BME280_H2_REG + 4] ^= 0x01;
+  CHECK(!sensor.recover());
+  CHECK_EQUAL(CalibrationError, sensor.lastError());
+  checkCalibration(sensor.calibration());
+  CHECK(!sensor.checkHealth());
+  CHECK_EQUAL(CalibrationError, sensor.lastError());
+  CHECK(!sensor.reset());
+  CHECK_EQUAL(CalibrationError, sensor.lastError());
+  checkCalibration(sensor.calibration());
+  simulator[0].registers[BME280_T1_REG] ^= 0x40;  // Back to the values read by begin()
+  simulator[0].registers[BME280_H2_REG + 4] ^= 0x01;
+  CHECK(sensor.reset());
+  CHECK(sensor.apply(BME280_WEATHER_MONITORING));  // reset() leaves the power-on settings
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(2508, temperature);
+
+  // The device is reset during a non-blocking measurement
+  start(sensor);
+  CHECK(sensor.startMeasurement());
+  delayMicroseconds(1000);
+  simulator[0].reset();
+  temperature = 0;
+  uint32_t start = simulatedTime;
+  while (!sensor.isReady() && simulatedTime - start < 100000) delayMicroseconds(100);
+  CHECK(!sensor.fetchResult(temperature, humidity, pressure));
+  CHECK_EQUAL(0, temperature);
+  CHECK_EQUAL(Oversample1, simulator[0].registers[BME280_CONTROL_REG] >> 5);  // Settings restored
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(2508, temperature);
+
+  // The device is reset during a normal mode conversion, the reading is repeated
+  simulatorPowerOn();
+  CHECK(sensor.begin());
+  CHECK(sensor.apply(BME280_INDOOR_NAVIGATION));
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  delayMicroseconds(simulator[0].conversionTime() / 2);
+  simulator[0].reset();
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(2508, temperature);
+  CHECK_EQUAL(NormalMode, simulator[0].registers[BME280_CONTROL_REG] & 3);
+  return (testResult("faults"));
+}  // of function main()
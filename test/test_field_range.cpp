@@ -0,0 +1,17 @@
+/*!
+ @file test_field_range.cpp
+
+ @section test_field_range_intro_section Description
+
+ A program which sets a register field to a value outside of its range with the compile-time
+ checked set<Field, Value>(). It must not compile\n\n
+
+ See main library header file for details
+*/
+#include "BME280.h"
+
+int main() {
+  BME280_Class sensor;
+  sensor.set<BME280_InactiveTimeField, UnknownInactive>();  // One past the last inactive time
+  return (0);
+}  // of function main()
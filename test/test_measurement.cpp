@@ -0,0 +1,144 @@
+/*!
+ @file test_measurement.cpp
+
+ @section test_measurement_intro_section Description
+
+ Host test of the measurement methods: the non-blocking startMeasurement(), isReady() and
+ fetchResult() don't touch the bus before the typical conversion time, poll the status register
+ once per call after it and read the result in a single burst, as does getSensorData(). Reading
+ selected channels reads the shortest burst covering them and skips channels switched off. Over
+ hardware SPI the measurement and each calibration block are read with one buffer transfer\n\n
+
+ See main library header file for details
+*/
+#include "BME280.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+
+static void checkChannels(BME280_Device<BME280_I2CBus> &sensor, const uint8_t channels,
+                          const uint8_t start, const uint8_t length) {
+  /*!
+   * @brief     reads selected channels and checks the burst and the readings against a full read
+   * @param[in] sensor Device in forced mode with all channels measured
+   * @param[in] channels Channels to read
+   * @param[in] start First register the burst has to read
+   * @param[in] length Number of registers the burst has to read
+   */
+  int32_t full[3], part[3] = {-1, -1, -1};  // Temperature, humidity and pressure
+  CHECK(sensor.getSensorData(full[0], full[1], full[2]));
+  CHECK_EQUAL(channels, sensor.getSensorData(channels, part[0], part[1], part[2]));
+  CHECK_EQUAL(start, simulator[0].readStart);
+  CHECK_EQUAL(length, simulator[0].readLength);
+  for (uint8_t sensorType = 0; sensorType < UnknownSensor; sensorType++)
+    CHECK_EQUAL((channels & (1 << sensorType)) ? full[sensorType] : -1, part[sensorType]);
+}  // of function checkChannels()
+
+int main() {
+  simulatorPowerOn();
+  BME280_Device<BME280_I2CBus> sensor;
+  int32_t                      temperature = 0, humidity = 0, pressure = 0;
+  BME280_Simulator            &device      = simulator[0];
+  CHECK(sensor.begin(I2C_STANDARD_MODE, 0x77));
+  CHECK(sensor.apply(BME280_WEATHER_MONITORING));  // Forced mode
+
+  // A forced conversion is one ctrl_meas write, no reads until the typical conversion time
+  device.reads = device.writes = device.statusReads = 0;
+  CHECK(sensor.startMeasurement());
+  CHECK_EQUAL(1, device.writes);
+  CHECK(!sensor.startMeasurement());  // Still pending
+  CHECK(!sensor.isReady());
+  CHECK(!sensor.fetchResult(temperature, humidity, pressure));
+  CHECK_EQUAL(0, device.reads);
+  CHECK_EQUAL(1, device.writes);
+  delayMicroseconds(sensor.conversionTime(TypicalMeasure));
+  uint32_t polls = 0;
+  while (!sensor.isReady()) polls++;
+  CHECK(polls > 0);  // The maximum conversion time is longer than the typical one
+  CHECK_EQUAL(polls + 1, device.statusReads);
+  CHECK_EQUAL(polls + 1, device.reads);
+  CHECK(sensor.fetchResult(temperature, humidity, pressure));
+  CHECK_EQUAL(polls + 2, device.reads);  // The 8 measurement bytes in one burst
+  CHECK_EQUAL(2508, temperature);
+  CHECK_EQUAL(1, device.conversions);
+
+  // The blocking read is the same sequence in one call
+  device.reads = device.writes = device.statusReads = 0;
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(1, device.writes);
+  CHECK_EQUAL(device.statusReads + 1, device.reads);
+  CHECK_EQUAL(2508, temperature);
+  CHECK_EQUAL(2, device.conversions);
+
+  // In normal mode the device converts continuously, nothing is written
+  CHECK_EQUAL(NormalMode, sensor.mode(NormalMode));
+  delay(sensor.measurementTime() / 1000 + 1);
+  device.reads = device.writes = 0;
+  CHECK(sensor.startMeasurement());
+  CHECK_EQUAL(0, device.writes);
+  delayMicroseconds(sensor.conversionTime());
+  CHECK(sensor.fetchResult(temperature, humidity, pressure));
+  CHECK_EQUAL(2508, temperature);
+  CHECK_EQUAL(0, device.writes);
+
+  // A conversion which doesn't complete fails after the maximum conversion time
+  CHECK_EQUAL(SleepMode, sensor.mode(SleepMode));
+  CHECK(sensor.apply(BME280_WEATHER_MONITORING));
+  device.stuckBusy = true;
+  CHECK(sensor.startMeasurement());
+  uint32_t start = simulatedTime;
+  while (!sensor.isReady()) delayMicroseconds(100);
+  CHECK(simulatedTime - start >= sensor.conversionTime(MaximumMeasure));
+  CHECK(!sensor.fetchResult(temperature, humidity, pressure));
+  CHECK_EQUAL(TimeoutError, sensor.lastError());
+  device.stuckBusy = false;
+  temperature      = 0;
+  CHECK(sensor.startMeasurement());
+  while (!sensor.fetchResult(temperature, humidity, pressure)) delayMicroseconds(100);
+  CHECK_EQUAL(2508, temperature);
+
+  // Selected channels are read in the shortest burst covering them, temperature is always read
+  checkChannels(sensor, TemperatureChannel, BME280_TEMPDATA_REG, 3);
+  checkChannels(sensor, TemperatureChannel | HumidityChannel, BME280_TEMPDATA_REG, 5);
+  checkChannels(sensor, TemperatureChannel | PressureChannel, BME280_PRESSUREDATA_REG, 6);
+  checkChannels(sensor, AllChannels, BME280_PRESSUREDATA_REG, 8);
+
+  // Channels switched off are neither read nor converted, their values are left unchanged
+  CHECK(sensor.setOversampling(HumiditySensor, SensorOff));
+  temperature = humidity = pressure = -1;
+  CHECK_EQUAL(TemperatureChannel | PressureChannel,
+              sensor.getSensorData(AllChannels, temperature, humidity, pressure));
+  CHECK_EQUAL(BME280_PRESSUREDATA_REG, device.readStart);
+  CHECK_EQUAL(6, device.readLength);
+  CHECK_EQUAL(2508, temperature);
+  CHECK_EQUAL(-1, humidity);
+  CHECK(sensor.setOversampling(PressureSensor, SensorOff));
+  temperature = pressure = -1;
+  CHECK_EQUAL(TemperatureChannel,
+              sensor.getSensorData(PressureChannel | TemperatureChannel, temperature, humidity,
+                                   pressure));
+  CHECK_EQUAL(BME280_TEMPDATA_REG, device.readStart);
+  CHECK_EQUAL(3, device.readLength);
+  CHECK_EQUAL(2508, temperature);
+  CHECK_EQUAL(-1, pressure);
+  device.reads = 0;
+  CHECK_EQUAL(0, sensor.getSensorData(HumidityChannel | PressureChannel, temperature, humidity,
+                                      pressure));
+  CHECK_EQUAL(0, device.reads);  // Nothing to read
+  CHECK_EQUAL(-1, humidity);
+  CHECK_EQUAL(-1, pressure);
+
+  // Hardware SPI sends the register address byte by byte and reads each burst in one call
+  BME280_Device<BME280_HardwareSPIBus> spiSensor;
+  CHECK(spiSensor.begin(device.chipSelect));
+  CHECK(spiSensor.apply(BME280_WEATHER_MONITORING));
+  spiByteCalls = spiBufferCalls = device.statusReads = device.writes = 0;
+  CHECK(spiSensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(2508, temperature);
+  CHECK_EQUAL(1, spiBufferCalls);  // The 8 measurement bytes
+  CHECK_EQUAL(2 * device.writes + 2 * device.statusReads + 1, spiByteCalls);  // And the address
+  spiByteCalls = spiBufferCalls = 0;
+  CHECK(spiSensor.checkHealth());
+  CHECK_EQUAL(3, spiBufferCalls);    // Both calibration blocks and the control registers
+  CHECK_EQUAL(2 + 3, spiByteCalls);  // Chip id and the addresses of the bursts
+  return (testResult("measurement"));
+}  // of function main()
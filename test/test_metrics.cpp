@@ -0,0 +1,167 @@
+/*!
+ @file test_metrics.cpp
+
+ @section test_metrics_intro_section Description
+
+ Host test of the integer derived values of BME280_Metrics.h: each function is compared with the
+ floating point formula across the input range given in BME280_Metrics.h, and the largest
+ difference must not exceed the figure stated there. The largest differences found are shown\n\n
+
+ See main library header file for details
+*/
+#include <math.h>   // Floating point formulas
+#include <stdio.h>  // printf()
+
+#include "BME280_Metrics.h"
+#include "BME280_Test.h"
+
+static double altitudeOf(const double pressure, const double seaLevel) {
+  /*!
+   * @brief     returns the altitude of the international barometric formula
+   * @param[in] pressure Pressure in Pascals
+   * @param[in] seaLevel Sea-level pressure in Pascals
+   * @return    altitude in centimeters
+   */
+  return (4433000.0 * (1.0 - pow(pressure / seaLevel, 0.190295)));
+}  // of function altitudeOf()
+static double seaLevelOf(const double pressure, const double altitude) {
+  /*!
+   * @brief     returns the sea-level pressure of the international barometric formula
+   * @param[in] pressure Pressure in Pascals
+   * @param[in] altitude Altitude in centimeters
+   * @return    sea-level pressure in Pascals
+   */
+  return (pressure / pow(1.0 - altitude / 4433000.0, 1.0 / 0.190295));
+}  // of function seaLevelOf()
+static double magnusOf(const double temperature) {
+  /*!
+   * @brief     returns the exponent of the Magnus formula
+   * @param[in] temperature Temperature in degrees
+   * @return    b * T / (c + T)
+   */
+  return (17.62 * temperature / (243.12 + temperature));
+}  // of function magnusOf()
+static double dewPointOf(const double temperature, const double humidity) {
+  /*!
+   * @brief     returns the dew point of the Magnus formula
+   * @param[in] temperature Temperature in degrees
+   * @param[in] humidity Relative humidity in percent
+   * @return    dew point in centi-degrees
+   */
+  double gamma = log(humidity / 100.0) + magnusOf(temperature);
+  return (100.0 * 243.12 * gamma / (17.62 - gamma));
+}  // of function dewPointOf()
+static double absoluteHumidityOf(const double temperature, const double humidity) {
+  /*!
+   * @brief     returns the absolute humidity from the Magnus saturation vapour pressure
+   * @param[in] temperature Temperature in degrees
+   * @param[in] humidity Relative humidity in percent
+   * @return    absolute humidity in mg/m^3
+   */
+  double vapour = 611.2 * exp(magnusOf(temperature)) * humidity / 100.0;  // Pascals
+  return (vapour / (461.5 * (temperature + 273.15)) * 1e6);
+}  // of function absoluteHumidityOf()
+static double heatIndexOf(const double temperature, const double humidity) {
+  /*!
+   * @brief     returns the heat index of the US National Weather Service
+   * @param[in] temperature Temperature in degrees
+   * @param[in] humidity Relative humidity in percent
+   * @return    heat index in centi-degrees
+   */
+  double t = temperature * 1.8 + 32.0, r = humidity;
+  double index = 0.5 * (t + 61.0 + (t - 68.0) * 1.2 + r * 0.094);
+  if ((index + t) / 2.0 >= 80.0) {
+    index = -42.379 + 2.04901523 * t + 10.14333127 * r - 0.22475541 * t * r -
+            0.00683783 * t * t - 0.05481717 * r * r + 0.00122874 * t * t * r +
+            0.00085282 * t * r * r - 0.00000199 * t * t * r * r;
+    if (r < 13.0 && t >= 80.0 && t <= 112.0)
+      index -= (13.0 - r) / 4.0 * sqrt((17.0 - fabs(t - 95.0)) / 17.0);
+    if (r > 85.0 && t >= 80.0 && t <= 87.0) index += (r - 85.0) / 10.0 * (87.0 - t) / 5.0;
+  }  // of if-then use the regression
+  return ((index - 32.0) * 100.0 / 1.8);
+}  // of function heatIndexOf()
+static bool nearSwitch(const int32_t temperature, const int32_t humidity) {
+  /*!
+   * @brief     returns whether rounding can put the two heat index formulas on different sides of
+   * the 80F switch-over to the regression
+   * @param[in] temperature Temperature in centi-degrees
+   * @param[in] humidity Relative humidity in centi-percent
+   * @return    returns "true" within 0.001F of the switch-over
+   */
+  double t = temperature * 0.018 + 32.0, r = humidity / 100.0;
+  double simple = 0.5 * (t + 61.0 + (t - 68.0) * 1.2 + r * 0.094);
+  return (fabs((simple + t) / 2.0 - 80.0) < 0.001);
+}  // of function nearSwitch()
+
+int main() {
+  double worst;  // Largest difference found
+
+  // Altitude for pressure ratios of 0.25 to 1.25, for three sea-level pressures. The parabolas
+  // are least accurate for ratios below 0.26, i.e. above 10400m
+  double        high         = 0;  // Largest difference for ratios below 0.26
+  const int32_t SEA_LEVELS[] = {95000, BME280_SEA_LEVEL_PRESSURE, 105000};
+  worst                      = 0;
+  for (uint8_t s = 0; s < 3; s++) {
+    int32_t seaLevel = SEA_LEVELS[s];
+    for (int32_t pressure = seaLevel / 4 + 1; pressure < seaLevel * 5 / 4; pressure += 3) {
+      double error =
+          fabs(BME280_Metrics::altitude(pressure, seaLevel) - altitudeOf(pressure, seaLevel));
+      if (pressure < seaLevel * 26 / 100) {
+        if (error > high) high = error;
+      } else if (error > worst) {
+        worst = error;
+      }  // of if-then-else ratio below 0.26
+    }    // of for-next each pressure
+  }      // of for-next each sea-level pressure
+  printf("altitude()         %7.3f cm, %7.3f cm below a ratio of 0.26\n", worst, high);
+  CHECK(worst <= 2.0);
+  CHECK(high <= 3.0);
+
+  // Sea-level pressure from -1900m to 10000m for pressures around the standard atmosphere
+  worst = 0;
+  for (int32_t altitude = -190000; altitude <= 1000000; altitude += 1000)
+    for (int32_t offset = -5000; offset <= 5000; offset += 2500) {
+      int32_t pressure =
+          (int32_t)(101325.0 * pow(1.0 - altitude / 4433000.0, 1.0 / 0.190295)) + offset;
+      double error = fabs(BME280_Metrics::seaLevelPressure(pressure, altitude) -
+                          seaLevelOf(pressure, altitude));
+      if (error > worst) worst = error;
+    }  // of for-next each pressure
+  printf("seaLevelPressure() %7.3f Pa\n", worst);
+  CHECK(worst <= 2.0);
+
+  // Dew point for 1% to 100% humidity across the operating temperatures
+  worst = 0;
+  for (int32_t temperature = -4000; temperature <= 8500; temperature += 25)
+    for (int32_t humidity = 100; humidity <= 10000; humidity += 7) {
+      double error = fabs(BME280_Metrics::dewPoint(temperature, humidity) -
+                          dewPointOf(temperature / 100.0, humidity / 100.0));
+      if (error > worst) worst = error;
+    }  // of for-next each humidity
+  printf("dewPoint()         %7.3f centi-degrees\n", worst);
+  CHECK(worst <= 1.0);
+
+  // Absolute humidity, relative to the value plus 1mg/m^3
+  worst = 0;
+  for (int32_t temperature = -4000; temperature <= 8500; temperature += 25)
+    for (int32_t humidity = 0; humidity <= 10000; humidity += 7) {
+      double exact = absoluteHumidityOf(temperature / 100.0, humidity / 100.0);
+      double error = fabs(BME280_Metrics::absoluteHumidity(temperature, humidity) - exact) - 1.0;
+      if (error > 0 && error / exact > worst) worst = error / exact;
+    }  // of for-next each humidity
+  printf("absoluteHumidity() %7.4f %% + 1 mg/m^3\n", worst * 100.0);
+  CHECK(worst <= 0.0002);
+
+  // Heat index up to 60 degrees, except next to the switch-over of the formulas
+  worst = 0;
+  for (int32_t temperature = -4000; temperature <= 8500; temperature += 5)
+    for (int32_t humidity = 0; humidity <= 10000; humidity += 11) {
+      double exact = heatIndexOf(temperature / 100.0, humidity / 100.0);
+      if (exact > 6000.0 || nearSwitch(temperature, humidity)) continue;
+      double error = fabs(BME280_Metrics::heatIndex(temperature, humidity) - exact);
+      if (error > worst) worst = error;
+    }  // of for-next each humidity
+  printf("heatIndex()        %7.3f centi-degrees\n", worst);
+  CHECK(worst <= 1.0);
+  return (testResult("metrics"));
+}  // of function main()
@@ -0,0 +1,20 @@
+/*!
+ @file test_mismatch.cpp
+
+ @section test_mismatch_intro_section Description
+
+ A program which selects another compensation engine than the library was built with, the way a
+ sketch would with a "#define" before the include. It must not link, see BME280_Options.h\n\n
+
+ See main library header file for details
+*/
+#define BME280_COMPENSATION 1  // BME280_COMPENSATION_INT32, the library uses the 64-bit engine
+#include "BME280_Core.h"
+
+int main() {
+  BME280_Core      core;
+  BME280_RawSample raw = {};
+  BME280_Reading   out;
+  core.compensate(&raw, &out, 1);
+  return (0);
+}  // of function main()
@@ -0,0 +1,82 @@
+/*!
+ @file test_raw.cpp
+
+ @section test_raw_intro_section Description
+
+ Host test of the raw-sample capture: raw readings captured with getRawData() and
+ fetchRawResult() and compensated later in one batch, on the same device or on another core with
+ the same calibration values, give the readings getSensorData() returns\n\n
+
+ See main library header file for details
+*/
+#include "BME280.h"
+#include "BME280_Reference.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+
+const uint8_t SAMPLES = 16;  ///< Samples captured
+
+static uint32_t sampleT(const uint32_t number) { return (BME280_SIM_ADC_T + number * 3001); }
+static uint32_t sampleP(const uint32_t number) { return (BME280_SIM_ADC_P - number * 1999); }
+static uint16_t sampleH(const uint32_t number) { return (BME280_SIM_ADC_H + number * 499); }
+static void     nextSample(BME280_Simulator &device, const uint32_t number) {
+  /*!
+   * @brief     gives every conversion different readings
+   * @param[in] device Simulated device
+   * @param[in] number Conversion number, from 0
+   */
+  device.measure(sampleT(number), sampleP(number), sampleH(number));
+}  // of function nextSample()
+
+int main() {
+  simulatorPowerOn();
+  simulator[0].conversion = nextSample;
+  BME280_Device<BME280_HardwareSPIBus> sensor;
+  BME280_RawSample                     raw[SAMPLES];
+  BME280_Reading                       batch[SAMPLES];
+  CHECK(sensor.begin(simulator[0].chipSelect));
+  CHECK(sensor.apply(BME280_WEATHER_MONITORING));
+
+  // Captured with both the blocking and the non-blocking methods
+  for (uint8_t i = 0; i < SAMPLES / 2; i++) CHECK(sensor.getRawData(raw[i]));
+  for (uint8_t i = SAMPLES / 2; i < SAMPLES; i++) {
+    CHECK(sensor.startMeasurement());
+    while (!sensor.fetchRawResult(raw[i])) delayMicroseconds(100);
+  }  // of for-next each non-blocking sample
+  CHECK_EQUAL(sampleP(0) >> 12, raw[0].data[0]);  // Registers 0xF7 to 0xFE as read
+  CHECK_EQUAL(sampleH(3) & 0xFF, raw[3].data[7]);
+
+  // One batch, the same readings as a reference conversion of each sample
+  sensor.compensate(raw, batch, SAMPLES);
+  for (uint8_t i = 0; i < SAMPLES; i++) {
+    BME280_Reading expected = reference(BME280_SIM_CALIBRATION, sampleT(i), sampleP(i), sampleH(i));
+    CHECK_EQUAL(expected.temperature, batch[i].temperature);
+    CHECK_EQUAL(expected.humidity, batch[i].humidity);
+    CHECK_EQUAL(expected.pressure, batch[i].pressure);
+  }  // of for-next each sample
+  int32_t temperature, humidity, pressure;
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  BME280_Reading next = reference(BME280_SIM_CALIBRATION, sampleT(SAMPLES), sampleP(SAMPLES),
+                                  sampleH(SAMPLES));
+  CHECK_EQUAL(next.temperature, temperature);
+  CHECK_EQUAL(next.pressure, pressure);
+
+  // Compensated elsewhere with the calibration values of the device
+  BME280_Core    host;
+  BME280_Reading remote[SAMPLES];
+  host.calibration(sensor.calibration());
+  host.compensate(raw, remote, SAMPLES);
+  for (uint8_t i = 0; i < SAMPLES; i++) {
+    CHECK_EQUAL(batch[i].temperature, remote[i].temperature);
+    CHECK_EQUAL(batch[i].humidity, remote[i].humidity);
+    CHECK_EQUAL(batch[i].pressure, remote[i].pressure);
+  }  // of for-next each sample
+
+  // Channels which aren't converted keep their values
+  BME280_Reading partial = {0, -1, -1};
+  host.compensate(raw, &partial, 1, TemperatureChannel | PressureChannel);
+  CHECK_EQUAL(batch[0].temperature, partial.temperature);
+  CHECK_EQUAL(-1, partial.humidity);
+  CHECK_EQUAL(batch[0].pressure, partial.pressure);
+  return (testResult("raw"));
+}  // of function main()
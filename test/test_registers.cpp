@@ -0,0 +1,75 @@
+/*!
+ @file test_registers.cpp
+
+ @section test_registers_intro_section Description
+
+ Host test of the register burst methods readRegisters() and writeRegisters() and the getData()
+ and putData() templates built on them: two devices on the same bus keep their own state, and a
+ read cut short by the bus is reported on that call only, without changing the size of later reads
+ of the same or another device\n\n
+
+ See main library header file for details
+*/
+#include "BME280.h"
+#include "BME280_Reference.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+
+int main() {
+  simulatorPowerOn(2);
+  BME280_Calibration warmer = BME280_SIM_CALIBRATION;
+  warmer.dig_T1 -= 400;  // Device 1 reads about 2 degrees more
+  simulator[1].calibrate(warmer);
+  BME280_Device<BME280_I2CBus> first, second;
+  int32_t                      temperature, humidity, pressure;
+  CHECK(first.begin(I2C_STANDARD_MODE, 0x77));
+  CHECK(second.begin(I2C_STANDARD_MODE, 0x76));
+
+  // Each instance works with its own device and calibration
+  CHECK(first.apply(BME280_WEATHER_MONITORING));
+  CHECK(second.apply(BME280_INDOOR_NAVIGATION));
+  CHECK_EQUAL(BME280_WEATHER_MONITORING.iirFilter, first.iirFilter());
+  CHECK_EQUAL(BME280_INDOOR_NAVIGATION.iirFilter, second.iirFilter());
+  CHECK(first.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(2508, temperature);
+  CHECK(second.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(reference(warmer, BME280_SIM_ADC_T, BME280_SIM_ADC_P, BME280_SIM_ADC_H).temperature,
+              temperature);
+
+  // Bursts of any length, returning the bytes transferred
+  uint8_t block[4] = {0x01, 0, 0x6C, 0};  // ctrl_hum, ctrl_meas and config values
+  uint8_t readBack[4];
+  CHECK_EQUAL(1, second.writeRegisters(BME280_CONTROLHUMID_REG, block, 1));
+  CHECK_EQUAL(1, second.writeRegisters(BME280_CONFIG_REG, block + 2, 1));
+  CHECK_EQUAL(4, second.readRegisters(BME280_CONTROLHUMID_REG, readBack, sizeof(readBack)));
+  CHECK_EQUAL(0x01, readBack[0]);
+  CHECK_EQUAL(0x6C, readBack[BME280_CONFIG_REG - BME280_CONTROLHUMID_REG]);
+  second.syncFromDevice();
+  CHECK_EQUAL(IIR8, second.iirFilter());
+  CHECK_EQUAL(inactive250ms, second.inactiveTime());
+  CHECK_EQUAL(NoError, second.lastError());
+
+  // A truncated read fails on that call only and keeps the register copies
+  simulator[1].writeRegister(BME280_CONFIG_REG, 0x10);  // IIR16, not yet seen by the library
+  simulator[1].shortRead = 2;
+  second.syncFromDevice();
+  CHECK_EQUAL(ShortReadError, second.lastError());
+  CHECK_EQUAL(IIR8, second.iirFilter());
+  simulator[0].writeRegister(BME280_CONFIG_REG, 0x10);
+  first.syncFromDevice();  // Same template instance, the full 4 bytes are read
+  CHECK_EQUAL(NoError, first.lastError());
+  CHECK_EQUAL(IIR16, first.iirFilter());
+  second.syncFromDevice();  // The next read of the same device is complete again
+  CHECK_EQUAL(NoError, second.lastError());
+  CHECK_EQUAL(IIR16, second.iirFilter());
+  simulator[1].shortRead = 3;
+  CHECK_EQUAL(3, second.readRegisters(BME280_CONTROLHUMID_REG, readBack, sizeof(readBack)));
+  CHECK_EQUAL(ShortReadError, second.lastError());
+  simulator[1].nak = 1;
+  CHECK_EQUAL(0, second.readRegisters(BME280_CONTROLHUMID_REG, readBack, sizeof(readBack)));
+  CHECK_EQUAL(BusError, second.lastError());
+  simulator[1].nak = 1;
+  CHECK_EQUAL(0, second.writeRegisters(BME280_CONFIG_REG, block + 2, 1));
+  CHECK_EQUAL(BusError, second.lastError());
+  return (testResult("registers"));
+}  // of function main()
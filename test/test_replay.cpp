@@ -0,0 +1,109 @@
+/*!
+ @file test_replay.cpp
+
+ @section test_replay_intro_section Description
+
+ Host test of recording and replaying the register traffic: a session with the simulated device
+ is recorded with BME280_TraceBus, then replayed with BME280_ReplayBus while the simulated device
+ is gone and the clock of the computer stands still. The replay gives the same readings and
+ stream timestamps without any mismatches, a changed library call sequence is reported\n\n
+
+ See main library header file for details
+*/
+#include "BME280.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+#include "BME280_Trace.h"
+
+const uint8_t  READINGS = 5;     ///< Forced readings in the recorded session
+const uint16_t SIZE     = 8192;  ///< Bytes of the trace buffer
+
+static uint8_t  trace[SIZE];           ///< Recorded trace
+static uint16_t traceLength = 0;       ///< Bytes in the trace
+static uint32_t timestamps[2][40];     ///< Stream timestamps while recording and replaying
+static uint8_t  samples[2]  = {0, 0};  ///< Stream samples while recording and replaying
+static uint8_t  replaying   = 0;       ///< 0 while recording, 1 while replaying
+
+static void warmer(BME280_Simulator &device, const uint32_t number) {
+  /*!
+   * @brief     raises the temperature with each conversion
+   * @param[in] device Simulated device
+   * @param[in] number Conversion number, from 0
+   */
+  device.measure(BME280_SIM_ADC_T + number * 800, BME280_SIM_ADC_P - number * 50,
+                 BME280_SIM_ADC_H + number * 40);
+}  // of function warmer()
+static void noteSample(const uint32_t timestamp, const BME280_Reading &reading) {
+  /*!
+   * @brief     stores the timestamp of a streamed sample
+   * @param[in] timestamp millis() value of the sample
+   * @param[in] reading Compensated readings
+   */
+  (void)reading;
+  if (samples[replaying] < 40) timestamps[replaying][samples[replaying]++] = timestamp;
+}  // of function noteSample()
+template <class Device>
+static void session(Device &sensor, BME280_Reading (&readings)[READINGS + 1]) {
+  /*!
+   * @brief      runs the recorded session: forced readings, then streaming in normal mode
+   * @param[in]  sensor Device which has been started
+   * @param[out] readings Forced readings and the last streamed one
+   */
+  CHECK(sensor.apply(BME280_WEATHER_MONITORING));
+  for (uint8_t i = 0; i < READINGS; i++)
+    CHECK(sensor.getSensorData(readings[i].temperature, readings[i].humidity,
+                               readings[i].pressure));
+  CHECK(sensor.apply(BME280_INDOOR_NAVIGATION));
+  sensor.startStreaming(noteSample);
+}  // of function session()
+
+int main() {
+  BME280_Reading recorded[READINGS + 1], replayed[READINGS + 1];
+
+  // Record a session with the simulated device
+  simulatorPowerOn();
+  simulator[0].conversion = warmer;
+  BME280_Device<BME280_TraceBus<BME280_I2CBus, SIZE>> recorder;
+  CHECK(recorder.begin(I2C_STANDARD_MODE, (uint8_t)0x77));
+  session(recorder, recorded);
+  uint32_t start = simulatedTime;
+  while (samples[0] < 10 && simulatedTime - start < 1000000) {
+    if (recorder.stream(recorded[READINGS])) CHECK(recorder.lastError() == NoError);
+    delayMicroseconds(100);
+  }  // of while-loop streaming
+  CHECK_EQUAL(10, samples[0]);
+  CHECK_EQUAL(0, recorder.bus().dropped());
+  traceLength = recorder.bus().copyTrace(trace, sizeof(trace));
+  CHECK_EQUAL(recorder.bus().traceLength() + 4, traceLength);
+  CHECK(recorded[0].temperature != recorded[READINGS - 1].temperature);
+
+  // Replay it without the device and with the clock of the computer stopped
+  simulator[0].present = false;
+  replaying            = 1;
+  uint32_t                        stopped = simulatedTime;
+  BME280_Device<BME280_ReplayBus> replay;
+  CHECK(replay.begin(trace, traceLength));
+  session(replay, replayed);
+  for (uint16_t i = 0; i < 10000 && !replay.bus().finished(); i++)
+    replay.stream(replayed[READINGS]);
+  CHECK(replay.bus().finished());
+  CHECK_EQUAL(0, replay.bus().mismatches());
+  CHECK_EQUAL(NoError, replay.lastError());
+  CHECK_EQUAL(stopped, simulatedTime);
+  for (uint8_t i = 0; i <= READINGS; i++) {
+    CHECK_EQUAL(recorded[i].temperature, replayed[i].temperature);
+    CHECK_EQUAL(recorded[i].humidity, replayed[i].humidity);
+    CHECK_EQUAL(recorded[i].pressure, replayed[i].pressure);
+  }  // of for-next each reading
+  CHECK_EQUAL(samples[0], samples[1]);
+  for (uint8_t i = 0; i < samples[0] && i < samples[1]; i++)
+    CHECK_EQUAL(timestamps[0][i], timestamps[1][i]);
+
+  // A library which makes other transfers than the recorded ones is noticed
+  BME280_Device<BME280_ReplayBus> changed;
+  CHECK(changed.begin(trace, traceLength));
+  CHECK(changed.apply(BME280_INDOOR_NAVIGATION));
+  CHECK(changed.bus().mismatches() > 0);
+  CHECK(!BME280_ReplayBus().begin(trace, 4));
+  return (testResult("replay"));
+}  // of function main()
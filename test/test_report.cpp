@@ -0,0 +1,199 @@
+/*!
+ @file test_report.cpp
+
+ @section test_report_intro_section Description
+
+ Host test of report(): all readings are reported the first time, identical raw readings are never
+ reported, a change is reported once it exceeds the deadband of its channel and a change in the
+ opposite direction also has to exceed the hysteresis, so noise swinging across a threshold by more
+ than the deadband is reported once. When the quiet interval has passed all readings are reported
+ again, changed or not. A recorded session with a slowly warming device is replayed once with
+ getSensorData() and once with report(), report() gives fewer events and compensates only the
+ changed raw readings. The test is built with BME280_STATISTICS to count the compensations\n\n
+
+ See main library header file for details
+*/
+#include "BME280.h"
+#include "BME280_Reference.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+#include "BME280_Trace.h"
+
+#ifndef BME280_STATISTICS
+#error "test_report has to be built with BME280_STATISTICS defined"
+#endif
+
+const uint8_t  READINGS = 60;     ///< Forced readings in the recorded session
+const uint8_t  REPEATS  = 3;      ///< Conversions giving the same raw readings
+const uint16_t SIZE     = 16384;  ///< Bytes of the trace buffer
+const uint16_t DEADBAND = 20;     ///< Temperature deadband of the replayed report() session
+
+static uint8_t  trace[SIZE];      ///< Recorded session
+static uint16_t traceLength = 0;  ///< Bytes in the trace
+
+static int32_t temperatureAt(const uint32_t adcT) {
+  /*!
+   * @brief     returns the temperature the simulated device gives for a raw temperature
+   * @param[in] adcT Raw temperature
+   * @return    Temperature in hundredths of a degree
+   */
+  return (reference(BME280_SIM_CALIBRATION, adcT, BME280_SIM_ADC_P, BME280_SIM_ADC_H).temperature);
+}  // of function temperatureAt()
+static uint32_t adcForTemperature(const int32_t temperature) {
+  /*!
+   * @brief     returns the lowest raw temperature giving at least the given temperature
+   * @param[in] temperature Temperature in hundredths of a degree
+   * @return    Raw temperature
+   */
+  uint32_t adcT = BME280_SIM_ADC_T;
+  while (temperatureAt(adcT) > temperature) adcT -= 16;
+  while (temperatureAt(adcT) < temperature) adcT++;
+  return (adcT);
+}  // of function adcForTemperature()
+static uint8_t reportTemperature(BME280_Class &sensor, const int32_t temperature,
+                                 BME280_Reading &reading) {
+  /*!
+   * @brief      sets the temperature of the next conversion and calls report()
+   * @param[in]  sensor Device in forced mode
+   * @param[in]  temperature Temperature to measure in hundredths of a degree
+   * @param[out] reading Readings returned by report()
+   * @return     Channels reported
+   */
+  simulator[0].measure(adcForTemperature(temperature), BME280_SIM_ADC_P, BME280_SIM_ADC_H);
+  return (sensor.report(reading));
+}  // of function reportTemperature()
+static void warming(BME280_Simulator &device, const uint32_t number) {
+  /*!
+   * @brief     raises the temperature a little every REPEATS conversions, in between the device
+   * gives the same raw readings
+   * @param[in] device Simulated device
+   * @param[in] number Conversion number, from 0
+   */
+  device.measure(BME280_SIM_ADC_T + number / REPEATS * 400, BME280_SIM_ADC_P, BME280_SIM_ADC_H);
+}  // of function warming()
+static uint16_t record() {
+  /*!
+   * @brief     records a session of forced readings of a slowly warming device
+   * @return    Bytes in the trace
+   */
+  simulatorPowerOn();
+  simulator[0].conversion = warming;
+  BME280_Device<BME280_TraceBus<BME280_I2CBus, SIZE>> recorder;
+  BME280_Reading                                      reading;
+  CHECK(recorder.begin(I2C_STANDARD_MODE, (uint8_t)0x77));
+  CHECK(recorder.apply(BME280_WEATHER_MONITORING));
+  for (uint8_t i = 0; i < READINGS; i++)
+    CHECK(recorder.getSensorData(reading.temperature, reading.humidity, reading.pressure));
+  CHECK_EQUAL(0, recorder.bus().dropped());
+  simulator[0].present = false;  // The replays must not reach the device
+  return (recorder.bus().copyTrace(trace, sizeof(trace)));
+}  // of function record()
+
+int main() {
+  simulatorPowerOn();
+  BME280_Class   sensor;
+  BME280_Reading reading = {};
+  CHECK(sensor.begin());
+  CHECK(sensor.apply(BME280_WEATHER_MONITORING));
+
+  // Everything is reported the first time, identical raw readings are not reported again
+  CHECK_EQUAL(AllChannels, sensor.report(reading));
+  CHECK_EQUAL(2508, reading.temperature);
+  reading.temperature = 0;
+  CHECK_EQUAL(0, sensor.report(reading));
+  CHECK_EQUAL(0, reading.temperature);  // Unchanged when nothing is reported
+
+  // Without thresholds every change is reported, only on the channels which changed
+  simulator[0].measure(BME280_SIM_ADC_T, BME280_SIM_ADC_P + 100, BME280_SIM_ADC_H);
+  CHECK_EQUAL(PressureChannel, sensor.report(reading));
+  simulator[0].measure(BME280_SIM_ADC_T, BME280_SIM_ADC_P + 100, BME280_SIM_ADC_H + 50);
+  CHECK_EQUAL(HumidityChannel, sensor.report(reading));
+
+  // Temperature deadband of 0.50 degrees and hysteresis of 0.30 degrees, humidity and pressure
+  // change with the temperature compensation and are ignored here
+  sensor.setThreshold(TemperatureSensor, 50, 30);
+  sensor.setThreshold(HumiditySensor, 65535);
+  sensor.setThreshold(PressureSensor, 65535);
+  int32_t base = temperatureAt(adcForTemperature(2508));
+  CHECK_EQUAL(0, reportTemperature(sensor, base, reading));       // Other raw value, same reading
+  CHECK_EQUAL(0, reportTemperature(sensor, base + 50, reading));  // Not more than the deadband
+  CHECK_EQUAL(TemperatureChannel, reportTemperature(sensor, base + 51, reading));
+  CHECK_EQUAL(base + 51, reading.temperature);
+  base = reading.temperature;
+  CHECK_EQUAL(TemperatureChannel, reportTemperature(sensor, base + 60, reading));  // Rising
+  base = reading.temperature;
+  CHECK_EQUAL(0, reportTemperature(sensor, base - 51, reading));  // Reversal needs 0.80 degrees
+  CHECK_EQUAL(0, reportTemperature(sensor, base - 80, reading));
+  CHECK_EQUAL(0, reportTemperature(sensor, base + 20, reading));  // Noise around the last value
+  CHECK_EQUAL(TemperatureChannel, reportTemperature(sensor, base - 81, reading));
+  base = reading.temperature;
+  CHECK_EQUAL(TemperatureChannel, reportTemperature(sensor, base - 51, reading));  // Same way
+  base = reading.temperature;
+  CHECK_EQUAL(0, reportTemperature(sensor, base + 79, reading));
+  CHECK_EQUAL(TemperatureChannel, reportTemperature(sensor, base + 90, reading));
+
+  // Noise swinging across the deadband by more than the deadband is reported once, the reversals
+  // don't exceed the hysteresis. Without the hysteresis every sample is reported
+  base          = reading.temperature;
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < 20; i++)
+    if (reportTemperature(sensor, base + ((i % 2) ? -10 : 60), reading)) count++;
+  CHECK_EQUAL(1, count);
+  CHECK_EQUAL(base + 60, reading.temperature);
+  sensor.setThreshold(TemperatureSensor, 50, 0);
+  count = 0;
+  for (uint8_t i = 0; i < 20; i++)
+    if (reportTemperature(sensor, base + ((i % 2) ? -10 : 60), reading)) count++;
+  CHECK_EQUAL(19, count);  // All but the first, which is the last reported value
+
+  // After the quiet interval everything is reported, also identical raw readings
+  sensor.setQuietInterval(1000);
+  delay(400);
+  CHECK_EQUAL(0, sensor.report(reading));
+  delay(700);
+  CHECK_EQUAL(AllChannels, sensor.report(reading));
+  CHECK_EQUAL(0, sensor.report(reading));  // The interval starts again
+  delay(1000);
+  CHECK_EQUAL(AllChannels, sensor.report(reading));
+  CHECK_EQUAL(NoError, sensor.lastError());
+
+  // Replay a recorded session with getSensorData(), every reading is an event and is compensated
+  traceLength = record();
+  BME280_Device<BME280_ReplayBus> polled;
+  int32_t                         temperatures[READINGS];
+  CHECK(polled.begin(trace, traceLength));
+  CHECK(polled.apply(BME280_WEATHER_MONITORING));
+  for (uint8_t i = 0; i < READINGS; i++)
+    CHECK(polled.getSensorData(temperatures[i], reading.humidity, reading.pressure));
+  CHECK(polled.bus().finished());
+  CHECK_EQUAL(0, polled.bus().mismatches());
+  CHECK_EQUAL(READINGS, polled.statistics().compensations);
+
+  // The same session with report(): only changed raw readings are compensated and only changes of
+  // more than the deadband are events
+  uint8_t expected = 1;  // Events, the first reading is always reported
+  for (uint8_t i = 1, last = 0; i < READINGS; i++)
+    if (temperatures[i] - temperatures[last] > DEADBAND) {
+      expected++;
+      last = i;
+    }  // of if-then change exceeds the deadband
+  BME280_Device<BME280_ReplayBus> reporter;
+  uint8_t                         events = 0;
+  CHECK(reporter.begin(trace, traceLength));
+  CHECK(reporter.apply(BME280_WEATHER_MONITORING));
+  reporter.setThreshold(TemperatureSensor, DEADBAND, DEADBAND);
+  reporter.setThreshold(HumiditySensor, 65535);  // Only change with the temperature compensation
+  reporter.setThreshold(PressureSensor, 65535);
+  for (uint8_t i = 0; i < READINGS; i++)
+    if (reporter.report(reading)) events++;
+  CHECK(reporter.bus().finished());
+  CHECK_EQUAL(0, reporter.bus().mismatches());
+  CHECK_EQUAL(NoError, reporter.lastError());
+  CHECK_EQUAL(READINGS, reporter.statistics().samples);
+  CHECK_EQUAL(READINGS / REPEATS, reporter.statistics().compensations);
+  CHECK_EQUAL(expected, events);
+  CHECK(events < READINGS / REPEATS);
+  printf("%u readings: %u events and %u compensations with report()\n", READINGS, events,
+         (unsigned)reporter.statistics().compensations);
+  return (testResult("report"));
+}  // of function main()
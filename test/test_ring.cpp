@@ -0,0 +1,61 @@
+/*!
+ @file test_ring.cpp
+
+ @section test_ring_intro_section Description
+
+ Host test of BME280_SampleRing: samples come out in order, a full buffer refuses new samples, the
+ running minimum, maximum and mean follow the last N samples and the memory used per sample is the
+ documented 18 bytes, or 12 bytes without the minimum and maximum\n\n
+
+ See main library header file for details
+*/
+#include "BME280_SampleRing.h"
+#include "BME280_Test.h"
+
+int main() {
+  BME280_SampleRing<8> ring;
+  uint32_t             timestamp;
+  int32_t              temperature, humidity, pressure;
+
+  // First in, first out, no more than N samples
+  CHECK(!ring.pop(timestamp, temperature, humidity, pressure));
+  for (int32_t i = 0; i < 8; i++) CHECK(ring.push(i, 2000 + i, 5000 - i, 100000 + i * 10));
+  CHECK(!ring.push(8, 0, 0, 0));
+  CHECK_EQUAL(8, ring.available());
+  CHECK(ring.pop(timestamp, temperature, humidity, pressure));
+  CHECK_EQUAL(0, timestamp);
+  CHECK_EQUAL(2000, temperature);
+  CHECK_EQUAL(5000, humidity);
+  CHECK_EQUAL(100000, pressure);
+  CHECK_EQUAL(7, ring.available());
+
+  // The summary covers the last 8 samples, including those already read
+  CHECK_EQUAL(2000, ring.minimum(TemperatureSensor));
+  CHECK_EQUAL(2007, ring.maximum(TemperatureSensor));
+  CHECK_EQUAL(4993, ring.minimum(HumiditySensor));
+  CHECK_EQUAL(100035, ring.mean(PressureSensor));
+  CHECK(ring.push(8, -4000, 0, 30000));  // The oldest sample leaves the window
+  CHECK_EQUAL(8, ring.windowSize());
+  CHECK_EQUAL(-4000, ring.minimum(TemperatureSensor));
+  CHECK_EQUAL(2007, ring.maximum(TemperatureSensor));
+  CHECK_EQUAL(100070, ring.maximum(PressureSensor));
+  CHECK_EQUAL(0, ring.minimum(HumiditySensor));
+  while (ring.pop(timestamp, temperature, humidity, pressure)) continue;
+  for (int32_t i = 0; i < 8; i++) CHECK(ring.push(9 + i, 2500, 4000, 90000));
+  CHECK_EQUAL(2500, ring.minimum(TemperatureSensor));
+  CHECK_EQUAL(2500, ring.maximum(TemperatureSensor));
+  CHECK_EQUAL(4000, ring.mean(HumiditySensor));
+
+  // Without the minimum and maximum queues only the mean is kept
+  BME280_SampleRing<8, false> small;
+  for (int32_t i = 0; i < 10; i++) small.push(i, i * 100, 0, 0);
+  CHECK_EQUAL(8, small.available());
+  CHECK_EQUAL(350, small.mean(TemperatureSensor));
+
+  // Memory per sample, the difference of two sizes removes the fixed part
+  CHECK_EQUAL(18 * 64, sizeof(BME280_SampleRing<128>) - sizeof(BME280_SampleRing<64>));
+  CHECK_EQUAL(24 * 256, sizeof(BME280_SampleRing<512>) - sizeof(BME280_SampleRing<256>));
+  CHECK_EQUAL(12 * 64,
+              sizeof(BME280_SampleRing<128, false>) - sizeof(BME280_SampleRing<64, false>));
+  return (testResult("ring"));
+}  // of function main()
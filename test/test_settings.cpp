@@ -0,0 +1,135 @@
+/*!
+ @file test_settings.cpp
+
+ @section test_settings_intro_section Description
+
+ Host test of the settings methods: every value written ends up in the device registers and is
+ returned by the getters, and a failed write is reported\n\n
+
+ See main library header file for details
+*/
+#include "BME280.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+
+int main() {
+  simulatorPowerOn();
+  BME280_Device<BME280_I2CBus> sensor;
+  CHECK(sensor.begin(I2C_STANDARD_MODE, 0x77));
+  uint8_t *registers = simulator[0].registers;
+
+  // Oversampling of each sensor, humidity only applies after the following ctrl_meas write
+  for (uint8_t sampling = SensorOff; sampling < UnknownOversample; sampling++) {
+    CHECK(sensor.setOversampling(TemperatureSensor, sampling));
+    CHECK(sensor.setOversampling(PressureSensor, sampling));
+    CHECK(sensor.setOversampling(HumiditySensor, sampling));
+    CHECK_EQUAL(sampling, sensor.getOversampling(TemperatureSensor));
+    CHECK_EQUAL(sampling, sensor.getOversampling(PressureSensor));
+    CHECK_EQUAL(sampling, sensor.getOversampling(HumiditySensor));
+    CHECK_EQUAL(sampling, registers[BME280_CONTROL_REG] >> 5);
+    CHECK_EQUAL(sampling, (registers[BME280_CONTROL_REG] >> 2) & 7);
+    CHECK_EQUAL(sampling, registers[BME280_CONTROLHUMID_REG] & 7);
+  }  // of for-next each oversampling
+  CHECK_EQUAL(16, sensor.getOversampling(HumiditySensor, true));
+  CHECK(!sensor.setOversampling(UnknownSensor, Oversample1));
+  CHECK(!sensor.setOversampling(HumiditySensor, UnknownOversample));
+
+  // Filter and inactive time keep each other
+  for (uint8_t iir = IIROff; iir < UnknownIIR; iir++) {
+    CHECK_EQUAL(iir, sensor.iirFilter(iir));
+    CHECK_EQUAL(iir, (registers[BME280_CONFIG_REG] >> 2) & 7);
+  }  // of for-next each filter
+  for (uint8_t inactive = inactiveHalf; inactive < UnknownInactive; inactive++) {
+    CHECK_EQUAL(inactive, sensor.inactiveTime(inactive));
+    CHECK_EQUAL(inactive, registers[BME280_CONFIG_REG] >> 5);
+  }  // of for-next each inactive time
+  CHECK_EQUAL(IIR16, sensor.iirFilter());
+
+  // Modes, a forced measurement returns to sleep mode
+  CHECK_EQUAL(NormalMode, sensor.mode(NormalMode));
+  CHECK_EQUAL(NormalMode, registers[BME280_CONTROL_REG] & 3);
+  CHECK_EQUAL(SleepMode, sensor.mode(SleepMode));
+  CHECK_EQUAL(SleepMode, registers[BME280_CONTROL_REG] & 3);
+
+  // A complete configuration and the timings derived from it
+  BME280_Config config = BME280_INDOOR_NAVIGATION;
+  CHECK(sensor.apply(config));
+  BME280_Config actual = sensor.getConfig();
+  CHECK_EQUAL(config.temperatureSampling, actual.temperatureSampling);
+  CHECK_EQUAL(config.pressureSampling, actual.pressureSampling);
+  CHECK_EQUAL(config.humiditySampling, actual.humiditySampling);
+  CHECK_EQUAL(config.iirFilter, actual.iirFilter);
+  CHECK_EQUAL(config.inactiveTime, actual.inactiveTime);
+  CHECK_EQUAL(config.mode, actual.mode);
+  CHECK_EQUAL(0x57, registers[BME280_CONTROL_REG]);  // x2, x16, normal mode
+  CHECK_EQUAL(0x10, registers[BME280_CONFIG_REG]);   // 0.5ms, filter 16
+  CHECK_EQUAL(0x01, registers[BME280_CONTROLHUMID_REG]);
+  CHECK_EQUAL(1000 + 2000 * 2 + 2000 * 16 + 500 + 2000 + 500,
+              sensor.conversionTime(TypicalMeasure));
+  CHECK_EQUAL(1250 + 2300 * 2 + 2300 * 16 + 575 + 2300 + 575, sensor.conversionTime());
+  CHECK_EQUAL(500 + sensor.conversionTime(), sensor.measurementTime());
+  config.iirFilter = UnknownIIR;
+  CHECK(!sensor.apply(config));
+  CHECK_EQUAL(0x10, registers[BME280_CONFIG_REG]);  // Nothing written
+
+  // The getters are served from the register copies and unchanged values aren't written again
+  simulator[0].reads = simulator[0].writes = 0;
+  CHECK_EQUAL(config.temperatureSampling, sensor.getOversampling(TemperatureSensor));
+  CHECK_EQUAL(IIR16, sensor.iirFilter());
+  CHECK_EQUAL(inactiveHalf, sensor.inactiveTime());
+  CHECK_EQUAL(NormalMode, sensor.mode());
+  CHECK_EQUAL(IIR16, sensor.iirFilter(IIR16));
+  CHECK(sensor.setOversampling(PressureSensor, config.pressureSampling));
+  CHECK_EQUAL(0, simulator[0].reads);
+  CHECK_EQUAL(0, simulator[0].writes);
+
+  // A failed write leaves the copies unchanged
+  simulator[0].nak = BME280_SIM_NAK_ALL;
+  CHECK(!sensor.setOversampling(HumiditySensor, Oversample4));
+  CHECK(!sensor.setOversampling(TemperatureSensor, Oversample4));
+  CHECK(!sensor.apply(BME280_WEATHER_MONITORING));
+  CHECK_EQUAL(IIR16, sensor.iirFilter(IIR2));
+  simulator[0].nak = 0;
+  actual           = sensor.getConfig();
+  CHECK_EQUAL(config.temperatureSampling, actual.temperatureSampling);
+  CHECK_EQUAL(config.humiditySampling, actual.humiditySampling);
+  CHECK_EQUAL(IIR16, actual.iirFilter);
+  CHECK_EQUAL(NormalMode, sensor.mode());
+  CHECK_EQUAL(0x57, registers[BME280_CONTROL_REG]);
+  CHECK_EQUAL(0x01, registers[BME280_CONTROLHUMID_REG]);
+  simulator[0].nak = 1;  // The sleep mode write fails
+  CHECK(!sensor.setOversampling(HumiditySensor, Oversample4));
+  CHECK_EQUAL(Oversample1, sensor.getOversampling(HumiditySensor));
+  CHECK(sensor.setOversampling(HumiditySensor, Oversample4));
+  CHECK_EQUAL(Oversample4, registers[BME280_CONTROLHUMID_REG]);
+
+  // Single fields, the result tells whether all writes succeeded
+  CHECK(sensor.set<BME280_IIRFilterField>(IIR4));
+  CHECK_EQUAL(IIR4, (registers[BME280_CONFIG_REG] >> 2) & 7);
+  CHECK((sensor.set<BME280_InactiveTimeField, inactive20ms>()));
+  CHECK_EQUAL(inactive20ms, registers[BME280_CONFIG_REG] >> 5);
+  CHECK_EQUAL(IIR4, sensor.get<BME280_IIRFilterField>());
+  CHECK(sensor.set<BME280_HumiditySamplingField>(Oversample2));
+  CHECK_EQUAL(Oversample2, registers[BME280_CONTROLHUMID_REG]);
+  CHECK((sensor.set<BME280_ModeField, SleepMode>()));
+  CHECK_EQUAL(SleepMode, registers[BME280_CONTROL_REG] & 3);
+  simulator[0].nak = BME280_SIM_NAK_ALL;
+  CHECK(!sensor.set<BME280_IIRFilterField>(IIR2));
+  CHECK(!(sensor.set<BME280_PressureSamplingField, Oversample8>()));
+  CHECK(!sensor.set<BME280_ModeField>(ForcedMode));
+  CHECK(!sensor.set<BME280_ModeField>(NormalMode));
+  CHECK_EQUAL(IIR4, sensor.get<BME280_IIRFilterField>());
+  CHECK_EQUAL(SleepMode, sensor.get<BME280_ModeField>());
+  simulator[0].nak = 1;  // The ctrl_hum write is skipped, the following ctrl_meas write fails
+  CHECK(!sensor.set<BME280_HumiditySamplingField>(Oversample2));
+  simulator[0].nak = 0;
+  CHECK(sensor.set<BME280_HumiditySamplingField>(Oversample2));
+  CHECK_EQUAL(BusError, sensor.lastError());  // The first failed write
+
+  // Settings written by other means are read back
+  simulator[0].writeRegister(BME280_CONFIG_REG, 0x6C);  // 250ms, filter 8
+  sensor.syncFromDevice();
+  CHECK_EQUAL(inactive250ms, sensor.inactiveTime());
+  CHECK_EQUAL(IIR8, sensor.iirFilter());
+  return (testResult("settings"));
+}  // of function main()
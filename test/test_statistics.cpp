@@ -0,0 +1,88 @@
+/*!
+ @file test_statistics.cpp
+
+ @section test_statistics_intro_section Description
+
+ Host test of the bus and timing statistics, built with BME280_STATISTICS defined for the library
+ and the test: the transactions, bytes and status polls match the transfers seen by the
+ simulated device, failed transfers are counted as errors, the latencies of the measurements are
+ kept and resetStatistics() starts again from zero\n\n
+
+ See main library header file for details
+*/
+#include "BME280.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+
+#ifndef BME280_STATISTICS
+#error "test_statistics has to be built with BME280_STATISTICS defined"
+#endif
+
+static void checkReset(const BME280_Class &sensor) {
+  /*!
+   * @brief     checks that all statistics are back at their start values
+   * @param[in] sensor Device whose statistics were reset
+   */
+  const BME280_Statistics &stats = sensor.statistics();
+  CHECK_EQUAL(0, stats.transactions);
+  CHECK_EQUAL(0, stats.bytes);
+  CHECK_EQUAL(0, stats.errors);
+  CHECK_EQUAL(0, stats.statusPolls);
+  CHECK_EQUAL(0, stats.samples);
+  CHECK_EQUAL(0, stats.compensations);
+  CHECK_EQUAL(UINT32_MAX, stats.minLatency);
+  CHECK_EQUAL(0, stats.maxLatency);
+  CHECK_EQUAL(0, stats.totalLatency);
+  CHECK_EQUAL(0, sensor.averageLatency());
+}  // of function checkReset()
+
+int main() {
+  simulatorPowerOn();
+  BME280_Class             sensor;
+  BME280_Simulator        &device = simulator[0];
+  const BME280_Statistics &stats  = sensor.statistics();
+  int32_t                  temperature, humidity, pressure;
+  CHECK(sensor.begin());
+  CHECK(stats.transactions > 0);  // Chip id and calibration reads
+  CHECK(sensor.apply(BME280_WEATHER_MONITORING));
+  sensor.resetStatistics();
+  checkReset(sensor);
+
+  // Each transfer is counted once, a status poll is one byte and the measurement 8 bytes
+  device.reads = device.writes = device.statusReads = 0;
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(2508, temperature);
+  CHECK_EQUAL(device.reads + device.writes, stats.transactions);
+  CHECK_EQUAL(device.statusReads + BME280_RAW_DATA_LENGTH + device.writes, stats.bytes);
+  CHECK_EQUAL(device.statusReads, stats.statusPolls);
+  CHECK_EQUAL(0, stats.errors);
+  CHECK_EQUAL(1, stats.samples);
+  CHECK_EQUAL(1, stats.compensations);
+  CHECK_EQUAL(stats.minLatency, stats.maxLatency);
+  CHECK_EQUAL(stats.minLatency, sensor.averageLatency());
+  CHECK(sensor.averageLatency() >= sensor.conversionTime(TypicalMeasure));
+  CHECK(sensor.averageLatency() < sensor.conversionTime(MaximumMeasure) + 2000);  // With the reads
+
+  // Measurements of different lengths, the average lies between the shortest and the longest
+  CHECK(sensor.apply(BME280_INDOOR_NAVIGATION));
+  CHECK_EQUAL(SleepMode, sensor.mode(SleepMode));
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(2, stats.samples);
+  CHECK(stats.maxLatency > stats.minLatency);
+  CHECK_EQUAL(stats.totalLatency / 2, sensor.averageLatency());
+  CHECK(sensor.averageLatency() > stats.minLatency);
+  CHECK(sensor.averageLatency() < stats.maxLatency);
+
+  // A transfer which isn't acknowledged is an error, the recovery's transfers are counted too
+  uint32_t transactions = stats.transactions;
+  device.nak            = 1;
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(BusError, sensor.lastError());
+  CHECK_EQUAL(1, stats.errors);
+  CHECK(stats.transactions > transactions + 2);
+  CHECK_EQUAL(3, stats.samples);
+
+  sensor.resetStatistics();
+  checkReset(sensor);
+  return (testResult("statistics"));
+}  // of function main()
@@ -0,0 +1,97 @@
+/*!
+ @file test_stream.cpp
+
+ @section test_stream_intro_section Description
+
+ Host test of streaming in normal mode: every conversion gives one sample, also when the readings
+ don't change, a status which stays busy is reported and recovered and a device which has been
+ reset is set up again\n\n
+
+ See main library header file for details
+*/
+#include "BME280.h"
+#include "BME280_Reference.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+
+static uint32_t callbacks = 0;  ///< Samples passed to the callback function
+
+static void countSample(const uint32_t timestamp, const BME280_Reading &reading) {
+  /*!
+   * @brief     counts the samples passed to the callback function
+   * @param[in] timestamp millis() value of the sample
+   * @param[in] reading Compensated readings
+   */
+  (void)timestamp;
+  (void)reading;
+  callbacks++;
+}  // of function countSample()
+static void warmer(BME280_Simulator &device, const uint32_t number) {
+  /*!
+   * @brief     raises the temperature from the 4th conversion on
+   * @param[in] device Simulated device
+   * @param[in] number Conversion number, from 0
+   */
+  if (number == 3) device.measure(BME280_SIM_ADC_T + 16000, BME280_SIM_ADC_P, BME280_SIM_ADC_H);
+}  // of function warmer()
+static uint32_t streamFor(BME280_Class &sensor, const uint32_t duration, BME280_Reading &last) {
+  /*!
+   * @brief     calls stream() every 100us for the given time
+   * @param[in] sensor Streaming device
+   * @param[in] duration Microseconds
+   * @param[out] last Readings of the last sample
+   * @return    Number of samples returned
+   */
+  uint32_t samples = 0, start = simulatedTime;
+  while (simulatedTime - start < duration) {
+    if (sensor.stream(last)) samples++;
+    delayMicroseconds(100);
+  }  // of while-loop streaming
+  return (samples);
+}  // of function streamFor()
+
+int main() {
+  simulatorPowerOn();
+  BME280_Class   sensor;
+  BME280_Reading reading = {};
+  CHECK(sensor.begin());
+  CHECK(sensor.apply(BME280_INDOOR_NAVIGATION));
+
+  // Unchanged readings are new samples too, one per conversion
+  sensor.startStreaming(countSample);
+  uint32_t conversions = simulator[0].conversions;
+  uint32_t samples     = streamFor(sensor, 20 * simulator[0].period(), reading);
+  CHECK(samples >= 19);
+  CHECK(samples <= simulator[0].conversions - conversions);
+  CHECK_EQUAL(samples, callbacks);
+  CHECK_EQUAL(2508, reading.temperature);
+  CHECK_EQUAL(NoError, sensor.lastError());
+  CHECK_EQUAL(NormalMode, simulator[0].registers[BME280_CONTROL_REG] & 3);  // Never recovered
+
+  // Changed readings are compensated again
+  simulatorPowerOn();
+  simulator[0].conversion = warmer;
+  CHECK(sensor.begin());
+  CHECK(sensor.apply(BME280_INDOOR_NAVIGATION));
+  sensor.startStreaming();
+  CHECK(streamFor(sensor, 10 * simulator[0].period(), reading) >= 9);
+  CHECK_EQUAL(reference(BME280_SIM_CALIBRATION, BME280_SIM_ADC_T + 16000, BME280_SIM_ADC_P,
+                        BME280_SIM_ADC_H)
+                  .temperature,
+              reading.temperature);
+
+  // A status which stays busy stops the samples until the device has been recovered
+  simulator[0].stuckBusy = true;
+  CHECK_EQUAL(0, streamFor(sensor, 5 * sensor.measurementTime(MaximumMeasure), reading));
+  CHECK_EQUAL(TimeoutError, sensor.lastError());
+  simulator[0].stuckBusy = false;
+  CHECK(streamFor(sensor, 5 * simulator[0].period(), reading) >= 3);
+
+  // A device which has been reset is set up again
+  uint32_t period = simulator[0].period();
+  simulator[0].reset();
+  CHECK(streamFor(sensor, 10 * period, reading) >= 5);
+  CHECK_EQUAL(NormalMode, simulator[0].registers[BME280_CONTROL_REG] & 3);
+  CHECK_EQUAL(BME280_INDOOR_NAVIGATION.iirFilter << 2, simulator[0].registers[BME280_CONFIG_REG]);
+  return (testResult("stream"));
+}  // of function main()
@@ -0,0 +1,97 @@
+/*!
+ @file test_tuner.cpp
+
+ @section test_tuner_intro_section Description
+
+ Host test of BME280_Tuner against the simulated device: for targets like those of the TunerDemo
+ example the chosen settings are applied and the measurement cycle of the device fits the wanted
+ sample period, the sample rate of the simulated device is at least the wanted one and the
+ estimated current and noise are within the targets. The settings, the achieved sample rate and
+ the estimated current of each configuration are shown\n\n
+
+ See main library header file for details
+*/
+#include <stdio.h>  // printf()
+
+#include "BME280.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+#include "BME280_Tuner.h"
+
+/*! Targets which can be met: period, noise of temperature / humidity / pressure, current and
+ * response time */
+const BME280_Targets TARGETS[] = {
+    {60000000, {50, 200, 330}, 0, 0},     // Weather station, once a minute
+    {1000000, {50, 200, 0}, 0, 0},        // Humidity sensing, once a second
+    {100000, {50, 0, 50}, 0, 1000000},    // Indoor navigation, 10Hz
+    {10000, {0, 0, 100}, 0, 0},           // Gaming, 100Hz
+    {1000000, {0, 0, 50}, 20000, 0},      // Fine pressure on a 20uA budget
+    {100000, {50, 0, 100}, 0, 2000000}};  // Streaming of the example
+
+static uint32_t samplePeriod(BME280_Class &sensor, const BME280_Config &config,
+                             const uint32_t wanted) {
+  /*!
+   * @brief     applies the settings and returns the time between samples the device achieves
+   * @details   In normal mode this is the conversion cycle of the simulated device, in forced mode
+   * the program triggers a measurement once per wanted period, or as soon as the previous one
+   * has been read if that takes longer
+   * @param[in] sensor Device
+   * @param[in] config Settings to apply
+   * @param[in] wanted Wanted sample period in microseconds
+   * @return    Microseconds between samples
+   */
+  CHECK(sensor.apply(config));
+  if (config.mode == NormalMode) return (simulator[0].period());
+  int32_t  temperature, humidity, pressure;
+  uint32_t start = simulatedTime;
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  uint32_t elapsed = simulatedTime - start;
+  return (elapsed > wanted ? elapsed : wanted);
+}  // of function samplePeriod()
+
+int main() {
+  simulatorPowerOn();
+  BME280_Class sensor;
+  BME280_Tuner tuner;
+  CHECK(sensor.begin());
+  printf("T/H/P  IIR inactive mode  wanted Hz  achieved Hz  current uA\n");
+  for (uint8_t i = 0; i < sizeof(TARGETS) / sizeof(TARGETS[0]); i++) {
+    const BME280_Targets &targets = TARGETS[i];
+    CHECK(tuner.tune(targets));
+    const BME280_Config &config   = tuner.config();
+    uint32_t             achieved = samplePeriod(sensor, config, targets.samplePeriod);
+    printf("%u/%u/%u  %3u %8u %4u %10.3f %12.3f %11.3f\n", config.temperatureSampling,
+           config.humiditySampling, config.pressureSampling, config.iirFilter, config.inactiveTime,
+           config.mode, 1e6 / targets.samplePeriod, 1e6 / achieved, tuner.current() / 1000.0);
+
+    // The measurement cycle fits the period, in forced mode a maximum conversion does
+    if (config.mode == NormalMode) {
+      CHECK(sensor.measurementTime(MaximumMeasure) <= targets.samplePeriod);
+      CHECK_EQUAL(sensor.measurementTime(MaximumMeasure), tuner.period());
+      CHECK(achieved <= targets.samplePeriod);
+    } else {
+      CHECK(sensor.conversionTime(MaximumMeasure) <= targets.samplePeriod);
+      CHECK_EQUAL(targets.samplePeriod, tuner.period());
+    }  // of if-then-else normal mode
+
+    // The estimates are within the targets
+    if (targets.maxCurrent != 0) CHECK(tuner.current() <= targets.maxCurrent);
+    CHECK(tuner.current() > 0);
+    for (uint8_t sensorType = 0; sensorType < UnknownSensor; sensorType++) {
+      if (targets.noise[sensorType] == 0) continue;  // Channel not wanted
+      CHECK(tuner.noise(sensorType) <= targets.noise[sensorType]);
+      CHECK(sensor.getOversampling(sensorType) != SensorOff);
+    }  // of for-next each channel
+  }    // of for-next each set of targets
+
+  // Targets of the example which can't be met: the oversampling for the noise doesn't fit the
+  // period at 40Hz, and fine pressure readings need more than 5uA
+  BME280_Targets fast = {25000, {50, 0, 20}, 0, 250000};
+  CHECK(!tuner.tune(fast));
+  CHECK(tuner.noise(PressureSensor) > fast.noise[PressureSensor] || tuner.period() > 25000);
+  BME280_Targets cheap = {1000000, {0, 0, 50}, 5000, 0};
+  CHECK(!tuner.tune(cheap));
+  CHECK(tuner.current() > cheap.maxCurrent);
+  CHECK_EQUAL(NoError, sensor.lastError());
+  return (testResult("tuner"));
+}  // of function main()
@@ -0,0 +1,109 @@
+/*!
+ @file test_warmstart.cpp
+
+ @section test_warmstart_intro_section Description
+
+ Host test of the warm start: the first begin() scans the bus, reads the calibration and saves
+ both, later calls only read the chip id and settings. Missing or damaged data, data stored for
+ another address and a device which no longer answers at the stored address all lead to a cold
+ start which saves the data again\n\n
+
+ See main library header file for details
+*/
+#include <string.h>  // memcpy()
+
+#include "BME280.h"
+#include "BME280_Simulator.h"
+#include "BME280_Test.h"
+
+static uint8_t  stored[sizeof(BME280_WarmStart)];  ///< Simulated EEPROM
+static bool     storedValid = false;               ///< Set once data has been saved
+static uint32_t saves       = 0;                   ///< Number of saves
+
+static bool storage(uint8_t *data, const uint8_t length, const bool save) {
+  /*!
+   * @brief     loads or saves the warm start data in memory
+   * @param[in,out] data Warm start data
+   * @param[in] length Number of bytes
+   * @param[in] save "true" to save, "false" to load
+   * @return    returns "false" if a load finds nothing stored
+   */
+  CHECK_EQUAL(sizeof(stored), length);
+  if (save) {
+    memcpy(stored, data, length);
+    storedValid = true;
+    saves++;
+    return true;
+  }  // of if-then save
+  if (storedValid) memcpy(data, stored, length);
+  return (storedValid);
+}  // of function storage()
+static void checkStart(const bool warm, const uint8_t address) {
+  /*!
+   * @brief     starts a new instance with the warm start and checks how it started
+   * @param[in] warm "true" if the stored data has to be used
+   * @param[in] address I2C address the device has to be found at
+   */
+  BME280_Class sensor;
+  int32_t      temperature, humidity, pressure;
+  uint32_t     reads = simulator[0].reads + simulator[1].reads, saved = saves;
+  CHECK(sensor.begin(storage));
+  CHECK_EQUAL(address, sensor.bus().address());
+  if (warm) {
+    CHECK_EQUAL(2, simulator[0].reads + simulator[1].reads - reads);  // Chip id and settings
+    CHECK_EQUAL(saved, saves);
+  } else {
+    CHECK(simulator[0].reads + simulator[1].reads - reads > 2);
+    CHECK_EQUAL(saved + 1, saves);
+  }  // of if-then-else warm start
+  CHECK(sensor.apply(BME280_WEATHER_MONITORING));
+  CHECK(sensor.getSensorData(temperature, humidity, pressure));
+  CHECK_EQUAL(2508, temperature);
+}  // of function checkStart()
+
+int main() {
+  simulatorPowerOn();
+
+  // Nothing stored, then the stored data is used
+  checkStart(false, 0x77);
+  checkStart(true, 0x77);
+  checkStart(true, 0x77);
+
+  // Damaged data
+  stored[sizeof(stored) - 1] ^= 0x10;
+  checkStart(false, 0x77);
+  checkStart(true, 0x77);
+
+  // The device has moved to the other address
+  simulatorPowerOn(2);
+  simulator[0].present = false;
+  checkStart(false, 0x76);
+  checkStart(true, 0x76);
+
+  // Speed and address given, data stored for another address isn't used
+  simulatorPowerOn(2);
+  BME280_Class sensor;
+  uint32_t     saved = saves;
+  CHECK(sensor.begin(storage, I2C_FAST_MODE, (uint8_t)0x77));
+  CHECK_EQUAL(0x77, sensor.bus().address());
+  CHECK_EQUAL(saved + 1, saves);
+  uint32_t reads = simulator[0].reads;
+  CHECK(sensor.begin(storage, I2C_FAST_MODE, (uint8_t)0x77));
+  CHECK_EQUAL(2, simulator[0].reads - reads);
+  CHECK_EQUAL(saved + 1, saves);
+
+  // Hardware and software SPI
+  BME280_Device<BME280_HardwareSPIBus> spi;
+  CHECK(spi.begin(storage, simulator[1].chipSelect));
+  CHECK_EQUAL(saved + 2, saves);
+  reads = simulator[1].reads;
+  CHECK(spi.begin(storage, simulator[1].chipSelect));
+  CHECK_EQUAL(2, simulator[1].reads - reads);
+  CHECK_EQUAL(saved + 2, saves);
+  BME280_Device<BME280_SoftwareSPIBus> soft;
+  CHECK(soft.begin(storage, simulator[0].chipSelect, BME280_SIM_MOSI, BME280_SIM_MISO,
+                   BME280_SIM_SCK));
+  CHECK_EQUAL(saved + 2, saves);  // Same calibration values as the stored SPI device
+  CHECK_EQUAL(NoError, soft.lastError());
+  return (testResult("warmstart"));
+}  // of function main()